@@ -0,0 +1,148 @@
+Type VertexFragment
+
+RenderQueue AlphaTest 0
+
+Blend SrcAlpha OneMinusSrcAlpha
+
+Variants SDF, MSDF
+
+VariantDependency MSDF -SDF
+
+Begin Parameters
+
+color mainColor = #FFFFFFFF
+texture mainTexture = WHITE
+
+End Parameters
+
+Begin Input
+POSITION
+TEXCOORD0
+COLOR0
+COLOR1
+variant: SDF|MSDF TEXCOORD1
+End Input
+
+Begin Common
+
+[[vk::binding(StapleUniformBufferStart, StapleUniformBufferSet)]]
+cbuffer Uniforms
+{
+	float4 mainColor;
+};
+
+struct VertexOutput
+{
+    float4 position : SV_Position;
+	float2 coord;
+    float4 color;
+    float4 borderColor;
+
+#if defined(SDF) || defined(MSDF)
+    float borderWidth;
+#endif
+};
+
+End Common
+
+Begin Vertex
+
+struct Input
+{
+    float2 position : POSITION;
+	float2 coord : TEXCOORD0;
+	uint color : COLOR0;
+	uint borderColor : COLOR1;
+
+#if defined(SDF) || defined(MSDF)
+	float borderWidth : TEXCOORD1;
+#endif
+
+    uint baseInstance : SV_StartInstanceLocation;
+    uint instanceID : SV_InstanceID;
+};
+
+float4 UnpackColor(uint color)
+{
+    return float4(
+        (color >> 24 & 0xFF) / 255.0,
+        (color >> 16 & 0xFF) / 255.0,
+        (color >> 8 & 0xFF) / 255.0,
+        (color & 0xFF) / 255.0
+    );
+}
+
+[shader("vertex")]
+VertexOutput VertexMain(Input input)
+{
+    VertexOutput output;
+
+    float4x4 model = StapleWorldMatrix(input.baseInstance, input.instanceID);
+
+    output.color = UnpackColor(input.color);
+    output.borderColor = UnpackColor(input.borderColor);
+	output.coord = input.coord;
+
+#if defined(SDF) || defined(MSDF)
+    output.borderWidth = input.borderWidth;
+#endif
+
+    output.position = mul(ProjectionViewWorld(model), float4(input.position, 0.0, 1.0));
+
+    return output;
+}
+
+End Vertex
+
+Begin Fragment
+
+[[vk::binding(0, StapleSamplerStorageBufferSet)]]
+cbuffer Textures
+{
+	Sampler2D mainTexture;
+};
+
+float Median(float r, float g, float b)
+{
+    return max(min(r, g), min(max(r, g), b));
+}
+
+//Turns a distance into coverage, antialiased over one screen pixel
+float DistanceCoverage(float distance, float threshold)
+{
+    return saturate((distance - threshold) / max(fwidth(distance), 0.0001) + 0.5);
+}
+
+[shader("fragment")]
+float4 FragmentMain(VertexOutput input) : SV_Target
+{
+#if defined(SDF) || defined(MSDF)
+    float4 field = mainTexture.Sample(input.coord);
+
+#ifdef MSDF
+    //The median of the three channels keeps corners sharp, alpha has the true distance which stays smooth for borders
+    float distance = Median(field.r, field.g, field.b);
+    float borderDistance = field.a;
+#else
+    float distance = field.r;
+    float borderDistance = field.r;
+#endif
+
+    //The edge is at 0.5, borders extend it outwards by their width in distance units
+    float fill = DistanceCoverage(distance, 0.5);
+    float border = input.borderWidth > 0 ? DistanceCoverage(borderDistance, 0.5 - input.borderWidth) : 0;
+
+    float3 color = lerp(input.borderColor.rgb, input.color.rgb, fill);
+
+    return float4(color, max(fill, border)) * mainColor;
+#else
+    //Red is the fill coverage and green is the border coverage
+    float2 coverage = mainTexture.Sample(input.coord).rg;
+
+    float3 color = coverage.g > 0 ? lerp(input.borderColor.rgb, input.color.rgb, coverage.r) : input.color.rgb;
+
+    return float4(color, saturate(coverage.r + coverage.g)) * mainColor;
+#endif
+}
+
+End Fragment
@@ -0,0 +1,945 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+//Multi-channel signed distance fields generated from glyph outlines, following the approach of Viktor Chlumsky's msdfgen.
+//Edges meeting at a corner are assigned different color channels, so the median of the three channel distances keeps corners sharp
+//when the field is magnified. The alpha channel stores the true signed distance, which is smooth at any offset from the edge.
+//Distances are in pixels, positive inside the glyph, and stored as 128 + distance * 128 / spread, same as FreeType's SDF renderer.
+class DistanceFieldGenerator
+{
+public:
+	void MoveTo(double x, double y)
+	{
+		contours.push_back(Contour());
+
+		position = Point(x, y);
+	}
+
+	void LineTo(double x, double y)
+	{
+		AddEdge(1, { position, Point(x, y) });
+	}
+
+	void QuadraticTo(double controlX, double controlY, double x, double y)
+	{
+		AddEdge(2, { position, Point(controlX, controlY), Point(x, y) });
+	}
+
+	void CubicTo(double control1X, double control1Y, double control2X, double control2Y, double x, double y)
+	{
+		AddEdge(3, { position, Point(control1X, control1Y), Point(control2X, control2Y), Point(x, y) });
+	}
+
+	//Writes `width` by `height` RGBA pixels. Pixel (0, 0) is centered at (`left` + 0.5, `top` - 0.5) in outline coordinates, with Y going up.
+	//`clockwise` tells whether filled contours wind clockwise, as in TrueType outlines.
+	void Generate(uint8_t* pixels, int32_t width, int32_t height, double left, double top, double spread, bool clockwise, bool evenOdd)
+	{
+		if (width <= 0 || height <= 0)
+		{
+			return;
+		}
+
+		ColorEdges();
+
+		double orientation = clockwise ? 1 : -1;
+
+		std::vector<float> field((size_t)width * height * 4);
+		std::vector<Crossing> crossings;
+
+		for (int32_t y = 0; y < height; y++)
+		{
+			double sampleY = top - y - 0.5;
+
+			FindCrossings(sampleY, crossings);
+
+			size_t crossingIndex = 0;
+			int32_t winding = 0;
+
+			for (int32_t x = 0; x < width; x++)
+			{
+				Point p(left + x + 0.5, sampleY);
+
+				while (crossingIndex < crossings.size() && crossings[crossingIndex].x < p.x)
+				{
+					winding += crossings[crossingIndex++].direction;
+				}
+
+				bool inside = evenOdd ? (winding & 1) != 0 : winding != 0;
+
+				float* pixel = &field[((size_t)y * width + x) * 4];
+
+				SamplePixel(p, orientation, inside, pixel);
+
+				for (int32_t i = 0; i < 4; i++)
+				{
+					pixel[i] = (float)(0.5 + pixel[i] / (2 * spread));
+				}
+			}
+		}
+
+		CorrectClashes(field, width, height, 1.001 / (2 * spread));
+
+		for (size_t i = 0; i < field.size(); i++)
+		{
+			double value = std::round(field[i] * 256);
+
+			pixels[i] = (uint8_t)std::min(std::max(value, 0.0), 255.0);
+		}
+	}
+
+private:
+	enum EdgeColor
+	{
+		EDGE_COLOR_BLACK = 0,
+		EDGE_COLOR_RED = 1,
+		EDGE_COLOR_GREEN = 2,
+		EDGE_COLOR_YELLOW = 3,
+		EDGE_COLOR_BLUE = 4,
+		EDGE_COLOR_MAGENTA = 5,
+		EDGE_COLOR_CYAN = 6,
+		EDGE_COLOR_WHITE = 7,
+	};
+
+	struct Point
+	{
+		Point() : x(0), y(0) {}
+		Point(double x, double y) : x(x), y(y) {}
+
+		Point operator+(const Point& other) const { return Point(x + other.x, y + other.y); }
+		Point operator-(const Point& other) const { return Point(x - other.x, y - other.y); }
+		Point operator*(double value) const { return Point(x * value, y * value); }
+		bool operator==(const Point& other) const { return x == other.x && y == other.y; }
+
+		double Length() const
+		{
+			return std::sqrt(x * x + y * y);
+		}
+
+		Point Normalized() const
+		{
+			double length = Length();
+
+			return length == 0 ? Point(0, 1) : Point(x / length, y / length);
+		}
+
+		double x, y;
+	};
+
+	static double Dot(const Point& a, const Point& b)
+	{
+		return a.x * b.x + a.y * b.y;
+	}
+
+	static double Cross(const Point& a, const Point& b)
+	{
+		return a.x * b.y - a.y * b.x;
+	}
+
+	static Point Mix(const Point& a, const Point& b, double t)
+	{
+		return a + (b - a) * t;
+	}
+
+	static double NonZeroSign(double value)
+	{
+		return value > 0 ? 1 : -1;
+	}
+
+	//Distance to an edge, where ties between edges are broken by how orthogonally the edge is reached
+	struct SignedDistance
+	{
+		SignedDistance() : distance(-DBL_MAX), dot(1) {}
+		SignedDistance(double distance, double dot) : distance(distance), dot(dot) {}
+
+		bool operator<(const SignedDistance& other) const
+		{
+			return std::fabs(distance) < std::fabs(other.distance) ||
+				(std::fabs(distance) == std::fabs(other.distance) && dot < other.dot);
+		}
+
+		double distance;
+		double dot;
+	};
+
+	//A line (degree 1), quadratic (degree 2) or cubic (degree 3) bezier
+	struct Edge
+	{
+		Edge() : degree(1), color(EDGE_COLOR_WHITE) {}
+
+		Point PointAt(double t) const
+		{
+			switch (degree)
+			{
+			case 1:
+				return Mix(points[0], points[1], t);
+
+			case 2:
+				return Mix(Mix(points[0], points[1], t), Mix(points[1], points[2], t), t);
+
+			default:
+			{
+				Point p12 = Mix(points[1], points[2], t);
+
+				return Mix(Mix(Mix(points[0], points[1], t), p12, t), Mix(p12, Mix(points[2], points[3], t), t), t);
+			}
+			}
+		}
+
+		Point Direction(double t) const
+		{
+			switch (degree)
+			{
+			case 1:
+				return points[1] - points[0];
+
+			case 2:
+			{
+				Point direction = Mix(points[1] - points[0], points[2] - points[1], t);
+
+				return direction == Point() ? points[2] - points[0] : direction;
+			}
+
+			default:
+			{
+				Point direction = Mix(Mix(points[1] - points[0], points[2] - points[1], t), Mix(points[2] - points[1], points[3] - points[2], t), t);
+
+				if (direction == Point())
+				{
+					if (t == 0)
+					{
+						return points[2] - points[0];
+					}
+
+					if (t == 1)
+					{
+						return points[3] - points[1];
+					}
+				}
+
+				return direction;
+			}
+			}
+		}
+
+		Point End() const
+		{
+			return points[degree];
+		}
+
+		//The part of the edge between `from` and `to`, using de Casteljau's algorithm
+		Edge Slice(double from, double to) const
+		{
+			Edge outValue = *this;
+
+			outValue.points[0] = PointAt(from);
+			outValue.points[degree] = PointAt(to);
+
+			if (degree == 2)
+			{
+				outValue.points[1] = Mix(Mix(points[0], points[1], from), Mix(points[1], points[2], from), to);
+			}
+			else if (degree == 3)
+			{
+				//The derivative of a cubic is 3 times Direction, and a third of it scaled to the slice gives the control points
+				outValue.points[1] = outValue.points[0] + Direction(from) * (to - from);
+				outValue.points[2] = outValue.points[3] - Direction(to) * (to - from);
+			}
+
+			return outValue;
+		}
+
+		SignedDistance Distance(const Point& p, double& param) const
+		{
+			switch (degree)
+			{
+			case 1:
+				return LineDistance(p, param);
+
+			case 2:
+				return QuadraticDistance(p, param);
+
+			default:
+				return CubicDistance(p, param);
+			}
+		}
+
+		SignedDistance LineDistance(const Point& p, double& param) const
+		{
+			Point aq = p - points[0];
+			Point ab = points[1] - points[0];
+
+			param = Dot(aq, ab) / Dot(ab, ab);
+
+			Point eq = (param > 0.5 ? points[1] : points[0]) - p;
+
+			double endpointDistance = eq.Length();
+
+			if (param > 0 && param < 1)
+			{
+				double orthoDistance = Cross(aq, ab.Normalized());
+
+				if (std::fabs(orthoDistance) < endpointDistance)
+				{
+					return SignedDistance(orthoDistance, 0);
+				}
+			}
+
+			return SignedDistance(NonZeroSign(Cross(aq, ab)) * endpointDistance, std::fabs(Dot(ab.Normalized(), eq.Normalized())));
+		}
+
+		SignedDistance QuadraticDistance(const Point& p, double& param) const
+		{
+			Point qa = points[0] - p;
+			Point ab = points[1] - points[0];
+			Point br = points[2] - points[1] - ab;
+
+			double a = Dot(br, br);
+			double b = 3 * Dot(ab, br);
+			double c = 2 * Dot(ab, ab) + Dot(qa, br);
+			double d = Dot(qa, ab);
+
+			double t[3];
+			int32_t solutions = SolveCubic(t, a, b, c, d);
+
+			Point direction = Direction(0);
+
+			double minDistance = NonZeroSign(Cross(direction, qa)) * qa.Length();
+
+			param = -Dot(qa, direction) / Dot(direction, direction);
+
+			{
+				direction = Direction(1);
+
+				double distance = (points[2] - p).Length();
+
+				if (distance < std::fabs(minDistance))
+				{
+					minDistance = NonZeroSign(Cross(direction, points[2] - p)) * distance;
+					param = Dot(p - points[1], direction) / Dot(direction, direction);
+				}
+			}
+
+			for (int32_t i = 0; i < solutions; i++)
+			{
+				if (t[i] > 0 && t[i] < 1)
+				{
+					Point qe = qa + ab * (2 * t[i]) + br * (t[i] * t[i]);
+
+					double distance = qe.Length();
+
+					if (distance <= std::fabs(minDistance))
+					{
+						minDistance = NonZeroSign(Cross(ab + br * t[i], qe)) * distance;
+						param = t[i];
+					}
+				}
+			}
+
+			if (param >= 0 && param <= 1)
+			{
+				return SignedDistance(minDistance, 0);
+			}
+
+			if (param < 0.5)
+			{
+				return SignedDistance(minDistance, std::fabs(Dot(Direction(0).Normalized(), qa.Normalized())));
+			}
+
+			return SignedDistance(minDistance, std::fabs(Dot(Direction(1).Normalized(), (points[2] - p).Normalized())));
+		}
+
+		SignedDistance CubicDistance(const Point& p, double& param) const
+		{
+			const int32_t SearchStarts = 4;
+			const int32_t SearchSteps = 4;
+
+			Point qa = points[0] - p;
+			Point ab = points[1] - points[0];
+			Point br = points[2] - points[1] - ab;
+			Point as = (points[3] - points[2]) - (points[2] - points[1]) - br;
+
+			Point direction = Direction(0);
+
+			double minDistance = NonZeroSign(Cross(direction, qa)) * qa.Length();
+
+			param = -Dot(qa, direction) / Dot(direction, direction);
+
+			{
+				direction = Direction(1);
+
+				double distance = (points[3] - p).Length();
+
+				if (distance < std::fabs(minDistance))
+				{
+					minDistance = NonZeroSign(Cross(direction, points[3] - p)) * distance;
+					param = Dot(direction - (points[3] - p), direction) / Dot(direction, direction);
+				}
+			}
+
+			//Newton iterations from a few starting points along the curve
+			for (int32_t i = 0; i <= SearchStarts; i++)
+			{
+				double t = (double)i / SearchStarts;
+
+				Point qe = qa + ab * (3 * t) + br * (3 * t * t) + as * (t * t * t);
+
+				for (int32_t step = 0; step < SearchSteps; step++)
+				{
+					Point d1 = ab * 3 + br * (6 * t) + as * (3 * t * t);
+					Point d2 = br * 6 + as * (6 * t);
+
+					t -= Dot(qe, d1) / (Dot(d1, d1) + Dot(qe, d2));
+
+					if (t <= 0 || t >= 1)
+					{
+						break;
+					}
+
+					qe = qa + ab * (3 * t) + br * (3 * t * t) + as * (t * t * t);
+
+					double distance = qe.Length();
+
+					if (distance < std::fabs(minDistance))
+					{
+						minDistance = NonZeroSign(Cross(Direction(t), qe)) * distance;
+						param = t;
+					}
+				}
+			}
+
+			if (param >= 0 && param <= 1)
+			{
+				return SignedDistance(minDistance, 0);
+			}
+
+			if (param < 0.5)
+			{
+				return SignedDistance(minDistance, std::fabs(Dot(Direction(0).Normalized(), qa.Normalized())));
+			}
+
+			return SignedDistance(minDistance, std::fabs(Dot(Direction(1).Normalized(), (points[3] - p).Normalized())));
+		}
+
+		//Past the ends of the edge, the distance to its extended tangent keeps channel boundaries straight
+		void ToPseudoDistance(SignedDistance& distance, const Point& p, double param) const
+		{
+			if (param < 0)
+			{
+				Point direction = Direction(0).Normalized();
+				Point aq = p - points[0];
+
+				if (Dot(aq, direction) < 0)
+				{
+					double pseudoDistance = Cross(aq, direction);
+
+					if (std::fabs(pseudoDistance) <= std::fabs(distance.distance))
+					{
+						distance = SignedDistance(pseudoDistance, 0);
+					}
+				}
+			}
+			else if (param > 1)
+			{
+				Point direction = Direction(1).Normalized();
+				Point bq = p - End();
+
+				if (Dot(bq, direction) > 0)
+				{
+					double pseudoDistance = Cross(bq, direction);
+
+					if (std::fabs(pseudoDistance) <= std::fabs(distance.distance))
+					{
+						distance = SignedDistance(pseudoDistance, 0);
+					}
+				}
+			}
+		}
+
+		//The control points bound the curve, so no point of the edge is closer than this
+		double BoundsDistance(const Point& p) const
+		{
+			double dx = std::max(std::max(minimum.x - p.x, p.x - maximum.x), 0.0);
+			double dy = std::max(std::max(minimum.y - p.y, p.y - maximum.y), 0.0);
+
+			return std::sqrt(dx * dx + dy * dy);
+		}
+
+		int32_t degree;
+		Point points[4];
+		Point minimum;
+		Point maximum;
+		int32_t color;
+	};
+
+	struct Contour
+	{
+		std::vector<Edge> edges;
+	};
+
+	//Where a horizontal line crosses the outline, and whether the outline goes up (1) or down (-1) there
+	struct Crossing
+	{
+		double x;
+		int32_t direction;
+
+		bool operator<(const Crossing& other) const
+		{
+			return x < other.x;
+		}
+	};
+
+	void AddEdge(int32_t degree, std::initializer_list<Point> points)
+	{
+		if (contours.empty())
+		{
+			contours.push_back(Contour());
+		}
+
+		Edge edge;
+
+		edge.degree = degree;
+
+		std::copy(points.begin(), points.end(), edge.points);
+
+		edge.minimum = edge.maximum = edge.points[0];
+
+		for (int32_t i = 1; i <= degree; i++)
+		{
+			edge.minimum = Point(std::min(edge.minimum.x, edge.points[i].x), std::min(edge.minimum.y, edge.points[i].y));
+			edge.maximum = Point(std::max(edge.maximum.x, edge.points[i].x), std::max(edge.maximum.y, edge.points[i].y));
+		}
+
+		position = edge.End();
+
+		//Closing lines are often zero length, and have no direction
+		bool degenerate = true;
+
+		for (int32_t i = 1; i <= degree; i++)
+		{
+			if ((edge.points[i] == edge.points[0]) == false)
+			{
+				degenerate = false;
+			}
+		}
+
+		if (degenerate == false)
+		{
+			contours.back().edges.push_back(edge);
+		}
+	}
+
+	static int32_t SolveQuadratic(double x[2], double a, double b, double c)
+	{
+		if (a == 0 || std::fabs(b) > 1e12 * std::fabs(a))
+		{
+			if (b == 0)
+			{
+				return 0;
+			}
+
+			x[0] = -c / b;
+
+			return 1;
+		}
+
+		double discriminant = b * b - 4 * a * c;
+
+		if (discriminant > 0)
+		{
+			discriminant = std::sqrt(discriminant);
+
+			x[0] = (-b + discriminant) / (2 * a);
+			x[1] = (-b - discriminant) / (2 * a);
+
+			return 2;
+		}
+
+		if (discriminant == 0)
+		{
+			x[0] = -b / (2 * a);
+
+			return 1;
+		}
+
+		return 0;
+	}
+
+	static int32_t SolveCubicNormed(double x[3], double a, double b, double c)
+	{
+		const double Pi = 3.14159265358979323846;
+
+		double a2 = a * a;
+		double q = (a2 - 3 * b) / 9;
+		double r = (a * (2 * a2 - 9 * b) + 27 * c) / 54;
+		double r2 = r * r;
+		double q3 = q * q * q;
+
+		a /= 3;
+
+		if (r2 < q3)
+		{
+			double t = std::min(std::max(r / std::sqrt(q3), -1.0), 1.0);
+
+			t = std::acos(t);
+			q = -2 * std::sqrt(q);
+
+			x[0] = q * std::cos(t / 3) - a;
+			x[1] = q * std::cos((t + 2 * Pi) / 3) - a;
+			x[2] = q * std::cos((t - 2 * Pi) / 3) - a;
+
+			return 3;
+		}
+
+		double u = (r < 0 ? 1 : -1) * std::pow(std::fabs(r) + std::sqrt(r2 - q3), 1 / 3.0);
+		double v = u == 0 ? 0 : q / u;
+
+		x[0] = (u + v) - a;
+
+		if (u == v || std::fabs(u - v) < 1e-12 * std::fabs(u + v))
+		{
+			x[1] = -0.5 * (u + v) - a;
+
+			return 2;
+		}
+
+		return 1;
+	}
+
+	static int32_t SolveCubic(double x[3], double a, double b, double c, double d)
+	{
+		if (a != 0)
+		{
+			double bn = b / a;
+
+			//Past this ratio the numerical error is larger than if `a` was zero
+			if (std::fabs(bn) < 1e6)
+			{
+				return SolveCubicNormed(x, bn, c / a, d / a);
+			}
+		}
+
+		return SolveQuadratic(x, b, c, d);
+	}
+
+	static void SwitchColor(int32_t& color, uint64_t& seed, int32_t banned = EDGE_COLOR_BLACK)
+	{
+		int32_t combined = color & banned;
+
+		if (combined == EDGE_COLOR_RED || combined == EDGE_COLOR_GREEN || combined == EDGE_COLOR_BLUE)
+		{
+			color = combined ^ EDGE_COLOR_WHITE;
+
+			return;
+		}
+
+		if (color == EDGE_COLOR_BLACK || color == EDGE_COLOR_WHITE)
+		{
+			static const int32_t start[3] = { EDGE_COLOR_CYAN, EDGE_COLOR_MAGENTA, EDGE_COLOR_YELLOW };
+
+			color = start[seed % 3];
+			seed /= 3;
+
+			return;
+		}
+
+		int32_t shifted = color << (1 + (seed & 1));
+
+		color = (shifted | shifted >> 3) & EDGE_COLOR_WHITE;
+		seed >>= 1;
+	}
+
+	//Gives every edge two or three channels, switching colors at corners so neighbouring edges always share exactly one channel
+	void ColorEdges()
+	{
+		//Sine of the smallest angle change treated as a corner, about 3 radians
+		const double CornerThreshold = std::sin(3.0);
+
+		uint64_t seed = 0;
+
+		std::vector<size_t> corners;
+
+		for (Contour& contour : contours)
+		{
+			std::vector<Edge>& edges = contour.edges;
+
+			corners.clear();
+
+			if (edges.empty())
+			{
+				continue;
+			}
+
+			Point previousDirection = edges.back().Direction(1).Normalized();
+
+			for (size_t i = 0; i < edges.size(); i++)
+			{
+				Point direction = edges[i].Direction(0).Normalized();
+
+				if (Dot(previousDirection, direction) <= 0 || std::fabs(Cross(previousDirection, direction)) > CornerThreshold)
+				{
+					corners.push_back(i);
+				}
+
+				previousDirection = edges[i].Direction(1).Normalized();
+			}
+
+			if (corners.empty())
+			{
+				for (Edge& edge : edges)
+				{
+					edge.color = EDGE_COLOR_WHITE;
+				}
+			}
+			else if (corners.size() == 1)
+			{
+				//Teardrop, split into three colors around the contour
+				int32_t colors[3] = { EDGE_COLOR_WHITE, EDGE_COLOR_WHITE, EDGE_COLOR_WHITE };
+
+				SwitchColor(colors[0], seed);
+
+				colors[2] = colors[0];
+
+				SwitchColor(colors[2], seed);
+
+				size_t corner = corners[0];
+
+				if (edges.size() < 3)
+				{
+					std::vector<Edge> split;
+
+					for (size_t i = 0; i < edges.size(); i++)
+					{
+						const Edge& edge = edges[(corner + i) % edges.size()];
+
+						for (int32_t j = 0; j < 3; j++)
+						{
+							split.push_back(edge.Slice(j / 3.0, (j + 1) / 3.0));
+						}
+					}
+
+					edges.swap(split);
+
+					corner = 0;
+				}
+
+				size_t count = edges.size();
+
+				for (size_t i = 0; i < count; i++)
+				{
+					//Splits the edges into three runs of roughly equal length
+					int32_t third = (int32_t)(3 + 2.875 * i / (count - 1) - 1.4375 + 0.5) - 3;
+
+					edges[(corner + i) % count].color = colors[1 + third];
+				}
+			}
+			else
+			{
+				size_t cornerCount = corners.size();
+				size_t spline = 0;
+				size_t start = corners[0];
+				size_t count = edges.size();
+
+				int32_t color = EDGE_COLOR_WHITE;
+
+				SwitchColor(color, seed);
+
+				int32_t initialColor = color;
+
+				for (size_t i = 0; i < count; i++)
+				{
+					size_t index = (start + i) % count;
+
+					if (spline + 1 < cornerCount && corners[spline + 1] == index)
+					{
+						spline++;
+
+						SwitchColor(color, seed, spline == cornerCount - 1 ? initialColor : EDGE_COLOR_BLACK);
+					}
+
+					edges[index].color = color;
+				}
+			}
+		}
+	}
+
+	//Crossings of the outline with the horizontal line at `y`, sorted left to right. Curves are flattened, which only matters
+	//for the sign of samples right on the edge, where the distance is close to zero anyway.
+	void FindCrossings(double y, std::vector<Crossing>& crossings) const
+	{
+		const int32_t CurveSteps = 16;
+
+		crossings.clear();
+
+		for (const Contour& contour : contours)
+		{
+			for (const Edge& edge : contour.edges)
+			{
+				int32_t steps = edge.degree == 1 ? 1 : CurveSteps;
+
+				Point a = edge.points[0];
+
+				for (int32_t i = 1; i <= steps; i++)
+				{
+					Point b = i == steps ? edge.End() : edge.PointAt((double)i / steps);
+
+					if ((a.y <= y && b.y > y) || (a.y > y && b.y <= y))
+					{
+						Crossing crossing;
+
+						crossing.x = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+						crossing.direction = b.y > a.y ? 1 : -1;
+
+						crossings.push_back(crossing);
+					}
+
+					a = b;
+				}
+			}
+		}
+
+		std::sort(crossings.begin(), crossings.end());
+	}
+
+	static float Median(float a, float b, float c)
+	{
+		return std::max(std::min(a, b), std::min(std::max(a, b), c));
+	}
+
+	//Writes the red, green and blue pseudo-distances and the true distance of a sample, in pixels
+	void SamplePixel(const Point& p, double orientation, bool inside, float* pixel) const
+	{
+		SignedDistance channelDistances[3];
+		const Edge* channelEdges[3] = { nullptr, nullptr, nullptr };
+		double channelParams[3] = { 0, 0, 0 };
+
+		SignedDistance minDistance;
+
+		for (const Contour& contour : contours)
+		{
+			for (const Edge& edge : contour.edges)
+			{
+				//Skip edges that can't be closer than what was already found for any of their channels
+				double bound = edge.BoundsDistance(p);
+
+				if (bound > std::fabs(minDistance.distance) &&
+					((edge.color & EDGE_COLOR_RED) == 0 || bound > std::fabs(channelDistances[0].distance)) &&
+					((edge.color & EDGE_COLOR_GREEN) == 0 || bound > std::fabs(channelDistances[1].distance)) &&
+					((edge.color & EDGE_COLOR_BLUE) == 0 || bound > std::fabs(channelDistances[2].distance)))
+				{
+					continue;
+				}
+
+				double param;
+
+				SignedDistance distance = edge.Distance(p, param);
+
+				if (distance < minDistance)
+				{
+					minDistance = distance;
+				}
+
+				for (int32_t channel = 0; channel < 3; channel++)
+				{
+					if ((edge.color & (1 << channel)) != 0 && distance < channelDistances[channel])
+					{
+						channelDistances[channel] = distance;
+						channelEdges[channel] = &edge;
+						channelParams[channel] = param;
+					}
+				}
+			}
+		}
+
+		double trueDistance = inside ? std::fabs(minDistance.distance) : -std::fabs(minDistance.distance);
+
+		for (int32_t channel = 0; channel < 3; channel++)
+		{
+			if (channelEdges[channel] == nullptr)
+			{
+				pixel[channel] = (float)trueDistance;
+
+				continue;
+			}
+
+			channelEdges[channel]->ToPseudoDistance(channelDistances[channel], p, channelParams[channel]);
+
+			pixel[channel] = (float)(channelDistances[channel].distance * orientation);
+		}
+
+		pixel[3] = (float)trueDistance;
+
+		//Overlapping or reversed contours can give the channels the wrong sign, the true distance is always right
+		if ((Median(pixel[0], pixel[1], pixel[2]) > 0) != inside)
+		{
+			pixel[0] = pixel[1] = pixel[2] = pixel[3];
+		}
+	}
+
+	//Whether interpolating between two neighbouring samples would make the median cross the edge where it shouldn't
+	static bool DetectClash(const float* a, const float* b, double threshold)
+	{
+		float a0 = a[0], a1 = a[1], a2 = a[2];
+		float b0 = b[0], b1 = b[1], b2 = b[2];
+
+		//Sort the channels by how much they change between the samples
+		if (std::fabs(b0 - a0) < std::fabs(b1 - a1))
+		{
+			std::swap(a0, a1);
+			std::swap(b0, b1);
+		}
+
+		if (std::fabs(b1 - a1) < std::fabs(b2 - a2))
+		{
+			std::swap(a1, a2);
+			std::swap(b1, b2);
+
+			if (std::fabs(b0 - a0) < std::fabs(b1 - a1))
+			{
+				std::swap(a0, a1);
+				std::swap(b0, b1);
+			}
+		}
+
+		return std::fabs(b1 - a1) >= threshold && (b0 == b1 && b0 == b2) == false && std::fabs(a2 - 0.5f) >= std::fabs(b2 - 0.5f);
+	}
+
+	//Replaces samples that would produce artifacts between them and their neighbours with their median
+	static void CorrectClashes(std::vector<float>& field, int32_t width, int32_t height, double threshold)
+	{
+		std::vector<size_t> clashes;
+
+		auto Sample = [&](int32_t x, int32_t y) { return &field[((size_t)y * width + x) * 4]; };
+
+		for (int32_t y = 0; y < height; y++)
+		{
+			for (int32_t x = 0; x < width; x++)
+			{
+				const float* sample = Sample(x, y);
+
+				if ((x > 0 && DetectClash(sample, Sample(x - 1, y), threshold)) ||
+					(x < width - 1 && DetectClash(sample, Sample(x + 1, y), threshold)) ||
+					(y > 0 && DetectClash(sample, Sample(x, y - 1), threshold)) ||
+					(y < height - 1 && DetectClash(sample, Sample(x, y + 1), threshold)))
+				{
+					clashes.push_back((size_t)y * width + x);
+				}
+			}
+		}
+
+		for (size_t index : clashes)
+		{
+			float* sample = &field[index * 4];
+
+			sample[0] = sample[1] = sample[2] = Median(sample[0], sample[1], sample[2]);
+		}
+	}
+
+	std::vector<Contour> contours;
+	Point position;
+};
@@ -0,0 +1,455 @@
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+//Keeps glyphs in a fixed size atlas that is filled on demand, one shelf at a time.
+//When the atlas is full the least recently used glyphs are evicted and their space is reused.
+//Glyphs used during the current `use` (usually the frame being rendered) are never evicted, since text referencing them may still be drawn.
+//If they still leave no room for a glyph, they're packed again from scratch and the caller moves their pixels, see Repacked.
+class GlyphCache
+{
+public:
+	struct Entry
+	{
+		uint32_t codepoint;
+
+		//The space reserved for the glyph in the atlas, zero sized for glyphs without pixels
+		int32_t slotX, slotY, slotWidth, slotHeight;
+
+		//The space the glyph asked for, at the start of its slot. Slots can be larger when they reuse the space of another glyph.
+		int32_t rectWidth, rectHeight;
+
+		//Placement and metrics of the glyph, filled in by the caller
+		int32_t x, y, width, height, xOffset, yOffset, xAdvance;
+
+		//Whether the glyph is available, missing characters are cached too so they're only looked up once
+		bool valid;
+
+		uint32_t lastUse;
+	};
+
+	//A glyph kept when the atlas was packed again. The `width` by `height` pixels at the start of its old slot go to the start of the new one.
+	struct Move
+	{
+		int32_t fromX, fromY, toX, toY, width, height;
+	};
+
+	GlyphCache(int32_t width, int32_t height) : width(width), height(height), repacked(false)
+	{
+		//Shelves always cover the whole atlas, the space nothing uses yet is one empty shelf
+		shelves.push_back(Shelf(0, height));
+	}
+
+	//Returns the cached glyph for a codepoint and marks it as used, or nullptr if it isn't cached
+	const Entry* Find(uint32_t codepoint, uint32_t use)
+	{
+		auto it = lookup.find(codepoint);
+
+		if (it == lookup.end())
+		{
+			return nullptr;
+		}
+
+		it->second->lastUse = use;
+
+		//Most recently used glyphs are kept in front
+		entries.splice(entries.begin(), entries, it->second);
+
+		return &*it->second;
+	}
+
+	//Adds a glyph, finding `rectWidth` by `rectHeight` pixels of space for it if it has any.
+	//Returns nullptr if there's no space left even after evicting the glyphs that weren't used during `use` and packing the rest again.
+	Entry* Insert(uint32_t codepoint, int32_t rectWidth, int32_t rectHeight, uint32_t use)
+	{
+		Rect rect(0, 0, 0, 0);
+
+		repacked = false;
+		moves.clear();
+
+		if (rectWidth > 0 && rectHeight > 0 && Allocate(rectWidth, rectHeight, use, rect) == false)
+		{
+			return nullptr;
+		}
+
+		Entry entry;
+
+		entry.codepoint = codepoint;
+		entry.slotX = rect.x;
+		entry.slotY = rect.y;
+		entry.slotWidth = rect.width;
+		entry.slotHeight = rect.height;
+		entry.rectWidth = rectWidth > 0 && rectHeight > 0 ? rectWidth : 0;
+		entry.rectHeight = rectWidth > 0 && rectHeight > 0 ? rectHeight : 0;
+		entry.x = entry.y = entry.width = entry.height = 0;
+		entry.xOffset = entry.yOffset = entry.xAdvance = 0;
+		entry.valid = false;
+		entry.lastUse = use;
+
+		entries.push_front(entry);
+
+		lookup[codepoint] = entries.begin();
+
+		return &entries.front();
+	}
+
+	//Whether the last Insert packed the atlas again. The glyphs in Moves are the only ones left, everything else in the atlas is gone.
+	bool Repacked() const
+	{
+		return repacked;
+	}
+
+	const std::vector<Move>& Moves() const
+	{
+		return moves;
+	}
+
+private:
+	struct Rect
+	{
+		Rect(int32_t x, int32_t y, int32_t width, int32_t height) : x(x), y(y), width(width), height(height) {}
+
+		int32_t x, y, width, height;
+	};
+
+	struct Shelf
+	{
+		Shelf(int32_t y, int32_t height) : y(y), height(height), x(0), glyphCount(0) {}
+
+		int32_t y, height, x, glyphCount;
+
+		//Space of evicted glyphs
+		std::vector<Rect> freeRects;
+	};
+
+	bool Allocate(int32_t rectWidth, int32_t rectHeight, uint32_t use, Rect& rect)
+	{
+		if (rectWidth > width || rectHeight > height)
+		{
+			return false;
+		}
+
+		for (;;)
+		{
+			if (AllocateFree(rectWidth, rectHeight, rect) || AllocateShelf(rectWidth, rectHeight, rect))
+			{
+				return true;
+			}
+
+			if (EvictOldest(use) == false)
+			{
+				break;
+			}
+		}
+
+		return Repack(rectWidth, rectHeight, rect);
+	}
+
+	//Reuses the space of an evicted glyph, picking the one that wastes the least
+	bool AllocateFree(int32_t rectWidth, int32_t rectHeight, Rect& rect)
+	{
+		Shelf* bestShelf = nullptr;
+		size_t bestIndex = 0;
+		int64_t bestWaste = 0;
+
+		for (auto& shelf : shelves)
+		{
+			for (size_t i = 0; i < shelf.freeRects.size(); i++)
+			{
+				const Rect& r = shelf.freeRects[i];
+
+				if (r.width < rectWidth || r.height < rectHeight)
+				{
+					continue;
+				}
+
+				int64_t waste = (int64_t)r.width * r.height - (int64_t)rectWidth * rectHeight;
+
+				if (bestShelf == nullptr || waste < bestWaste)
+				{
+					bestShelf = &shelf;
+					bestIndex = i;
+					bestWaste = waste;
+				}
+			}
+		}
+
+		if (bestShelf == nullptr)
+		{
+			return false;
+		}
+
+		//Keeps the whole space so it can be reused by a glyph as large as the one that was there
+		rect = bestShelf->freeRects[bestIndex];
+
+		bestShelf->freeRects[bestIndex] = bestShelf->freeRects.back();
+		bestShelf->freeRects.pop_back();
+		bestShelf->glyphCount++;
+
+		return true;
+	}
+
+	//Places a glyph on the shortest shelf it fits on without wasting most of its height, then on a new shelf,
+	//and only then on any taller shelf with room left
+	bool AllocateShelf(int32_t rectWidth, int32_t rectHeight, Rect& rect)
+	{
+		return AllocateUsedShelf(rectWidth, rectHeight, true, rect) ||
+			AllocateEmptyShelf(rectWidth, rectHeight, rect) ||
+			AllocateUsedShelf(rectWidth, rectHeight, false, rect);
+	}
+
+	//Places a glyph on the shortest shelf that already has glyphs and fits it.
+	//Unless `strict` is false, shelves much taller than the glyph are skipped since it would waste most of their space.
+	bool AllocateUsedShelf(int32_t rectWidth, int32_t rectHeight, bool strict, Rect& rect)
+	{
+		Shelf* best = nullptr;
+
+		for (auto& shelf : shelves)
+		{
+			if (shelf.glyphCount == 0 || shelf.height < rectHeight || (strict && shelf.height > rectHeight + rectHeight / 2) ||
+				shelf.x + rectWidth > width)
+			{
+				continue;
+			}
+
+			if (best == nullptr || shelf.height < best->height)
+			{
+				best = &shelf;
+			}
+		}
+
+		if (best == nullptr)
+		{
+			return false;
+		}
+
+		rect = Rect(best->x, best->y, rectWidth, best->height);
+
+		best->x += rectWidth;
+		best->glyphCount++;
+
+		return true;
+	}
+
+	//Starts a shelf as tall as the glyph in the smallest empty shelf it fits in, leaving the rest of that space empty
+	bool AllocateEmptyShelf(int32_t rectWidth, int32_t rectHeight, Rect& rect)
+	{
+		size_t best = shelves.size();
+
+		for (size_t i = 0; i < shelves.size(); i++)
+		{
+			if (shelves[i].glyphCount == 0 && shelves[i].height >= rectHeight &&
+				(best == shelves.size() || shelves[i].height < shelves[best].height))
+			{
+				best = i;
+			}
+		}
+
+		if (best == shelves.size())
+		{
+			return false;
+		}
+
+		if (shelves[best].height > rectHeight)
+		{
+			shelves.insert(shelves.begin() + best + 1, Shelf(shelves[best].y + rectHeight, shelves[best].height - rectHeight));
+
+			shelves[best].height = rectHeight;
+		}
+
+		Shelf& shelf = shelves[best];
+
+		rect = Rect(0, shelf.y, rectWidth, shelf.height);
+
+		shelf.x = rectWidth;
+		shelf.glyphCount = 1;
+
+		return true;
+	}
+
+	//Every glyph left was used during `use`, so they're packed again from scratch along with the new one, tallest first.
+	//Nothing changes unless they all fit.
+	bool Repack(int32_t rectWidth, int32_t rectHeight, Rect& rect)
+	{
+		std::vector<Entry*> kept;
+
+		for (auto& entry : entries)
+		{
+			if (entry.rectWidth > 0 && entry.rectHeight > 0)
+			{
+				kept.push_back(&entry);
+			}
+		}
+
+		//The last index is the new glyph
+		std::vector<size_t> order(kept.size() + 1);
+
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			order[i] = i;
+		}
+
+		auto RectHeight = [&](size_t index)
+		{
+			return index < kept.size() ? kept[index]->rectHeight : rectHeight;
+		};
+
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+		{
+			return RectHeight(a) > RectHeight(b);
+		});
+
+		std::vector<Shelf> oldShelves;
+
+		oldShelves.swap(shelves);
+
+		shelves.push_back(Shelf(0, height));
+
+		std::vector<Rect> rects(order.size(), Rect(0, 0, 0, 0));
+
+		for (auto index : order)
+		{
+			int32_t w = index < kept.size() ? kept[index]->rectWidth : rectWidth;
+
+			if (AllocateShelf(w, RectHeight(index), rects[index]) == false)
+			{
+				shelves.swap(oldShelves);
+
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < kept.size(); i++)
+		{
+			Entry& entry = *kept[i];
+			const Rect& r = rects[i];
+
+			Move move;
+
+			move.fromX = entry.slotX;
+			move.fromY = entry.slotY;
+			move.toX = r.x;
+			move.toY = r.y;
+			move.width = entry.rectWidth;
+			move.height = entry.rectHeight;
+
+			moves.push_back(move);
+
+			entry.x += r.x - entry.slotX;
+			entry.y += r.y - entry.slotY;
+			entry.slotX = r.x;
+			entry.slotY = r.y;
+			entry.slotWidth = r.width;
+			entry.slotHeight = r.height;
+		}
+
+		rect = rects.back();
+		repacked = true;
+
+		return true;
+	}
+
+	//Evicts the least recently used glyph, unless it was used during `use`
+	bool EvictOldest(uint32_t use)
+	{
+		if (entries.empty() || entries.back().lastUse == use)
+		{
+			return false;
+		}
+
+		Entry& entry = entries.back();
+
+		Release(entry);
+
+		lookup.erase(entry.codepoint);
+		entries.pop_back();
+
+		return true;
+	}
+
+	void Release(const Entry& entry)
+	{
+		if (entry.slotWidth <= 0 || entry.slotHeight <= 0)
+		{
+			return;
+		}
+
+		size_t index = 0;
+
+		while (index < shelves.size() && shelves[index].y != entry.slotY)
+		{
+			index++;
+		}
+
+		if (index == shelves.size())
+		{
+			return;
+		}
+
+		Shelf& shelf = shelves[index];
+
+		//Empty shelves start over so their space isn't split by the glyphs that were there
+		if (--shelf.glyphCount == 0)
+		{
+			shelf.freeRects.clear();
+			shelf.x = 0;
+
+			MergeEmptyShelves(index);
+
+			return;
+		}
+
+		shelf.freeRects.push_back(Rect(entry.slotX, entry.slotY, entry.slotWidth, entry.slotHeight));
+
+		//Space freed at the end of the shelf goes back to it, so glyphs of any width can use it
+		for (size_t i = 0; i < shelf.freeRects.size();)
+		{
+			if (shelf.freeRects[i].x + shelf.freeRects[i].width == shelf.x)
+			{
+				shelf.x = shelf.freeRects[i].x;
+
+				shelf.freeRects[i] = shelf.freeRects.back();
+				shelf.freeRects.pop_back();
+
+				i = 0;
+
+				continue;
+			}
+
+			i++;
+		}
+	}
+
+	//Joins an empty shelf with the empty shelves above and below it, so taller glyphs can use the space
+	void MergeEmptyShelves(size_t index)
+	{
+		if (index + 1 < shelves.size() && shelves[index + 1].glyphCount == 0)
+		{
+			shelves[index].height += shelves[index + 1].height;
+
+			shelves.erase(shelves.begin() + index + 1);
+		}
+
+		if (index > 0 && shelves[index - 1].glyphCount == 0)
+		{
+			shelves[index - 1].height += shelves[index].height;
+
+			shelves.erase(shelves.begin() + index);
+		}
+	}
+
+	int32_t width;
+	int32_t height;
+
+	//Sorted from top to bottom
+	std::vector<Shelf> shelves;
+	std::list<Entry> entries;
+	std::unordered_map<uint32_t, std::list<Entry>::iterator> lookup;
+
+	bool repacked;
+	std::vector<Move> moves;
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+//Packs rectangles into a fixed size area one at a time, placing each at the lowest position of the skyline where it fits
+class SkylinePacker
+{
+public:
+	SkylinePacker(int32_t width, int32_t height) : width(width), height(height)
+	{
+		nodes.push_back(Node(0, 0, width));
+	}
+
+	//Returns false if the rectangle doesn't fit anymore
+	bool Pack(int32_t rectWidth, int32_t rectHeight, int32_t& x, int32_t& y)
+	{
+		if (rectWidth <= 0 || rectHeight <= 0 || rectWidth > width || rectHeight > height)
+		{
+			return false;
+		}
+
+		size_t bestIndex = SIZE_MAX;
+		int32_t bestY = 0;
+		int64_t bestWaste = 0;
+
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			int32_t nodeY;
+			int64_t waste;
+
+			if (Fit(i, rectWidth, rectHeight, nodeY, waste) == false)
+			{
+				continue;
+			}
+
+			if (bestIndex == SIZE_MAX || nodeY < bestY || (nodeY == bestY && waste < bestWaste))
+			{
+				bestIndex = i;
+				bestY = nodeY;
+				bestWaste = waste;
+			}
+		}
+
+		if (bestIndex == SIZE_MAX)
+		{
+			return false;
+		}
+
+		x = nodes[bestIndex].x;
+		y = bestY;
+
+		Place(bestIndex, rectWidth, bestY + rectHeight);
+
+		return true;
+	}
+
+private:
+	struct Node
+	{
+		Node(int32_t x, int32_t y, int32_t width) : x(x), y(y), width(width) {}
+
+		int32_t x, y, width;
+	};
+
+	//Finds the height a rectangle starting at a node would rest on, and the area left unused below it
+	bool Fit(size_t index, int32_t rectWidth, int32_t rectHeight, int32_t& y, int64_t& waste) const
+	{
+		int32_t x = nodes[index].x;
+
+		if (x + rectWidth > width)
+		{
+			return false;
+		}
+
+		y = 0;
+
+		for (size_t i = index; i < nodes.size() && nodes[i].x < x + rectWidth; i++)
+		{
+			if (nodes[i].y > y)
+			{
+				y = nodes[i].y;
+			}
+		}
+
+		if (y + rectHeight > height)
+		{
+			return false;
+		}
+
+		waste = 0;
+
+		for (size_t i = index; i < nodes.size() && nodes[i].x < x + rectWidth; i++)
+		{
+			int32_t end = nodes[i].x + nodes[i].width < x + rectWidth ? nodes[i].x + nodes[i].width : x + rectWidth;
+
+			waste += (int64_t)(end - nodes[i].x) * (y - nodes[i].y);
+		}
+
+		return true;
+	}
+
+	void Place(size_t index, int32_t rectWidth, int32_t top)
+	{
+		int32_t x = nodes[index].x;
+		int32_t end = x + rectWidth;
+
+		nodes.insert(nodes.begin() + index, Node(x, top, rectWidth));
+
+		//Trim the nodes now covered by the rectangle
+		size_t i = index + 1;
+
+		while (i < nodes.size() && nodes[i].x < end)
+		{
+			int32_t nodeEnd = nodes[i].x + nodes[i].width;
+
+			if (nodeEnd <= end)
+			{
+				nodes.erase(nodes.begin() + i);
+
+				continue;
+			}
+
+			nodes[i].width = nodeEnd - end;
+			nodes[i].x = end;
+
+			break;
+		}
+
+		//Merge neighbours at the same height
+		for (i = index > 0 ? index - 1 : 0; i + 1 < nodes.size() && i <= index + 1;)
+		{
+			if (nodes[i].y == nodes[i + 1].y)
+			{
+				nodes[i].width += nodes[i + 1].width;
+
+				nodes.erase(nodes.begin() + i + 1);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+	int32_t width;
+	int32_t height;
+	std::vector<Node> nodes;
+};
@@ -2,11 +2,16 @@
 #include <memory>
 #include <ft2build.h>
 #include "common.h"
+#include "SkylinePacker.hpp"
+#include "GlyphCache.hpp"
+#include "DistanceFieldGenerator.hpp"
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include FT_MODULE_H
+#include FT_SIZES_H
 
 struct Color
 {
@@ -33,11 +38,83 @@ struct Glyph
 	Glyph() : bitmap(nullptr), xOffset(0), yOffset(0), width(0), height(0), xAdvance(0) {}
 };
 
+enum GlyphFormat
+{
+	GLYPH_FORMAT_RGBA = 0,
+	GLYPH_FORMAT_COVERAGE = 1,
+	GLYPH_FORMAT_SDF = 2,
+	GLYPH_FORMAT_MSDF = 3,
+};
+
+//FreeType's SDF renderer only accepts spreads in this range
+#define DISTANCE_FIELD_MIN_SPREAD 2
+#define DISTANCE_FIELD_MAX_SPREAD 32
+
+//Placement and metrics of a glyph in an atlas built by FreeTypeBuildAtlas
+struct AtlasGlyph
+{
+	uint32_t codepoint;
+	int32_t x;
+	int32_t y;
+	int32_t width;
+	int32_t height;
+	int32_t xOffset;
+	int32_t yOffset;
+	int32_t xAdvance;
+};
+
+//How many sizes of a font keep their own FT_Size, the least recently used one is reused for new sizes past this
+#define FONT_SIZE_CACHE_COUNT 8
+
+//A pixel size of a font with its scaled metrics, so switching back to it doesn't recompute them
+struct FontSize
+{
+	FontSize(uint32_t pixelSize, FT_Size size) : pixelSize(pixelSize), size(size), lineSpacing(0), lastUse(0) {}
+
+	uint32_t pixelSize;
+	FT_Size size;
+	int32_t lineSpacing;
+	uint32_t lastUse;
+};
+
 struct FontData
 {
+	FontData() : library(nullptr), face(nullptr), buffer(nullptr), activeSize(-1), sizeUse(0) {}
+
 	FT_Library library;
 	FT_Face face;
 	uint8_t* buffer;
+
+	//Owned by the face, so they're released along with it
+	std::vector<FontSize> sizes;
+	int32_t activeSize;
+	uint32_t sizeUse;
+};
+
+//Glyphs of a font at one size and format, rasterized into a GlyphCache atlas the first time they're requested
+struct GlyphCacheData
+{
+	GlyphCacheData(FontData* font, int32_t width, int32_t height) : font(font), fontSize(0), format(GLYPH_FORMAT_COVERAGE),
+		borderSize(0), spread(0), padding(0), pixelSize(0), width(width), height(height), cache(width, height),
+		dirtyLeft(width), dirtyTop(height), dirtyRight(0), dirtyBottom(0) {}
+
+	FontData* font;
+	uint32_t fontSize;
+	int32_t format;
+	int32_t borderSize;
+	int32_t spread;
+	int32_t padding;
+	int32_t pixelSize;
+	int32_t width;
+	int32_t height;
+
+	GlyphCache cache;
+
+	std::vector<uint8_t> atlas;
+	std::vector<uint8_t> pixels;
+
+	//The part of the atlas that changed since the last FreeTypeGlyphCacheTakeDirtyRegion
+	int32_t dirtyLeft, dirtyTop, dirtyRight, dirtyBottom;
 };
 
 void RasterCallback(const int32_t y, const int32_t count, const FT_Span* const spans, void* const user)
@@ -87,6 +164,92 @@ CEXPORT FontData * FreeTypeLoadFont(const void* ptr, int byteSize)
 	return outValue;
 }
 
+//Makes a pixel size the face's active size, only scaling the face the first time the size is used
+static FontSize* ActivateSize(FontData* ptr, uint32_t fontSize)
+{
+	ptr->sizeUse++;
+
+	if (ptr->activeSize >= 0 && ptr->sizes[ptr->activeSize].pixelSize == fontSize)
+	{
+		FontSize& active = ptr->sizes[ptr->activeSize];
+
+		active.lastUse = ptr->sizeUse;
+
+		return &active;
+	}
+
+	int32_t index = -1;
+
+	for (size_t i = 0; i < ptr->sizes.size(); i++)
+	{
+		if (ptr->sizes[i].pixelSize == fontSize)
+		{
+			index = (int32_t)i;
+
+			break;
+		}
+	}
+
+	if (index >= 0)
+	{
+		FontSize& size = ptr->sizes[index];
+
+		FT_Activate_Size(size.size);
+
+		size.lastUse = ptr->sizeUse;
+		ptr->activeSize = index;
+
+		return &size;
+	}
+
+	if (ptr->sizes.size() < FONT_SIZE_CACHE_COUNT)
+	{
+		FT_Size size;
+
+		if (FT_New_Size(ptr->face, &size) == FT_Err_Ok)
+		{
+			ptr->sizes.push_back(FontSize(fontSize, size));
+
+			index = (int32_t)ptr->sizes.size() - 1;
+		}
+		else if (ptr->sizes.empty())
+		{
+			//Falls back to scaling the face's own size, which no cached size uses
+			ptr->activeSize = -1;
+
+			FT_Set_Pixel_Sizes(ptr->face, 0, fontSize);
+
+			return nullptr;
+		}
+	}
+
+	//Reuses the least recently used size when the cache is full or a new size couldn't be made
+	if (index < 0)
+	{
+		index = 0;
+
+		for (size_t i = 1; i < ptr->sizes.size(); i++)
+		{
+			if (ptr->sizes[i].lastUse < ptr->sizes[index].lastUse)
+			{
+				index = (int32_t)i;
+			}
+		}
+	}
+
+	FontSize& size = ptr->sizes[index];
+
+	FT_Activate_Size(size.size);
+	FT_Set_Pixel_Sizes(ptr->face, 0, fontSize);
+
+	size.pixelSize = fontSize;
+	size.lineSpacing = (int32_t)(ptr->face->size->metrics.height >> 6);
+	size.lastUse = ptr->sizeUse;
+	ptr->activeSize = index;
+
+	return &size;
+}
+
 CEXPORT void FreeTypeSetSize(FontData* ptr, uint32_t fontSize)
 {
 	if (ptr == nullptr || ptr->face == nullptr)
@@ -94,7 +257,7 @@ CEXPORT void FreeTypeSetSize(FontData* ptr, uint32_t fontSize)
 		return;
 	}
 
-	FT_Set_Pixel_Sizes(ptr->face, 0, fontSize);
+	ActivateSize(ptr, fontSize);
 }
 
 CEXPORT int FreeTypeLineSpacing(FontData* ptr, uint32_t fontSize)
@@ -104,9 +267,14 @@ CEXPORT int FreeTypeLineSpacing(FontData* ptr, uint32_t fontSize)
 		return 0;
 	}
 
-	FreeTypeSetSize(ptr, fontSize);
+	FontSize* size = ActivateSize(ptr, fontSize);
 
-	return ptr->face->size->metrics.height >> 6;
+	if (size == nullptr)
+	{
+		return ptr->face->size->metrics.height >> 6;
+	}
+
+	return size->lineSpacing;
 }
 
 CEXPORT int FreeTypeKerning(FontData *ptr, uint32_t from, uint32_t to, int fontSize)
@@ -130,26 +298,44 @@ CEXPORT int FreeTypeKerning(FontData *ptr, uint32_t from, uint32_t to, int fontS
 	return kerning.x >> 6;
 }
 
-CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fontSize, Color textColor, Color secondaryTextColor,
-	int borderSize, Color borderColor)
+//Finds the top left of the spans of a glyph, which is where its bitmap starts
+static void SpanOrigin(const std::vector<Span>& spans, const std::vector<Span>& outlineSpans, float& minX, float& minY)
 {
-	if (ptr == nullptr || ptr->face == nullptr)
+	minX = minY = 0;
+
+	bool first = true;
+
+	for (const std::vector<Span>* list : { &spans, &outlineSpans })
 	{
-		return nullptr;
-	}
+		for (const Span& span : *list)
+		{
+			if (first || span.x < minX)
+				minX = (float)span.x;
 
-	FreeTypeSetSize(ptr, fontSize);
+			if (first || span.y < minY)
+				minY = (float)span.y;
+
+			first = false;
+		}
+	}
+}
 
+//Renders a character at the current size. `pixels` is left empty if the glyph has nothing to draw.
+//RGBA glyphs have their colors baked in. Coverage glyphs have two channels instead, the fill coverage and the border coverage,
+//so the colors can be applied when drawing.
+static bool RasterizeGlyph(FontData* ptr, uint32_t character, bool coverage, const Color& textColor, const Color& secondaryTextColor,
+	int borderSize, const Color& borderColor, Glyph& outValue, std::vector<uint8_t>& pixelData)
+{
 	FT_Glyph glyphDescriptor;
 
 	if (FT_Load_Char(ptr->face, character, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != FT_Err_Ok)
 	{
-		return nullptr;
+		return false;
 	}
 
 	if (FT_Get_Glyph(ptr->face->glyph, &glyphDescriptor) != 0)
 	{
-		return nullptr;
+		return false;
 	}
 
 	std::vector<Span> spans, outlineSpans;
@@ -187,9 +373,9 @@ CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fon
 	FT_BitmapGlyph bitmapGlyph = (FT_BitmapGlyph)glyphDescriptor;
 	FT_Bitmap& bitmap = bitmapGlyph->bitmap;
 
-	Glyph* outValue = new Glyph();
+	pixelData.clear();
 
-	outValue->xAdvance = glyphDescriptor->advance.x >> 16;
+	outValue.xAdvance = glyphDescriptor->advance.x >> 16;
 
 	uint32_t width = (uint32_t)bitmap.width;
 	uint32_t height = (uint32_t)bitmap.rows;
@@ -198,17 +384,23 @@ CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fon
 	{
 		FT_Done_Glyph(glyphDescriptor);
 
-		return outValue;
+		return true;
 	}
 
-	outValue->xOffset = bitmapGlyph->left;
-	outValue->yOffset = bitmapGlyph->top;
-	outValue->width = width;
-	outValue->height = height;
+	outValue.xOffset = bitmapGlyph->left;
+	outValue.yOffset = bitmapGlyph->top;
+	outValue.width = width;
+	outValue.height = height;
 
-	uint8_t * pixelBuffer = new uint8_t[width * height * 4];
+	//With a border, the bitmap is the stroked glyph and the fill is drawn over it from its spans
+	bool stroked = spans.empty() == false || outlineSpans.empty() == false;
 
-	memset(pixelBuffer, 0, width * height * 4);
+	uint32_t channelCount = coverage ? 2 : 4;
+	uint32_t bitmapChannel = coverage ? (stroked ? 1 : 0) : 3;
+
+	pixelData.assign(width * height * channelCount, 0);
+
+	uint8_t* pixelBuffer = pixelData.data();
 
 	const uint8_t* pixels = bitmap.buffer;
 
@@ -218,7 +410,7 @@ CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fon
 		{
 			for (uint32_t x = 0; x < width; x++)
 			{
-				uint32_t index = (x + y * width) * 4 + 3;
+				uint32_t index = (x + y * width) * channelCount + bitmapChannel;
 
 				pixelBuffer[index] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
 			}
@@ -232,7 +424,7 @@ CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fon
 		{
 			for (uint32_t x = 0; x < width; x++)
 			{
-				uint32_t index = (x + y * width) * 4 + 3;
+				uint32_t index = (x + y * width) * channelCount + bitmapChannel;
 
 				pixelBuffer[index] = pixels[x];
 			}
@@ -241,6 +433,40 @@ CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fon
 		}
 	}
 
+	if (coverage)
+	{
+		if (stroked)
+		{
+			float minX, minY;
+
+			SpanOrigin(spans, outlineSpans, minX, minY);
+
+			for (uint32_t i = 0; i < outlineSpans.size(); i++)
+			{
+				for (int32_t w = 0; w < outlineSpans[i].width; w++)
+				{
+					uint32_t index = (uint32_t)((height - 1 - (outlineSpans[i].y - minY)) * width + (outlineSpans[i].x - minX) + w) * 2;
+
+					pixelBuffer[index + 1] = (uint8_t)std::min(255, outlineSpans[i].coverage);
+				}
+			}
+
+			for (uint32_t i = 0; i < spans.size(); i++)
+			{
+				for (int32_t w = 0; w < spans[i].width; w++)
+				{
+					uint32_t index = (uint32_t)((height - 1 - (spans[i].y - minY)) * width + (spans[i].x - minX) + w) * 2;
+
+					pixelBuffer[index] = (uint8_t)std::min(255, spans[i].coverage);
+				}
+			}
+		}
+
+		FT_Done_Glyph(glyphDescriptor);
+
+		return true;
+	}
+
 	Color byteColor = textColor;
 	Color secondaryByteColor = secondaryTextColor;
 
@@ -287,57 +513,9 @@ CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fon
 
 	if (borderSize > 0)
 	{
-		float minX, minY, maxX, maxY;
-
-		for (uint32_t i = 0; i < spans.size(); i++)
-		{
-			if (i == 0)
-			{
-				minX = (float)spans[i].x;
-				minY = (float)spans[i].y;
-				maxX = (float)spans[i].x;
-				maxY = (float)spans[i].y;
-			}
-
-			if (spans[i].x < minX)
-				minX = (float)spans[i].x;
-
-			if (spans[i].x > maxX)
-				maxX = (float)spans[i].x;
-
-			if (spans[i].y < minY)
-				minY = (float)spans[i].y;
-
-			if (spans[i].y > maxY)
-				maxY = (float)spans[i].y;
-
-			if (spans[i].x + spans[i].width - 1 < minX)
-				minX = (float)(spans[i].x + spans[i].width - 1);
-
-			if (spans[i].x + spans[i].width - 1 > maxX)
-				maxX = (float)(spans[i].x + spans[i].width - 1);
-		}
+		float minX, minY;
 
-		for (uint32_t i = 0; i < outlineSpans.size(); i++)
-		{
-			if (outlineSpans[i].x < minX)
-				minX = (float)outlineSpans[i].x;
-
-			if (outlineSpans[i].x > maxX)
-				maxX = (float)outlineSpans[i].x;
-
-			if (outlineSpans[i].y < minY)
-				minY = (float)outlineSpans[i].y;
-
-			if (outlineSpans[i].y > maxY)
-				maxY = (float)outlineSpans[i].y;
-
-			if (outlineSpans[i].x + outlineSpans[i].width - 1 < minX)
-				minX = (float)(outlineSpans[i].x + outlineSpans[i].width - 1);
-
-			if (outlineSpans[i].x + outlineSpans[i].width - 1 > maxX)
-				maxX = (float)(outlineSpans[i].x + outlineSpans[i].width - 1);
-		}
+		SpanOrigin(spans, outlineSpans, minX, minY);
 
 		Color byteBorderColor = borderColor;
 
@@ -375,11 +553,517 @@ CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fon
 
 	FT_Done_Glyph(glyphDescriptor);
 
-	outValue->bitmap = pixelBuffer;
+	return true;
+}
+
+static int DistanceFieldMoveTo(const FT_Vector* to, void* user)
+{
+	((DistanceFieldGenerator*)user)->MoveTo(to->x / 64.0, to->y / 64.0);
+
+	return 0;
+}
+
+static int DistanceFieldLineTo(const FT_Vector* to, void* user)
+{
+	((DistanceFieldGenerator*)user)->LineTo(to->x / 64.0, to->y / 64.0);
+
+	return 0;
+}
+
+static int DistanceFieldConicTo(const FT_Vector* control, const FT_Vector* to, void* user)
+{
+	((DistanceFieldGenerator*)user)->QuadraticTo(control->x / 64.0, control->y / 64.0, to->x / 64.0, to->y / 64.0);
+
+	return 0;
+}
+
+static int DistanceFieldCubicTo(const FT_Vector* control1, const FT_Vector* control2, const FT_Vector* to, void* user)
+{
+	((DistanceFieldGenerator*)user)->CubicTo(control1->x / 64.0, control1->y / 64.0, control2->x / 64.0, control2->y / 64.0,
+		to->x / 64.0, to->y / 64.0);
+
+	return 0;
+}
+
+//Sets the spread used by FreeType's SDF renderer, clamped to what it supports. Returns the spread that was set.
+static int32_t SetDistanceFieldSpread(FontData* ptr, int32_t spread)
+{
+	spread = std::min(std::max(spread, DISTANCE_FIELD_MIN_SPREAD), DISTANCE_FIELD_MAX_SPREAD);
+
+	FT_Int value = spread;
+
+	FT_Property_Set(ptr->library, "sdf", "spread", &value);
+
+	return spread;
+}
+
+//Renders the distance field of a character at the current size, from its unhinted outline so it scales well.
+//SDF glyphs have one channel, MSDF glyphs have the multi-channel distance in RGB and the true distance in alpha.
+//The bitmap extends `spread` pixels past the outline on every side, and `pixels` is left empty if the glyph has nothing to draw.
+static bool RasterizeDistanceField(FontData* ptr, uint32_t character, int32_t format, int32_t spread, Glyph& outValue,
+	std::vector<uint8_t>& pixelData)
+{
+	if (FT_Load_Char(ptr->face, character, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP) != FT_Err_Ok)
+	{
+		return false;
+	}
+
+	FT_GlyphSlot slot = ptr->face->glyph;
+
+	pixelData.clear();
+
+	outValue.xAdvance = (uint32_t)(slot->advance.x >> 6);
+
+	if (slot->format != FT_GLYPH_FORMAT_OUTLINE || slot->outline.n_contours <= 0)
+	{
+		return true;
+	}
+
+	if (format == GLYPH_FORMAT_SDF)
+	{
+		if (FT_Render_Glyph(slot, FT_RENDER_MODE_SDF) != FT_Err_Ok)
+		{
+			return false;
+		}
+
+		FT_Bitmap& bitmap = slot->bitmap;
+
+		if (bitmap.width == 0 || bitmap.rows == 0)
+		{
+			return true;
+		}
+
+		outValue.xOffset = slot->bitmap_left;
+		outValue.yOffset = slot->bitmap_top;
+		outValue.width = bitmap.width;
+		outValue.height = bitmap.rows;
+
+		pixelData.resize((size_t)bitmap.width * bitmap.rows);
+
+		for (uint32_t y = 0; y < bitmap.rows; y++)
+		{
+			memcpy(pixelData.data() + (size_t)y * bitmap.width, bitmap.buffer + (ptrdiff_t)y * bitmap.pitch, bitmap.width);
+		}
+
+		return true;
+	}
+
+	FT_BBox box;
+
+	FT_Outline_Get_CBox(&slot->outline, &box);
+
+	//Same placement as FreeType's SDF renderer
+	int32_t left = (int32_t)std::floor(box.xMin / 64.0) - spread;
+	int32_t right = (int32_t)std::ceil(box.xMax / 64.0) + spread;
+	int32_t bottom = (int32_t)std::floor(box.yMin / 64.0) - spread;
+	int32_t top = (int32_t)std::ceil(box.yMax / 64.0) + spread;
+
+	DistanceFieldGenerator generator;
+
+	FT_Outline_Funcs functions;
+
+	memset(&functions, 0, sizeof(functions));
+
+	functions.move_to = DistanceFieldMoveTo;
+	functions.line_to = DistanceFieldLineTo;
+	functions.conic_to = DistanceFieldConicTo;
+	functions.cubic_to = DistanceFieldCubicTo;
+
+	if (FT_Outline_Decompose(&slot->outline, &functions, &generator) != FT_Err_Ok)
+	{
+		return false;
+	}
+
+	outValue.xOffset = left;
+	outValue.yOffset = top;
+	outValue.width = right - left;
+	outValue.height = top - bottom;
+
+	pixelData.resize((size_t)outValue.width * outValue.height * 4);
+
+	generator.Generate(pixelData.data(), right - left, top - bottom, left, top, spread,
+		FT_Outline_Get_Orientation(&slot->outline) == FT_ORIENTATION_TRUETYPE, (slot->outline.flags & FT_OUTLINE_EVEN_ODD_FILL) != 0);
+
+	return true;
+}
+
+CEXPORT Glyph *FreeTypeLoadGlyph(FontData* ptr, uint32_t character, uint32_t fontSize, Color textColor, Color secondaryTextColor,
+	int borderSize, Color borderColor)
+{
+	if (ptr == nullptr || ptr->face == nullptr)
+	{
+		return nullptr;
+	}
+
+	FreeTypeSetSize(ptr, fontSize);
+
+	Glyph* outValue = new Glyph();
+
+	std::vector<uint8_t> pixels;
+
+	if (RasterizeGlyph(ptr, character, false, textColor, secondaryTextColor, borderSize, borderColor, *outValue, pixels) == false)
+	{
+		delete outValue;
+
+		return nullptr;
+	}
+
+	if (pixels.empty() == false)
+	{
+		outValue->bitmap = new uint8_t[pixels.size()];
+
+		memcpy(outValue->bitmap, pixels.data(), pixels.size());
+	}
+
+	return outValue;
+}
+
+//Renders every codepoint the font has a glyph for with `rasterize` and packs them into `atlas`, a buffer of `atlasWidth` by
+//`atlasHeight` pixels of `pixelSize` bytes. Glyphs without pixels are left out. `glyphs` needs room for `codepointCount` entries.
+//Returns the amount of glyphs written to `glyphs`, or -1 if they don't fit in the atlas.
+template<typename Rasterize>
+static int32_t PackAtlas(FontData* ptr, const uint32_t* codepoints, int32_t codepointCount, size_t pixelSize, uint8_t* atlas,
+	int32_t atlasWidth, int32_t atlasHeight, int32_t padding, AtlasGlyph* glyphs, const Rasterize& rasterize)
+{
+	memset(atlas, 0, (size_t)atlasWidth * atlasHeight * pixelSize);
+
+	SkylinePacker packer(atlasWidth, atlasHeight);
+
+	std::vector<uint8_t> pixels;
+
+	int32_t glyphCount = 0;
+
+	for (int32_t i = 0; i < codepointCount; i++)
+	{
+		//Missing characters would otherwise all render the font's placeholder glyph
+		if (FT_Get_Char_Index(ptr->face, codepoints[i]) == 0)
+		{
+			continue;
+		}
+
+		Glyph glyph;
+
+		if (rasterize(codepoints[i], glyph, pixels) == false || pixels.empty())
+		{
+			continue;
+		}
+
+		int32_t x, y;
+
+		if (packer.Pack((int32_t)glyph.width + padding * 2, (int32_t)glyph.height + padding * 2, x, y) == false)
+		{
+			return -1;
+		}
+
+		x += padding;
+		y += padding;
+
+		size_t rowSize = glyph.width * pixelSize;
+
+		for (uint32_t row = 0; row < glyph.height; row++)
+		{
+			memcpy(atlas + ((size_t)(y + row) * atlasWidth + x) * pixelSize, pixels.data() + row * rowSize, rowSize);
+		}
+
+		AtlasGlyph& outGlyph = glyphs[glyphCount++];
+
+		outGlyph.codepoint = codepoints[i];
+		outGlyph.x = x;
+		outGlyph.y = y;
+		outGlyph.width = (int32_t)glyph.width;
+		outGlyph.height = (int32_t)glyph.height;
+		outGlyph.xOffset = (int32_t)glyph.xOffset;
+		outGlyph.yOffset = (int32_t)glyph.yOffset;
+		outGlyph.xAdvance = (int32_t)glyph.xAdvance;
+	}
+
+	return glyphCount;
+}
+
+//Builds an atlas with PackAtlas. The pixels are RGBA, or fill and border coverage (two bytes each) if `format` is
+//GLYPH_FORMAT_COVERAGE, which ignores the colors.
+CEXPORT int32_t FreeTypeBuildAtlas(FontData* ptr, const uint32_t* codepoints, int32_t codepointCount, uint32_t fontSize,
+	int32_t format, Color textColor, Color secondaryTextColor, int borderSize, Color borderColor, uint8_t* atlas, int32_t atlasWidth,
+	int32_t atlasHeight, int32_t padding, AtlasGlyph* glyphs)
+{
+	if (ptr == nullptr || ptr->face == nullptr || codepoints == nullptr || codepointCount < 0 || atlas == nullptr ||
+		atlasWidth <= 0 || atlasHeight <= 0 || padding < 0 || glyphs == nullptr)
+	{
+		return -1;
+	}
+
+	FreeTypeSetSize(ptr, fontSize);
+
+	bool coverage = format == GLYPH_FORMAT_COVERAGE;
+
+	auto rasterize = [&](uint32_t codepoint, Glyph& glyph, std::vector<uint8_t>& pixels)
+	{
+		return RasterizeGlyph(ptr, codepoint, coverage, textColor, secondaryTextColor, borderSize, borderColor, glyph, pixels);
+	};
+
+	return PackAtlas(ptr, codepoints, codepointCount, coverage ? 2 : 4, atlas, atlasWidth, atlasHeight, padding, glyphs, rasterize);
+}
+
+//Renders the distance field of a character, see RasterizeDistanceField. `format` is GLYPH_FORMAT_SDF or GLYPH_FORMAT_MSDF.
+CEXPORT Glyph* FreeTypeLoadDistanceFieldGlyph(FontData* ptr, uint32_t character, uint32_t fontSize, int32_t format, int32_t spread)
+{
+	if (ptr == nullptr || ptr->face == nullptr || (format != GLYPH_FORMAT_SDF && format != GLYPH_FORMAT_MSDF))
+	{
+		return nullptr;
+	}
+
+	FreeTypeSetSize(ptr, fontSize);
+
+	spread = SetDistanceFieldSpread(ptr, spread);
+
+	Glyph* outValue = new Glyph();
+
+	std::vector<uint8_t> pixels;
+
+	if (RasterizeDistanceField(ptr, character, format, spread, *outValue, pixels) == false)
+	{
+		delete outValue;
+
+		return nullptr;
+	}
+
+	if (pixels.empty() == false)
+	{
+		outValue->bitmap = new uint8_t[pixels.size()];
+
+		memcpy(outValue->bitmap, pixels.data(), pixels.size());
+	}
+
+	return outValue;
+}
+
+//Builds a distance field atlas with PackAtlas, one byte per pixel for GLYPH_FORMAT_SDF and four for GLYPH_FORMAT_MSDF.
+//The spread is clamped between DISTANCE_FIELD_MIN_SPREAD and DISTANCE_FIELD_MAX_SPREAD.
+CEXPORT int32_t FreeTypeBuildDistanceFieldAtlas(FontData* ptr, const uint32_t* codepoints, int32_t codepointCount, uint32_t fontSize,
+	int32_t format, int32_t spread, uint8_t* atlas, int32_t atlasWidth, int32_t atlasHeight, int32_t padding, AtlasGlyph* glyphs)
+{
+	if (ptr == nullptr || ptr->face == nullptr || codepoints == nullptr || codepointCount < 0 || atlas == nullptr ||
+		atlasWidth <= 0 || atlasHeight <= 0 || padding < 0 || glyphs == nullptr ||
+		(format != GLYPH_FORMAT_SDF && format != GLYPH_FORMAT_MSDF))
+	{
+		return -1;
+	}
+
+	FreeTypeSetSize(ptr, fontSize);
+
+	spread = SetDistanceFieldSpread(ptr, spread);
+
+	auto rasterize = [&](uint32_t codepoint, Glyph& glyph, std::vector<uint8_t>& pixels)
+	{
+		return RasterizeDistanceField(ptr, codepoint, format, spread, glyph, pixels);
+	};
+
+	return PackAtlas(ptr, codepoints, codepointCount, format == GLYPH_FORMAT_SDF ? 1 : 4, atlas, atlasWidth, atlasHeight, padding,
+		glyphs, rasterize);
+}
+
+//Creates a cache that rasterizes glyphs into a `width` by `height` atlas on demand instead of building the whole atlas up front.
+//`format` is GLYPH_FORMAT_COVERAGE, GLYPH_FORMAT_SDF or GLYPH_FORMAT_MSDF, with the same pixels as the atlases built for them.
+//The cache uses the font, so it must be freed with FreeTypeFreeGlyphCache before the font is.
+CEXPORT GlyphCacheData* FreeTypeCreateGlyphCache(FontData* ptr, uint32_t fontSize, int32_t format, int32_t borderSize, int32_t spread,
+	int32_t width, int32_t height, int32_t padding)
+{
+	if (ptr == nullptr || ptr->face == nullptr || fontSize == 0 || width <= 0 || height <= 0 || padding < 0 ||
+		(format != GLYPH_FORMAT_COVERAGE && format != GLYPH_FORMAT_SDF && format != GLYPH_FORMAT_MSDF))
+	{
+		return nullptr;
+	}
+
+	GlyphCacheData* outValue = new GlyphCacheData(ptr, width, height);
+
+	outValue->fontSize = fontSize;
+	outValue->format = format;
+	outValue->borderSize = borderSize;
+	outValue->spread = std::min(std::max(spread, DISTANCE_FIELD_MIN_SPREAD), DISTANCE_FIELD_MAX_SPREAD);
+	outValue->padding = padding;
+	outValue->pixelSize = format == GLYPH_FORMAT_COVERAGE ? 2 : format == GLYPH_FORMAT_SDF ? 1 : 4;
+	outValue->atlas.resize((size_t)width * height * outValue->pixelSize);
 
 	return outValue;
 }
 
+static bool RasterizeCachedGlyph(GlyphCacheData* cache, uint32_t codepoint, Glyph& glyph, std::vector<uint8_t>& pixels)
+{
+	FreeTypeSetSize(cache->font, cache->fontSize);
+
+	if (cache->format == GLYPH_FORMAT_COVERAGE)
+	{
+		Color white = { 1, 1, 1, 1 };
+
+		return RasterizeGlyph(cache->font, codepoint, true, white, white, cache->borderSize, white, glyph, pixels);
+	}
+
+	SetDistanceFieldSpread(cache->font, cache->spread);
+
+	return RasterizeDistanceField(cache->font, codepoint, cache->format, cache->spread, glyph, pixels);
+}
+
+//Rebuilds the atlas after the cache packed its glyphs again, copying the ones it kept to their new slots
+static void MoveCachedGlyphs(GlyphCacheData* cache)
+{
+	std::vector<uint8_t> oldAtlas(cache->atlas.size(), 0);
+
+	oldAtlas.swap(cache->atlas);
+
+	size_t pixelSize = cache->pixelSize;
+
+	for (auto& move : cache->cache.Moves())
+	{
+		for (int32_t row = 0; row < move.height; row++)
+		{
+			memcpy(cache->atlas.data() + ((size_t)(move.toY + row) * cache->width + move.toX) * pixelSize,
+				oldAtlas.data() + ((size_t)(move.fromY + row) * cache->width + move.fromX) * pixelSize, move.width * pixelSize);
+		}
+	}
+
+	cache->dirtyLeft = 0;
+	cache->dirtyTop = 0;
+	cache->dirtyRight = cache->width;
+	cache->dirtyBottom = cache->height;
+}
+
+static const GlyphCache::Entry* AddCachedGlyph(GlyphCacheData* cache, uint32_t codepoint, uint32_t use)
+{
+	Glyph glyph;
+
+	//Missing characters would otherwise all render the font's placeholder glyph
+	bool hasPixels = FT_Get_Char_Index(cache->font->face, codepoint) != 0 &&
+		RasterizeCachedGlyph(cache, codepoint, glyph, cache->pixels) &&
+		cache->pixels.empty() == false;
+
+	int32_t padding = cache->padding;
+
+	GlyphCache::Entry* entry = hasPixels ?
+		cache->cache.Insert(codepoint, (int32_t)glyph.width + padding * 2, (int32_t)glyph.height + padding * 2, use) :
+		cache->cache.Insert(codepoint, 0, 0, use);
+
+	if (entry == nullptr || hasPixels == false)
+	{
+		return entry;
+	}
+
+	if (cache->cache.Repacked())
+	{
+		MoveCachedGlyphs(cache);
+	}
+
+	size_t pixelSize = cache->pixelSize;
+
+	//The space may still have an evicted glyph in it
+	for (int32_t row = 0; row < entry->slotHeight; row++)
+	{
+		memset(cache->atlas.data() + ((size_t)(entry->slotY + row) * cache->width + entry->slotX) * pixelSize, 0,
+			entry->slotWidth * pixelSize);
+	}
+
+	int32_t x = entry->slotX + padding;
+	int32_t y = entry->slotY + padding;
+
+	size_t rowSize = glyph.width * pixelSize;
+
+	for (uint32_t row = 0; row < glyph.height; row++)
+	{
+		memcpy(cache->atlas.data() + ((size_t)(y + row) * cache->width + x) * pixelSize, cache->pixels.data() + row * rowSize, rowSize);
+	}
+
+	entry->valid = true;
+	entry->x = x;
+	entry->y = y;
+	entry->width = (int32_t)glyph.width;
+	entry->height = (int32_t)glyph.height;
+	entry->xOffset = (int32_t)glyph.xOffset;
+	entry->yOffset = (int32_t)glyph.yOffset;
+	entry->xAdvance = (int32_t)glyph.xAdvance;
+
+	cache->dirtyLeft = std::min(cache->dirtyLeft, entry->slotX);
+	cache->dirtyTop = std::min(cache->dirtyTop, entry->slotY);
+	cache->dirtyRight = std::max(cache->dirtyRight, entry->slotX + entry->slotWidth);
+	cache->dirtyBottom = std::max(cache->dirtyBottom, entry->slotY + entry->slotHeight);
+
+	return entry;
+}
+
+//Finds a glyph in the cache, rasterizing it if it isn't there yet. Glyphs requested with the same `use` are kept until it changes,
+//though they can move when the atlas has to be packed again to fit a new glyph.
+//Returns 1 and writes `glyph` if the glyph is in the atlas, 0 if the font doesn't have it or it has no pixels,
+//or -1 if it doesn't fit in the atlas along with the glyphs requested during `use`.
+CEXPORT int32_t FreeTypeCacheGlyph(GlyphCacheData* cache, uint32_t codepoint, uint32_t use, AtlasGlyph* glyph)
+{
+	if (cache == nullptr || glyph == nullptr)
+	{
+		return -1;
+	}
+
+	const GlyphCache::Entry* entry = cache->cache.Find(codepoint, use);
+
+	if (entry == nullptr)
+	{
+		entry = AddCachedGlyph(cache, codepoint, use);
+
+		if (entry == nullptr)
+		{
+			return -1;
+		}
+	}
+
+	if (entry->valid == false)
+	{
+		return 0;
+	}
+
+	glyph->codepoint = codepoint;
+	glyph->x = entry->x;
+	glyph->y = entry->y;
+	glyph->width = entry->width;
+	glyph->height = entry->height;
+	glyph->xOffset = entry->xOffset;
+	glyph->yOffset = entry->yOffset;
+	glyph->xAdvance = entry->xAdvance;
+
+	return 1;
+}
+
+//Copies the part of the atlas that changed since the last call into `pixels`, tightly packed, so only it needs to be uploaded.
+//`pixels` needs room for the whole atlas. Returns 0 if nothing changed.
+CEXPORT int32_t FreeTypeGlyphCacheTakeDirtyRegion(GlyphCacheData* cache, int32_t* x, int32_t* y, int32_t* width, int32_t* height,
+	uint8_t* pixels)
+{
+	if (cache == nullptr || x == nullptr || y == nullptr || width == nullptr || height == nullptr || pixels == nullptr ||
+		cache->dirtyLeft >= cache->dirtyRight || cache->dirtyTop >= cache->dirtyBottom)
+	{
+		return 0;
+	}
+
+	*x = cache->dirtyLeft;
+	*y = cache->dirtyTop;
+	*width = cache->dirtyRight - cache->dirtyLeft;
+	*height = cache->dirtyBottom - cache->dirtyTop;
+
+	size_t rowSize = (size_t)*width * cache->pixelSize;
+
+	for (int32_t row = 0; row < *height; row++)
+	{
+		memcpy(pixels + row * rowSize, cache->atlas.data() + ((size_t)(*y + row) * cache->width + *x) * cache->pixelSize, rowSize);
+	}
+
+	cache->dirtyLeft = cache->width;
+	cache->dirtyTop = cache->height;
+	cache->dirtyRight = 0;
+	cache->dirtyBottom = 0;
+
+	return 1;
+}
+
+CEXPORT void FreeTypeFreeGlyphCache(GlyphCacheData* cache)
+{
+	delete cache;
+}
+
 CEXPORT void FreeTypeFreeGlyph(Glyph* ptr)
 {
 	if (ptr == nullptr)
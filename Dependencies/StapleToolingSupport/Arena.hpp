@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+//Bump allocator that owns all the memory of an imported scene.
+//Individual allocations are never freed, everything is released at once when the arena is destroyed.
+//Only use with types that don't need their destructor to run.
+class Arena
+{
+public:
+	Arena(size_t blockSize = 16 * 1024 * 1024) : blockSize(blockSize), current(nullptr), used(0), capacity(0), totalSize(0)
+	{
+	}
+
+	~Arena()
+	{
+		for (auto& block : blocks)
+		{
+			free(block);
+		}
+	}
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	void* Allocate(size_t size, size_t alignment = 16)
+	{
+		if (size == 0)
+		{
+			return nullptr;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		size_t offset = (used + alignment - 1) & ~(alignment - 1);
+
+		if (current == nullptr || offset + size > capacity)
+		{
+			size_t newCapacity = size + alignment > blockSize ? size + alignment : blockSize;
+
+			current = (uint8_t*)malloc(newCapacity);
+
+			if (current == nullptr)
+			{
+				printf("ERROR: Out of Memory!\n");
+
+				exit(1);
+			}
+
+			blocks.push_back(current);
+
+			capacity = newCapacity;
+			totalSize += newCapacity;
+
+			offset = ((uintptr_t)current + alignment - 1) & ~(uintptr_t)(alignment - 1);
+			offset -= (uintptr_t)current;
+		}
+
+		used = offset + size;
+
+		return current + offset;
+	}
+
+	template<typename T>
+	T* AllocateArray(size_t count)
+	{
+		if (count == 0)
+		{
+			return nullptr;
+		}
+
+		T* ptr = (T*)Allocate(sizeof(T) * count, alignof(T) > 16 ? alignof(T) : 16);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			new (ptr + i) T();
+		}
+
+		return ptr;
+	}
+
+	template<typename T>
+	T* AllocateUninitialized(size_t count)
+	{
+		return (T*)Allocate(sizeof(T) * count, alignof(T) > 16 ? alignof(T) : 16);
+	}
+
+	template<typename T>
+	T* Duplicate(const T* data, size_t count)
+	{
+		if (data == nullptr || count == 0)
+		{
+			return nullptr;
+		}
+
+		T* ptr = AllocateUninitialized<T>(count);
+
+		memcpy((void*)ptr, data, sizeof(T) * count);
+
+		return ptr;
+	}
+
+	size_t TotalSize() const
+	{
+		return totalSize;
+	}
+
+private:
+	size_t blockSize;
+	uint8_t* current;
+	size_t used;
+	size_t capacity;
+	size_t totalSize;
+	std::vector<uint8_t*> blocks;
+	std::mutex mutex;
+};
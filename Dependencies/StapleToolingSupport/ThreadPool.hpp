@@ -0,0 +1,257 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//A fixed set of workers taking jobs from one queue in submission order.
+//Import jobs are coarse, a whole mesh part or animation stack each, so a single queue doesn't see enough contention
+//to be worth per-worker queues and stealing.
+class ThreadPool
+{
+public:
+	ThreadPool(uint32_t threadCount) : stopping(false)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = 1;
+		}
+
+		for (uint32_t i = 0; i < threadCount; i++)
+		{
+			workers.push_back(std::thread([this]() { WorkerLoop(); }));
+		}
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+
+			stopping = true;
+		}
+
+		jobCondition.notify_all();
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	uint32_t ThreadCount() const
+	{
+		return (uint32_t)workers.size();
+	}
+
+	//`owner` identifies the jobs WaitUntil may run for a caller, usually the TaskGroup the job belongs to
+	void Enqueue(std::function<void()> job, const void* owner = nullptr)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+
+			jobs.push_back(Job(std::move(job), owner));
+		}
+
+		jobCondition.notify_one();
+	}
+
+	//Blocks until `done` returns true. Queued jobs of `owner` are run on the calling thread while waiting,
+	//so waiting from inside a job can't starve the pool. Jobs of other owners are left alone,
+	//so a wait never ends up running unrelated work that could take much longer than what it waits for.
+	template<typename Predicate>
+	void WaitUntil(const void* owner, Predicate done)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (done() == false)
+		{
+			auto it = jobs.end();
+
+			if (owner != nullptr)
+			{
+				for (it = jobs.begin(); it != jobs.end() && it->owner != owner; ++it)
+				{
+				}
+			}
+
+			if (it != jobs.end())
+			{
+				std::function<void()> job = std::move(it->function);
+
+				jobs.erase(it);
+
+				lock.unlock();
+
+				job();
+
+				lock.lock();
+
+				finishedCondition.notify_all();
+
+				continue;
+			}
+
+			finishedCondition.wait(lock);
+		}
+	}
+
+	//Shared by every import in the process, sized to the hardware thread count
+	static ThreadPool& Shared()
+	{
+		static ThreadPool pool(std::thread::hardware_concurrency());
+
+		return pool;
+	}
+
+private:
+	struct Job
+	{
+		Job(std::function<void()>&& function, const void* owner) : function(std::move(function)), owner(owner) {}
+
+		std::function<void()> function;
+		const void* owner;
+	};
+
+	void WorkerLoop()
+	{
+		for (;;)
+		{
+			std::function<void()> job;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+
+				jobCondition.wait(lock, [this]() { return stopping || jobs.empty() == false; });
+
+				if (jobs.empty())
+				{
+					return;
+				}
+
+				job = std::move(jobs.front().function);
+
+				jobs.pop_front();
+			}
+
+			job();
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+			}
+
+			finishedCondition.notify_all();
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::deque<Job> jobs;
+	std::mutex mutex;
+	std::condition_variable jobCondition;
+	std::condition_variable finishedCondition;
+	bool stopping;
+};
+
+//Tracks a set of jobs submitted to a ThreadPool so they can be waited on together
+class TaskGroup
+{
+public:
+	TaskGroup(ThreadPool& pool) : pool(&pool), pending(0)
+	{
+	}
+
+	TaskGroup() : pool(nullptr), pending(0)
+	{
+	}
+
+	~TaskGroup()
+	{
+		Wait();
+	}
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	void SetPool(ThreadPool& pool)
+	{
+		this->pool = &pool;
+	}
+
+	void Run(std::function<void()> job)
+	{
+		if (pool == nullptr)
+		{
+			job();
+
+			return;
+		}
+
+		pending.fetch_add(1);
+
+		pool->Enqueue([this, job]()
+		{
+			job();
+
+			pending.fetch_sub(1);
+		}, this);
+	}
+
+	void Wait()
+	{
+		if (pool == nullptr)
+		{
+			return;
+		}
+
+		pool->WaitUntil(this, [this]() { return pending.load() == 0; });
+	}
+
+private:
+	ThreadPool* pool;
+	std::atomic<uint32_t> pending;
+};
+
+//Splits [0, count) into ranges of at least `minimumBatch` items and runs `function(start, end)` for each of them.
+//Runs everything on the calling thread if `pool` is null or there isn't enough work to split.
+template<typename Function>
+void ParallelFor(ThreadPool* pool, size_t count, size_t minimumBatch, const Function& function)
+{
+	size_t batchCount = pool != nullptr && minimumBatch > 0 ? count / minimumBatch : 0;
+	size_t maxBatchCount = pool != nullptr ? pool->ThreadCount() * 4 : 0;
+
+	if (batchCount > maxBatchCount)
+	{
+		batchCount = maxBatchCount;
+	}
+
+	if (batchCount <= 1)
+	{
+		function((size_t)0, count);
+
+		return;
+	}
+
+	size_t batchSize = (count + batchCount - 1) / batchCount;
+
+	TaskGroup group(*pool);
+
+	for (size_t start = 0; start < count; start += batchSize)
+	{
+		size_t end = start + batchSize < count ? start + batchSize : count;
+
+		group.Run([&function, start, end]()
+		{
+			function(start, end);
+		});
+	}
+
+	group.Wait();
+}
@@ -1,22 +1,25 @@
+﻿#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <cstdlib>
 #include "common.h"
 #include "ufbx.h"
+#include "meshoptimizer.h"
+#include "mikktspace.h"
 #include "Math/Math.hpp"
+#include "Arena.hpp"
+#include "ThreadPool.hpp"
 
-#define DELETE(array)\
-	if(array != nullptr)\
-	{\
-		delete [] array;\
-		array = nullptr;\
-	}
-
-#define COPY(to, from, elementType, count)\
-	if(from != nullptr)\
-	{\
-		to = new elementType[count];\
-		memcpy(to, from, sizeof(elementType) * count);\
-	}
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
 
 static void PrintError(const ufbx_error* error, const char* description)
 {
@@ -27,41 +30,27 @@ static void PrintError(const ufbx_error* error, const char* description)
 	printf("ERROR: %s\n%s\n", description, buffer);
 }
 
-static void* AllocImpl(size_t typeSize, size_t count)
+//Size of an open file in bytes, or -1 on failure. Leaves the file at its end.
+//ftell returns a long, which is 32 bits on Windows, so it can't be used for files over 2 GB.
+static int64_t FileSize(FILE* fp)
 {
-	void* ptr = malloc(typeSize * count);
-
-	if (ptr == nullptr)
-	{
-		printf("ERROR: Out of Memory!\n");
-
-		exit(1);
-	}
-
-	memset(ptr, 0, typeSize * count);
-
-	return ptr;
+#ifdef _WIN32
+	return _fseeki64(fp, 0, SEEK_END) == 0 ? (int64_t)_ftelli64(fp) : -1;
+#else
+	return fseeko(fp, 0, SEEK_END) == 0 ? (int64_t)ftello(fp) : -1;
+#endif
 }
 
-static void* AllocDupImpl(size_t typeSize, size_t count, const void* data)
+//Moves a file over another one. The target is replaced atomically, so readers see either the old file or the new one.
+static bool MoveFileOver(const char* from, const char* to)
 {
-	void* ptr = malloc(typeSize * count);
-
-	if (ptr == nullptr)
-	{
-		printf("ERROR: Out of Memory!\n");
-
-		exit(1);
-	}
-
-	memcpy(ptr, data, typeSize * count);
-
-	return ptr;
+#ifdef _WIN32
+	return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return rename(from, to) == 0;
+#endif
 }
 
-#define Alloc(m_type, m_count) (m_type *)AllocImpl(sizeof(m_type), (m_count))
-#define AllocDup(m_type, m_count, m_data) (m_type *)AllocDupImpl(sizeof(m_type), (m_count), (m_data))
-
 static size_t MinSize(size_t a, size_t b)
 {
 	return a < b ? a : b;
@@ -77,69 +66,389 @@ static size_t ClampSize(size_t a, size_t min, size_t max)
 	return MinSize(MaxSize(a, min), max);
 }
 
+//Bumped whenever the layout of any exported struct changes, must match UFBX.ABIVersion on the C# side
+#define UFBX_ABI_VERSION 13
+
+//Reference into the string pool of a scene. Strings are stored as null terminated UTF-8.
 class String
 {
 public:
-	char data[10240];
+	int32_t offset;
 	int32_t length;
 
-	String() : length(0)
+	String() : offset(0), length(0)
+	{
+	}
+};
+
+class StringPool
+{
+public:
+	StringPool()
+	{
+		data.push_back('\0');
+	}
+
+	String Add(const char* ptr, size_t length)
+	{
+		String outValue;
+
+		if (ptr == nullptr || length == 0)
+		{
+			return outValue;
+		}
+
+		std::string key(ptr, length);
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		auto it = offsets.find(key);
+
+		if (it != offsets.end())
+		{
+			outValue.offset = it->second;
+		}
+		else
+		{
+			outValue.offset = (int32_t)data.size();
+
+			data.insert(data.end(), ptr, ptr + length);
+			data.push_back('\0');
+
+			offsets.emplace(std::move(key), outValue.offset);
+		}
+
+		outValue.length = (int32_t)length;
+
+		return outValue;
+	}
+
+	String Add(const char* ptr)
+	{
+		return Add(ptr, strlen(ptr));
+	}
+
+	String Add(const ufbx_string& string)
+	{
+		return Add(string.data, string.length);
+	}
+
+	const std::vector<char>& Data() const
+	{
+		return data;
+	}
+
+private:
+	std::vector<char> data;
+	std::unordered_map<std::string, int32_t> offsets;
+	std::mutex mutex;
+};
+
+//Vertex channels in the order the engine's vertex layouts place them
+enum VertexAttributeIndex : uint32_t
+{
+	STAPLE_VERTEX_INDEX_POSITION,
+	STAPLE_VERTEX_INDEX_NORMAL,
+	STAPLE_VERTEX_INDEX_TANGENT,
+	STAPLE_VERTEX_INDEX_BITANGENT,
+	STAPLE_VERTEX_INDEX_COLOR0,
+	STAPLE_VERTEX_INDEX_TEXCOORD0 = STAPLE_VERTEX_INDEX_COLOR0 + 4,
+	STAPLE_VERTEX_INDEX_BLEND_INDICES = STAPLE_VERTEX_INDEX_TEXCOORD0 + 8,
+	STAPLE_VERTEX_INDEX_BLEND_WEIGHTS,
+
+	//Influences 5 to 8, only used when importing 8 bone influences
+	STAPLE_VERTEX_INDEX_BLEND_INDICES1,
+	STAPLE_VERTEX_INDEX_BLEND_WEIGHTS1,
+
+	STAPLE_VERTEX_ATTRIBUTE_COUNT,
+};
+
+//Mask of vertex channels, used to select which ones are imported
+enum VertexAttributes : uint32_t
+{
+	STAPLE_VERTEX_ATTRIBUTE_POSITION = (1 << STAPLE_VERTEX_INDEX_POSITION),
+	STAPLE_VERTEX_ATTRIBUTE_NORMAL = (1 << STAPLE_VERTEX_INDEX_NORMAL),
+	STAPLE_VERTEX_ATTRIBUTE_TANGENT = (1 << STAPLE_VERTEX_INDEX_TANGENT),
+	STAPLE_VERTEX_ATTRIBUTE_BITANGENT = (1 << STAPLE_VERTEX_INDEX_BITANGENT),
+	STAPLE_VERTEX_ATTRIBUTE_COLOR0 = (1 << STAPLE_VERTEX_INDEX_COLOR0),
+	STAPLE_VERTEX_ATTRIBUTE_COLOR1 = (1 << (STAPLE_VERTEX_INDEX_COLOR0 + 1)),
+	STAPLE_VERTEX_ATTRIBUTE_COLOR2 = (1 << (STAPLE_VERTEX_INDEX_COLOR0 + 2)),
+	STAPLE_VERTEX_ATTRIBUTE_COLOR3 = (1 << (STAPLE_VERTEX_INDEX_COLOR0 + 3)),
+	STAPLE_VERTEX_ATTRIBUTE_TEXCOORD0 = (1 << STAPLE_VERTEX_INDEX_TEXCOORD0),
+	STAPLE_VERTEX_ATTRIBUTE_TEXCOORD1 = (1 << (STAPLE_VERTEX_INDEX_TEXCOORD0 + 1)),
+	STAPLE_VERTEX_ATTRIBUTE_TEXCOORD2 = (1 << (STAPLE_VERTEX_INDEX_TEXCOORD0 + 2)),
+	STAPLE_VERTEX_ATTRIBUTE_TEXCOORD3 = (1 << (STAPLE_VERTEX_INDEX_TEXCOORD0 + 3)),
+	STAPLE_VERTEX_ATTRIBUTE_TEXCOORD4 = (1 << (STAPLE_VERTEX_INDEX_TEXCOORD0 + 4)),
+	STAPLE_VERTEX_ATTRIBUTE_TEXCOORD5 = (1 << (STAPLE_VERTEX_INDEX_TEXCOORD0 + 5)),
+	STAPLE_VERTEX_ATTRIBUTE_TEXCOORD6 = (1 << (STAPLE_VERTEX_INDEX_TEXCOORD0 + 6)),
+	STAPLE_VERTEX_ATTRIBUTE_TEXCOORD7 = (1 << (STAPLE_VERTEX_INDEX_TEXCOORD0 + 7)),
+	STAPLE_VERTEX_ATTRIBUTE_BLEND_INDICES = (1 << STAPLE_VERTEX_INDEX_BLEND_INDICES),
+	STAPLE_VERTEX_ATTRIBUTE_BLEND_WEIGHTS = (1 << STAPLE_VERTEX_INDEX_BLEND_WEIGHTS),
+	STAPLE_VERTEX_ATTRIBUTE_BLEND_INDICES1 = (1 << STAPLE_VERTEX_INDEX_BLEND_INDICES1),
+	STAPLE_VERTEX_ATTRIBUTE_BLEND_WEIGHTS1 = (1 << STAPLE_VERTEX_INDEX_BLEND_WEIGHTS1),
+
+	STAPLE_VERTEX_ATTRIBUTE_SKIN = STAPLE_VERTEX_ATTRIBUTE_BLEND_INDICES | STAPLE_VERTEX_ATTRIBUTE_BLEND_WEIGHTS |
+		STAPLE_VERTEX_ATTRIBUTE_BLEND_INDICES1 | STAPLE_VERTEX_ATTRIBUTE_BLEND_WEIGHTS1,
+
+	STAPLE_VERTEX_ATTRIBUTE_ALL = (1 << STAPLE_VERTEX_ATTRIBUTE_COUNT) - 1,
+};
+
+enum ImportStage : int32_t
+{
+	//Parsing the file, counted in bytes
+	STAPLE_IMPORT_STAGE_PARSE,
+
+	//Building the vertices of each mesh, counted in triangles
+	STAPLE_IMPORT_STAGE_MESHES,
+
+	//Deduplicating vertices, counted in triangle corners
+	STAPLE_IMPORT_STAGE_INDICES,
+
+	//Baking animation stacks, counted in stacks
+	STAPLE_IMPORT_STAGE_ANIMATIONS,
+
+	STAPLE_IMPORT_STAGE_COUNT,
+};
+
+//Counters of every stage at the time of a progress report.
+//Totals are known once a stage starts, the parse total is 0 for streams of unknown size.
+class ImportProgress
+{
+public:
+	//The stage that is being worked on
+	int32_t stage;
+
+	uint64_t done[STAPLE_IMPORT_STAGE_COUNT];
+	uint64_t total[STAPLE_IMPORT_STAGE_COUNT];
+};
+
+enum TangentGeneration : int32_t
+{
+	//Tangents and bitangents are only imported
+	STAPLE_TANGENT_GENERATION_IMPORT,
+
+	//Generated for meshes that don't have any
+	STAPLE_TANGENT_GENERATION_MISSING,
+
+	//Always generated, replacing the imported ones
+	STAPLE_TANGENT_GENERATION_ALWAYS,
+};
+
+//Called periodically during an import, from any thread but never concurrently. Return false to cancel the import.
+typedef bool (*ImportProgressCallback)(void* user, const ImportProgress* progress);
+
+class SceneLoadOptions
+{
+public:
+	//0 uses every thread of the shared pool, 1 disables threading
+	int32_t threadCount;
+
+	//VertexAttributes to import, 0 imports everything
+	uint32_t attributes;
+
+	//Whether meshes are emitted as a single interleaved buffer instead of one array per attribute
+	bool interleaved;
+
+	//Amount of bone influences kept per vertex, the strongest ones are picked. Either 4 or 8, 0 uses 4.
+	int32_t maxBoneInfluences;
+
+	//Whether skinned meshes are emitted with compact skin data (8 or 16 bit bone indices, unorm16 weights)
+	//instead of the float blend attributes
+	bool compactSkin;
+
+	//Optional, reports progress and allows cancelling. A cancelled import returns no scene.
+	ImportProgressCallback progressCallback;
+
+	void* progressUser;
+
+	//Animation baking, 0 uses the ufbx default of each setting
+
+	//Samples per second used to resample non-linear animation. Defaults to 30.
+	double animationSampleRate;
+
+	//Keyframes at or above this rate aren't resampled. Defaults to 19.5.
+	double animationMinimumSampleRate;
+
+	//Keys closer together than this rate are removed. Unlimited by default.
+	double animationMaximumSampleRate;
+
+	//Whether to remove keys that can be interpolated from their neighbours
+	bool animationKeyReduction;
+
+	//Maximum error of a removed key. Defaults to 0.000001.
+	double animationKeyReductionThreshold;
+
+	//Maximum amount of keys generated from a single keyframe. Defaults to 32.
+	int32_t animationMaxKeyframeSegments;
+
+	//Whether to reverse the winding order of every triangle
+	bool flipWindingOrder;
+
+	//Whether to reorder triangles for the vertex cache and overdraw, and vertices in the order they're used
+	bool optimizeMeshes;
+
+	//Whether to split meshes into meshlets for GPU culling. Triangles are grouped by position and facing so the meshlet bounds stay tight.
+	bool buildMeshlets;
+
+	//Limits of each meshlet, 0 uses 64 vertices and 124 triangles. At most 256 vertices and 512 triangles,
+	//the triangle limit is rounded down to a multiple of 4.
+	int32_t meshletMaxVertices;
+	int32_t meshletMaxTriangles;
+
+	//Whether meshes are emitted with quantized attributes instead of floats, see Mesh::quantizedPositions.
+	//Implies compactSkin for skinned meshes.
+	bool quantize;
+
+	//Which meshes get generated MikkTSpace tangents and bitangents, computed from their normals and first UV set.
+	//Only applies when tangents or bitangents are requested in `attributes`.
+	TangentGeneration tangentGeneration;
+
+	SceneLoadOptions() : threadCount(0), attributes(STAPLE_VERTEX_ATTRIBUTE_ALL), interleaved(false),
+		maxBoneInfluences(4), compactSkin(false), progressCallback(nullptr), progressUser(nullptr),
+		animationSampleRate(0), animationMinimumSampleRate(0), animationMaximumSampleRate(0),
+		animationKeyReduction(false), animationKeyReductionThreshold(0), animationMaxKeyframeSegments(0),
+		flipWindingOrder(false), optimizeMeshes(false), buildMeshlets(false), meshletMaxVertices(0), meshletMaxTriangles(0),
+		quantize(false), tangentGeneration(STAPLE_TANGENT_GENERATION_IMPORT)
+	{
+	}
+};
+
+//Accumulates the counters of an import and forwards them to the progress callback.
+//Counters are updated from the mesh jobs, reports are serialized so the callback doesn't have to be thread safe.
+class ImportProgressTracker
+{
+public:
+	ImportProgressTracker(const SceneLoadOptions& options) : callback(options.progressCallback), user(options.progressUser),
+		cancelled(false)
 	{
-		memset(data, 0, sizeof(data));
+		for (int32_t i = 0; i < STAPLE_IMPORT_STAGE_COUNT; i++)
+		{
+			done[i] = 0;
+			total[i] = 0;
+		}
 	}
 
-	String(const char* ptr)
+	ImportProgressTracker(const ImportProgressTracker&) = delete;
+	ImportProgressTracker& operator=(const ImportProgressTracker&) = delete;
+
+	void SetTotal(ImportStage stage, uint64_t value)
 	{
-		this->length = (int32_t)strlen(ptr);
+		total[stage] = value;
+	}
 
-		memset(data, 0, sizeof(data));
-		memcpy(data, ptr, this->length);
+	void Set(ImportStage stage, uint64_t value, uint64_t totalValue)
+	{
+		done[stage].store(value);
+		total[stage] = totalValue;
 	}
 
-	String(const char* ptr, size_t length)
+	//Marks a stage as finished. Returns false if the import was cancelled.
+	bool Complete(ImportStage stage)
 	{
-		this->length = length > 10240 ? 1024 : (int32_t)length;
+		done[stage].store(total[stage]);
 
-		memset(data, 0, sizeof(data));
-		memcpy(data, ptr, this->length);
+		return Report(stage);
 	}
 
-	String(const String& o) : length(o.length)
+	//Returns false if the import was cancelled
+	bool Add(ImportStage stage, uint64_t amount)
 	{
-		memcpy(data, o.data, sizeof(data));
+		done[stage].fetch_add(amount);
+
+		return Report(stage);
 	}
 
-	String& operator=(const String& o)
+	//Returns false if the import was cancelled
+	bool Report(ImportStage stage)
 	{
-		length = o.length;
+		if (callback == nullptr || cancelled.load())
+		{
+			return cancelled.load() == false;
+		}
 
-		memcpy(data, o.data, sizeof(data));
+		std::unique_lock<std::mutex> lock(mutex);
 
-		return *this;
+		ImportProgress progress;
+
+		progress.stage = stage;
+
+		for (int32_t i = 0; i < STAPLE_IMPORT_STAGE_COUNT; i++)
+		{
+			progress.done[i] = done[i].load();
+			progress.total[i] = total[i];
+		}
+
+		if (callback(user, &progress) == false)
+		{
+			cancelled.store(true);
+		}
+
+		return cancelled.load() == false;
+	}
+
+	bool Cancelled() const
+	{
+		return cancelled.load();
 	}
+
+private:
+	ImportProgressCallback callback;
+	void* user;
+	std::atomic<uint64_t> done[STAPLE_IMPORT_STAGE_COUNT];
+	uint64_t total[STAPLE_IMPORT_STAGE_COUNT];
+	std::atomic<bool> cancelled;
+	std::mutex mutex;
 };
 
-class Vertex
+//Packed vertex with only the attributes that are imported, laid out as floats in VertexAttributes order
+class VertexLayout
 {
 public:
-	Vector3 position;
-	Vector3 normal;
-	Vector3 tangent;
-	Vector3 bitangent;
-	Vector2 uv0;
-	Vector2 uv1;
-	Vector2 uv2;
-	Vector2 uv3;
-	Vector2 uv4;
-	Vector2 uv5;
-	Vector2 uv6;
-	Vector2 uv7;
-	Vector4 color0;
-	Vector4 color1;
-	Vector4 color2;
-	Vector4 color3;
-	Vector4 boneIndices;
-	Vector4 boneWeights;
+	uint32_t attributes;
+	int32_t offsets[STAPLE_VERTEX_ATTRIBUTE_COUNT];
+	uint32_t stride;
+
+	VertexLayout() : attributes(0), stride(0)
+	{
+		for (uint32_t i = 0; i < STAPLE_VERTEX_ATTRIBUTE_COUNT; i++)
+		{
+			offsets[i] = -1;
+		}
+	}
+
+	void Add(uint32_t index, uint32_t componentCount)
+	{
+		attributes |= (1 << index);
+		offsets[index] = (int32_t)stride;
+
+		stride += componentCount;
+	}
+
+	bool Has(uint32_t index) const
+	{
+		return offsets[index] >= 0;
+	}
+
+	template<typename T>
+	void Write(float* vertex, uint32_t index, const T& value) const
+	{
+		memcpy(vertex + offsets[index], &value, sizeof(T));
+	}
+
+	void WriteArray(float* vertex, uint32_t index, const float* values, uint32_t count) const
+	{
+		memcpy(vertex + offsets[index], values, count * sizeof(float));
+	}
+
+	template<typename T>
+	T Read(const float* vertex, uint32_t index) const
+	{
+		T value;
+
+		memcpy((void*)&value, vertex + offsets[index], sizeof(T));
+
+		return value;
+	}
 };
 
 class MeshBone
@@ -165,6 +474,64 @@ public:
 	}
 };
 
+//Sparse morph target of a mesh. Only the vertices the shape moves are stored, as indices into the mesh's vertices.
+class BlendShape
+{
+public:
+	String name;
+
+	//Index of the blend channel that drives this shape, matches BlendShapeAnimation::channelIndex
+	int32_t channelIndex;
+
+	//Weight of the channel when it isn't animated, from 0 to 1
+	float weight;
+
+	//Sorted in increasing order
+	uint32_t* vertexIndices;
+
+	Vector3* positionDeltas;
+
+	//nullptr if the shape doesn't change normals or the mesh has none
+	Vector3* normalDeltas;
+
+	int32_t deltaCount;
+
+	BlendShape() : channelIndex(-1), weight(0), vertexIndices(nullptr), positionDeltas(nullptr), normalDeltas(nullptr),
+		deltaCount(0)
+	{
+	}
+};
+
+//Cluster of up to a few dozen triangles of a mesh, used to cull parts of a mesh on the GPU.
+//Uses `vertexCount` entries of the meshlet vertex list starting at `vertexOffset`, which are indices into the mesh's vertices,
+//and `triangleCount` * 3 entries of the meshlet triangle list starting at `triangleOffset`, which are indices into the meshlet's vertices.
+class Meshlet
+{
+public:
+	uint32_t vertexOffset;
+	uint32_t triangleOffset;
+	uint32_t vertexCount;
+	uint32_t triangleCount;
+
+	//Bounding sphere of the meshlet's vertices
+	float center[3];
+	float radius;
+
+	//Normal cone of the meshlet's triangles. Every triangle faces away from a camera at `position` when
+	//dot(normalize(coneApex - position), coneAxis) >= coneCutoff. Meshlets whose triangles face too many directions have a cutoff of 1.
+	float coneApex[3];
+	float coneAxis[3];
+	float coneCutoff;
+
+	Meshlet() : vertexOffset(0), triangleOffset(0), vertexCount(0), triangleCount(0), radius(0), coneCutoff(1)
+	{
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			center[i] = coneApex[i] = coneAxis[i] = 0;
+		}
+	}
+};
+
 class Mesh
 {
 public:
@@ -202,939 +569,3535 @@ public:
 
 	int32_t boneCount;
 
+	//VertexAttributes present in this mesh
+	uint32_t attributes;
+
+	//Set instead of the per attribute arrays when loading with SceneLoadOptions::interleaved.
+	//Contains only the attributes of `attributes`, as floats in VertexAttributes order.
+	float* interleavedVertices;
+
+	//Size of a vertex of `interleavedVertices` in bytes
+	int32_t vertexStride;
+
+	//Influences 5 to 8 when loading with 8 bone influences
+	Vector4* boneIndices1;
+	Vector4* boneWeights1;
+
+	//Set when loading with SceneLoadOptions::compactSkin, `skinInfluenceCount` entries per vertex.
+	//Indices are uint8_t if `skinIndexSize` is 1 or uint16_t if it's 2, weights are unorm16 and add up to 65535.
+	void* skinIndices;
+	uint16_t* skinWeights;
+	int32_t skinIndexSize;
+	int32_t skinInfluenceCount;
+
+	BlendShape* blendShapes;
+	int32_t blendShapeCount;
+
+	//Set when loading with SceneLoadOptions::buildMeshlets. `meshletVertices` indexes into the mesh's vertices,
+	//`meshletTriangles` has 3 entries per triangle that index into the vertices of their meshlet.
+	//Each meshlet's triangles start at a multiple of 4 entries, so there may be unused entries between meshlets.
+	Meshlet* meshlets;
+	int32_t meshletCount;
+	uint32_t* meshletVertices;
+	int32_t meshletVertexCount;
+	uint8_t* meshletTriangles;
+	int32_t meshletTriangleIndexCount;
+
+	//Set instead of the float attributes when loading with SceneLoadOptions::quantize, for the attributes of `attributes`.
+	//Positions are 4 snorm16 per vertex, relative to the mesh's bounds: position = positionOffset + xyz / 32767 * positionScale, w is 0.
+	//Normals, tangents and bitangents are 2 snorm16 per vertex, octahedral encoded. UVs are 2 half floats and colors 4 unorm8 per vertex.
+	int16_t* quantizedPositions;
+	int16_t* quantizedNormals;
+	int16_t* quantizedTangents;
+	int16_t* quantizedBitangents;
+	uint16_t* quantizedUV0;
+	uint16_t* quantizedUV1;
+	uint16_t* quantizedUV2;
+	uint16_t* quantizedUV3;
+	uint16_t* quantizedUV4;
+	uint16_t* quantizedUV5;
+	uint16_t* quantizedUV6;
+	uint16_t* quantizedUV7;
+	uint8_t* quantizedColor0;
+	uint8_t* quantizedColor1;
+	uint8_t* quantizedColor2;
+	uint8_t* quantizedColor3;
+	Vector3 positionOffset;
+	Vector3 positionScale;
+
+	//Whether the tangents and bitangents were generated, see SceneLoadOptions::tangentGeneration
+	bool generatedTangents;
+
+	//All arrays are owned by the scene's arena, so meshes can be moved around freely
 	Mesh() : vertices(nullptr), normals(nullptr), tangents(nullptr), bitangents(nullptr),
 		uv0(nullptr), uv1(nullptr), uv2(nullptr), uv3(nullptr),
 		uv4(nullptr), uv5(nullptr), uv6(nullptr), uv7(nullptr),
 		color0(nullptr), color1(nullptr), color2(nullptr), color3(nullptr),
 		boneIndices(nullptr), boneWeights(nullptr), vertexCount(0),
 		indices(nullptr), indexCount(0), materialIndex(-1), isSkinned(false),
-		bones(nullptr), boneCount(0) {
-	}
-
-	Mesh(const Mesh& o) : name(o.name), vertices(nullptr), normals(nullptr), tangents(nullptr), bitangents(nullptr),
-		uv0(nullptr), uv1(nullptr), uv2(nullptr), uv3(nullptr),
-		uv4(nullptr), uv5(nullptr), uv6(nullptr), uv7(nullptr),
-		color0(nullptr), color1(nullptr), color2(nullptr), color3(nullptr),
-		boneIndices(nullptr), boneWeights(nullptr), vertexCount(o.vertexCount),
-		indices(nullptr), indexCount(o.indexCount), materialIndex(o.materialIndex), isSkinned(o.isSkinned),
-		bones(nullptr), boneCount(o.boneCount)
-	{
-		COPY(vertices, o.vertices, Vector3, vertexCount);
-		COPY(normals, o.normals, Vector3, vertexCount);
-		COPY(tangents, o.tangents, Vector3, vertexCount);
-		COPY(bitangents, o.bitangents, Vector3, vertexCount);
-		COPY(uv0, o.uv0, Vector2, vertexCount);
-		COPY(uv1, o.uv1, Vector2, vertexCount);
-		COPY(uv2, o.uv2, Vector2, vertexCount);
-		COPY(uv3, o.uv3, Vector2, vertexCount);
-		COPY(uv4, o.uv4, Vector2, vertexCount);
-		COPY(uv5, o.uv5, Vector2, vertexCount);
-		COPY(uv6, o.uv6, Vector2, vertexCount);
-		COPY(uv7, o.uv7, Vector2, vertexCount);
-		COPY(color0, o.color0, Vector4, vertexCount);
-		COPY(color1, o.color1, Vector4, vertexCount);
-		COPY(color2, o.color2, Vector4, vertexCount);
-		COPY(color3, o.color3, Vector4, vertexCount);
-		COPY(boneIndices, o.boneIndices, Vector4, vertexCount);
-		COPY(boneWeights, o.boneWeights, Vector4, vertexCount);
-		COPY(bones, o.bones, MeshBone, boneCount);
-		COPY(indices, o.indices, uint32_t, indexCount);
-	}
-
-	~Mesh()
-	{
-		DELETE(vertices);
-		DELETE(normals);
-		DELETE(tangents);
-		DELETE(bitangents);
-		DELETE(uv0);
-		DELETE(uv1);
-		DELETE(uv2);
-		DELETE(uv3);
-		DELETE(uv4);
-		DELETE(uv5);
-		DELETE(uv6);
-		DELETE(uv7);
-		DELETE(color0);
-		DELETE(color1);
-		DELETE(color2);
-		DELETE(color3);
-		DELETE(indices);
-		DELETE(bones);
-	}
-
-	Mesh& operator=(const Mesh& o)
-	{
-		DELETE(vertices);
-		DELETE(normals);
-		DELETE(tangents);
-		DELETE(bitangents);
-		DELETE(uv0);
-		DELETE(uv1);
-		DELETE(uv2);
-		DELETE(uv3);
-		DELETE(uv4);
-		DELETE(uv5);
-		DELETE(uv6);
-		DELETE(uv7);
-		DELETE(color0);
-		DELETE(color1);
-		DELETE(color2);
-		DELETE(color3);
-		DELETE(indices);
-		DELETE(bones);
-
-		name = o.name;
-		vertexCount = o.vertexCount;
-		indexCount = o.indexCount;
-		boneCount = o.boneCount;
-		materialIndex = o.materialIndex;
-		isSkinned = o.isSkinned;
-
-		COPY(vertices, o.vertices, Vector3, vertexCount);
-		COPY(normals, o.normals, Vector3, vertexCount);
-		COPY(tangents, o.tangents, Vector3, vertexCount);
-		COPY(bitangents, o.bitangents, Vector3, vertexCount);
-		COPY(uv0, o.uv0, Vector2, vertexCount);
-		COPY(uv1, o.uv1, Vector2, vertexCount);
-		COPY(uv2, o.uv2, Vector2, vertexCount);
-		COPY(uv3, o.uv3, Vector2, vertexCount);
-		COPY(uv4, o.uv4, Vector2, vertexCount);
-		COPY(uv5, o.uv5, Vector2, vertexCount);
-		COPY(uv6, o.uv6, Vector2, vertexCount);
-		COPY(uv7, o.uv7, Vector2, vertexCount);
-		COPY(color0, o.color0, Vector4, vertexCount);
-		COPY(color1, o.color1, Vector4, vertexCount);
-		COPY(color2, o.color2, Vector4, vertexCount);
-		COPY(color3, o.color3, Vector4, vertexCount);
-		COPY(boneIndices, o.boneIndices, Vector4, vertexCount);
-		COPY(boneWeights, o.boneWeights, Vector4, vertexCount);
-		COPY(bones, o.bones, MeshBone, boneCount);
-		COPY(indices, o.indices, uint32_t, indexCount);
-
-		return *this;
+		bones(nullptr), boneCount(0), attributes(0), interleavedVertices(nullptr), vertexStride(0),
+		boneIndices1(nullptr), boneWeights1(nullptr), skinIndices(nullptr), skinWeights(nullptr), skinIndexSize(0), skinInfluenceCount(0),
+		blendShapes(nullptr), blendShapeCount(0), meshlets(nullptr), meshletCount(0), meshletVertices(nullptr), meshletVertexCount(0),
+		meshletTriangles(nullptr), meshletTriangleIndexCount(0), quantizedPositions(nullptr), quantizedNormals(nullptr),
+		quantizedTangents(nullptr), quantizedBitangents(nullptr), quantizedUV0(nullptr), quantizedUV1(nullptr), quantizedUV2(nullptr),
+		quantizedUV3(nullptr), quantizedUV4(nullptr), quantizedUV5(nullptr), quantizedUV6(nullptr), quantizedUV7(nullptr),
+		quantizedColor0(nullptr), quantizedColor1(nullptr), quantizedColor2(nullptr), quantizedColor3(nullptr), generatedTangents(false) {
 	}
 };
 
-class Node
+//Picks the strongest influences of each skinned vertex and gives every bone they use a slot in the mesh's bone list
+class SkinReader
 {
 public:
+	std::vector<MeshBone> bones;
 
-	int32_t parentIndex;
-
-	String name;
-
-	int32_t* meshIndices;
-
-	int32_t meshCount;
-
-	Matrix4x4 localTransform;
-
-	Node() : parentIndex(-1), meshIndices(nullptr), meshCount(0)
+	SkinReader(ufbx_skin_deformer* skin, uint32_t influenceCount) : skin(skin), influenceCount(influenceCount)
 	{
+		if (skin != nullptr)
+		{
+			clusterSlots.resize(skin->clusters.count, -1);
+		}
 	}
 
-	void ReadMesh(ufbx_node *node, ufbx_mesh* mesh, std::vector<Mesh>& meshCache)
+	//Writes `influenceCount` bone slots and normalized weights, sorted by decreasing weight. Unused influences are 0.
+	void Read(uint32_t vertexIndex, float* boneIndices, float* boneWeights)
 	{
-		std::vector<Mesh> meshes;
+		const ufbx_skin_vertex& skinVertex = skin->vertices[vertexIndex];
 
-		std::vector<int32_t> meshIndices;
+		uint32_t clusters[8];
+		float weights[8];
+		uint32_t count = 0;
 
-		for (size_t j = 0; j < mesh->material_parts.count; j++)
+		for (uint32_t l = 0; l < skinVertex.num_weights; l++)
 		{
-			const ufbx_mesh_part& part = mesh->material_parts[j];
+			const ufbx_skin_weight& weight = skin->weights[skinVertex.weight_begin + l];
 
-			if (part.num_triangles == 0)
+			float w = (float)weight.weight;
+
+			uint32_t position = count;
+
+			while (position > 0 && fabsf(w) > fabsf(weights[position - 1]))
+			{
+				position--;
+			}
+
+			if (position >= influenceCount)
 			{
 				continue;
 			}
 
-			Mesh ownMesh;
+			uint32_t last = count < influenceCount ? count : influenceCount - 1;
 
-			ownMesh.name = String(node->name.data, node->name.length);
-			ownMesh.isSkinned = mesh->skin_deformers.count > 0;
+			for (uint32_t m = last; m > position; m--)
+			{
+				clusters[m] = clusters[m - 1];
+				weights[m] = weights[m - 1];
+			}
 
-			ufbx_material* material = j < node->materials.count ? node->materials[j] : nullptr;
+			clusters[position] = weight.cluster_index;
+			weights[position] = w;
 
-			ufbx_skin_deformer* skin = mesh->skin_deformers.count > 0 ? mesh->skin_deformers[0] : nullptr;
+			if (count < influenceCount)
+			{
+				count++;
+			}
+		}
 
-			std::vector<Vertex> vertices;
+		float weightSum = 0.0f;
 
-			bool hasTangents = false;
-			bool hasBitangents = false;
-			bool hasColors[4] = { 0 };
-			bool hasUVs[8] = { 0 };
+		for (uint32_t l = 0; l < influenceCount; l++)
+		{
+			if (l < count)
+			{
+				boneIndices[l] = (float)BoneSlot(clusters[l]);
+				boneWeights[l] = weights[l];
 
-			std::vector<MeshBone> bones;
+				weightSum += weights[l];
+			}
+			else
+			{
+				boneIndices[l] = 0;
+				boneWeights[l] = 0;
+			}
+		}
 
-			for (size_t faceIndex = 0; faceIndex < part.num_faces; faceIndex++)
+		if (weightSum > 0)
+		{
+			for (uint32_t l = 0; l < count; l++)
 			{
-				const ufbx_face& face = mesh->faces[part.face_indices.data[faceIndex]];
+				boneWeights[l] /= weightSum;
+			}
+		}
+	}
 
-				size_t triangleIndexCount = mesh->max_face_triangles * 3;
+private:
+	uint32_t BoneSlot(uint32_t clusterIndex)
+	{
+		int32_t& slot = clusterSlots[clusterIndex];
 
-				std::vector<uint32_t> indices(triangleIndexCount);
+		if (slot >= 0)
+		{
+			return (uint32_t)slot;
+		}
 
-				size_t triangleCount = ufbx_triangulate_face(indices.data(), triangleIndexCount, mesh, face);
+		ufbx_skin_cluster* cluster = skin->clusters[clusterIndex];
 
-				size_t vertexCount = triangleCount * 3;
+		uint32_t nodeIndex = cluster->bone_node->typed_id;
 
-				for (size_t k = 0; k < vertexCount; k++)
-				{
-					uint32_t index = indices[k];
+		auto it = nodeSlots.find(nodeIndex);
 
-					Vertex v;
+		if (it != nodeSlots.end())
+		{
+			slot = it->second;
 
-					uint32_t vertexIndex = mesh->vertex_indices[index];
+			return (uint32_t)slot;
+		}
 
-					v.position = Vector3(mesh->vertices[vertexIndex]);
+		MeshBone bone;
 
-					{
-						uint32_t normalIndex = mesh->vertex_normal.indices[index];
+		bone.nodeIndex = nodeIndex;
+		bone.offsetMatrix = cluster->geometry_to_bone;
 
-						if (normalIndex < mesh->vertex_normal.values.count)
-						{
-							v.normal = Vector3(mesh->vertex_normal.values[normalIndex]);
-						}
-					}
+		slot = (int32_t)bones.size();
 
-					if (mesh->vertex_tangent.exists)
-					{
-						hasTangents = true;
+		bones.push_back(bone);
 
-						uint32_t tangentIndex = mesh->vertex_tangent.indices[index];
+		nodeSlots.emplace(nodeIndex, slot);
 
-						if (tangentIndex < mesh->vertex_tangent.values.count)
-						{
-							v.tangent = Vector3(mesh->vertex_tangent.values[tangentIndex]);
-						}
-					}
+		return (uint32_t)slot;
+	}
 
-					if (mesh->vertex_bitangent.exists)
-					{
-						hasBitangents = true;
+	ufbx_skin_deformer* skin;
+	uint32_t influenceCount;
 
-						uint32_t bitangentIndex = mesh->vertex_bitangent.indices[index];
+	//Bone slot of each skin cluster, resolved the first time a cluster is used
+	std::vector<int32_t> clusterSlots;
 
-						if (bitangentIndex < mesh->vertex_bitangent.values.count)
-						{
-							v.tangent = Vector3(mesh->vertex_bitangent.values[bitangentIndex]);
-						}
-					}
+	//Bone slot of each node typed_id, since several clusters may point to the same node
+	std::unordered_map<uint32_t, int32_t> nodeSlots;
+};
 
-					uint32_t uvCount = mesh->uv_sets.count < 8 ? (uint32_t)mesh->uv_sets.count : 8;
+//Converts the float skin attributes of deduplicated vertices to 8 or 16 bit bone indices and unorm16 weights
+static void WriteCompactSkin(Mesh& ownMesh, const VertexLayout& layout, const float* vertices, size_t vertexCount,
+	uint32_t influenceCount, Arena& arena)
+{
+	ownMesh.skinInfluenceCount = (int32_t)influenceCount;
+	ownMesh.skinIndexSize = ownMesh.boneCount <= 256 ? 1 : 2;
 
-					Vector2* uvs[8] =
-					{
-						&v.uv0,
-						&v.uv1,
-						&v.uv2,
-						&v.uv3,
-						&v.uv4,
-						&v.uv5,
-						&v.uv6,
-						&v.uv7,
-					};
-
-					hasUVs[0] = uvCount >= 1;
-					hasUVs[1] = uvCount >= 2;
-					hasUVs[2] = uvCount >= 3;
-					hasUVs[3] = uvCount >= 4;
-					hasUVs[4] = uvCount >= 5;
-					hasUVs[5] = uvCount >= 6;
-					hasUVs[6] = uvCount >= 7;
-					hasUVs[7] = uvCount >= 8;
-
-					for (uint32_t l = 0; l < uvCount; l++)
-					{
-						const ufbx_uv_set& UVSet = mesh->uv_sets[l];
+	uint8_t* indices8 = ownMesh.skinIndexSize == 1 ? arena.AllocateUninitialized<uint8_t>(vertexCount * influenceCount) : nullptr;
+	uint16_t* indices16 = ownMesh.skinIndexSize == 2 ? arena.AllocateUninitialized<uint16_t>(vertexCount * influenceCount) : nullptr;
+	uint16_t* weights = arena.AllocateUninitialized<uint16_t>(vertexCount * influenceCount);
 
-						uint32_t UVIndex = UVSet.vertex_uv.indices[index];
+	ownMesh.skinIndices = indices8 != nullptr ? (void*)indices8 : (void*)indices16;
+	ownMesh.skinWeights = weights;
 
-						if (UVIndex < UVSet.vertex_uv.values.count)
-						{
-							*uvs[l] = Vector2(UVSet.vertex_uv.values[UVIndex]);
-						}
-					}
+	for (size_t k = 0; k < vertexCount; k++)
+	{
+		const float* v = vertices + k * layout.stride;
 
-					Vector4* colors[4] = 
-					{
-						&v.color0,
-						&v.color1,
-						&v.color2,
-						&v.color3,
-					};
+		float boneIndices[8];
+		float boneWeights[8];
 
-					uint32_t colorCount = mesh->color_sets.count < 4 ? (uint32_t)mesh->color_sets.count : 4;
+		memcpy(boneIndices, v + layout.offsets[STAPLE_VERTEX_INDEX_BLEND_INDICES], 4 * sizeof(float));
+		memcpy(boneWeights, v + layout.offsets[STAPLE_VERTEX_INDEX_BLEND_WEIGHTS], 4 * sizeof(float));
 
-					hasColors[0] = colorCount >= 1;
-					hasColors[1] = colorCount >= 2;
-					hasColors[2] = colorCount >= 3;
-					hasColors[3] = colorCount >= 4;
+		if (influenceCount > 4)
+		{
+			memcpy(boneIndices + 4, v + layout.offsets[STAPLE_VERTEX_INDEX_BLEND_INDICES1], 4 * sizeof(float));
+			memcpy(boneWeights + 4, v + layout.offsets[STAPLE_VERTEX_INDEX_BLEND_WEIGHTS1], 4 * sizeof(float));
+		}
 
-					for (uint32_t l = 0; l < colorCount; l++)
-					{
-						const ufbx_color_set& colorSet = mesh->color_sets[l];
+		uint16_t* outWeights = weights + k * influenceCount;
 
-						uint32_t colorIndex = colorSet.vertex_color.indices[index];
+		int32_t total = 0;
 
-						if (colorIndex < colorSet.vertex_color.values.count)
-						{
-							*colors[l] = colorSet.vertex_color.values[colorIndex];
-						}
-					}
+		for (uint32_t l = 0; l < influenceCount; l++)
+		{
+			float w = boneWeights[l] < 0 ? 0 : (boneWeights[l] > 1 ? 1 : boneWeights[l]);
 
-					if (skin != nullptr)
-					{
-						const ufbx_skin_vertex& skinVertex = skin->vertices[vertexIndex];
+			outWeights[l] = (uint16_t)(w * 65535.0f + 0.5f);
 
-						uint32_t weightCount = skinVertex.num_weights <= 4 ? skinVertex.num_weights : 4;
+			total += outWeights[l];
 
-						float* boneIndices[4] =
-						{
-							&v.boneIndices.x,
-							&v.boneIndices.y,
-							&v.boneIndices.z,
-							&v.boneIndices.w,
-						};
+			if (indices8 != nullptr)
+			{
+				indices8[k * influenceCount + l] = (uint8_t)boneIndices[l];
+			}
+			else
+			{
+				indices16[k * influenceCount + l] = (uint16_t)boneIndices[l];
+			}
+		}
 
-						float* boneWeights[4] =
-						{
-							&v.boneWeights.x,
-							&v.boneWeights.y,
-							&v.boneWeights.z,
-							&v.boneWeights.w,
-						};
+		//Rounding error goes to the strongest influence so the weights still add up to exactly 1
+		if (total > 0 && total != 65535)
+		{
+			int32_t adjusted = outWeights[0] + 65535 - total;
 
-						float weightSum = 0.0f;
+			outWeights[0] = (uint16_t)(adjusted < 0 ? 0 : (adjusted > 65535 ? 65535 : adjusted));
+		}
+	}
+}
 
-						for (uint32_t l = 0; l < weightCount; l++)
-						{
-							const ufbx_skin_weight& weight = skin->weights[skinVertex.weight_begin + l];
+static int16_t QuantizeSnorm16(float value)
+{
+	value = value < -1 ? -1 : (value > 1 ? 1 : value);
 
-							uint32_t clusterIndex = weight.cluster_index;
+	return (int16_t)(value * 32767.0f + (value >= 0 ? 0.5f : -0.5f));
+}
 
-							ufbx_skin_cluster* cluster = skin->clusters[clusterIndex];
+static uint8_t QuantizeUnorm8(float value)
+{
+	value = value < 0 ? 0 : (value > 1 ? 1 : value);
 
-							uint32_t nodeIndex = cluster->bone_node->typed_id;
+	return (uint8_t)(value * 255.0f + 0.5f);
+}
 
-							uint32_t boneIndex = 0;
+//Rounds to the nearest half float, ties to even. Values past the half float range become infinity.
+static uint16_t FloatToHalf(float value)
+{
+	uint32_t bits;
 
-							bool found = false;
+	memcpy(&bits, &value, sizeof(bits));
 
-							for (size_t m = 0; m < bones.size(); m++)
-							{
-								if (bones[m].nodeIndex == nodeIndex)
-								{
-									found = true;
+	uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+	uint32_t magnitude = bits & 0x7FFFFFFF;
 
-									boneIndex = (uint32_t)m;
+	//Infinity and NaN, NaN keeps a mantissa bit so it doesn't turn into infinity
+	if (magnitude >= 0x7F800000)
+	{
+		return sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0);
+	}
 
-									break;
-								}
-							}
+	//65520 and up round to infinity
+	if (magnitude >= 0x477FF000)
+	{
+		return sign | 0x7C00;
+	}
 
-							if (found == false)
-							{
-								MeshBone bone;
+	//Below the smallest normal half float, the result is a multiple of 2^-24
+	if (magnitude < 0x38800000)
+	{
+		return sign | (uint16_t)nearbyintf(fabsf(value) * 16777216.0f);
+	}
 
-								bone.nodeIndex = nodeIndex;
-								bone.offsetMatrix = cluster->geometry_to_bone;
+	//Rebias the exponent from 127 to 15 and drop 13 mantissa bits
+	uint32_t half = (magnitude - 0x38000000) >> 13;
+	uint32_t remainder = magnitude & 0x1FFF;
 
-								boneIndex = (uint32_t)bones.size();
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0))
+	{
+		half++;
+	}
 
-								bones.push_back(bone);
-							}
+	return sign | (uint16_t)half;
+}
 
-							float jointIndex = (float)boneIndex;
-							float w = weight.weight;
+//Projects a direction onto an octahedron and unfolds it into a square, stored as 2 snorm16
+static void EncodeOctahedral(const Vector3& direction, int16_t* outValue)
+{
+	float length = fabsf(direction.x) + fabsf(direction.y) + fabsf(direction.z);
 
-							weightSum += w;
+	if (length <= 0)
+	{
+		outValue[0] = outValue[1] = 0;
 
-							*boneIndices[l] = jointIndex;
-							*boneWeights[l] = w;
-						}
+		return;
+	}
 
-						if (weightSum > 0)
-						{
-							v.boneWeights.x /= weightSum;
-							v.boneWeights.y /= weightSum;
-							v.boneWeights.z /= weightSum;
-							v.boneWeights.w /= weightSum;
-						}
-					}
+	float x = direction.x / length;
+	float y = direction.y / length;
 
-					vertices.push_back(v);
-				}
-			}
+	//The lower half is folded over the diagonals
+	if (direction.z < 0)
+	{
+		float foldedX = (1 - fabsf(y)) * (x >= 0 ? 1 : -1);
+		float foldedY = (1 - fabsf(x)) * (y >= 0 ? 1 : -1);
 
-			ufbx_vertex_stream vertexStream = { 0 };
+		x = foldedX;
+		y = foldedY;
+	}
 
-			vertexStream.data = vertices.data();
-			vertexStream.vertex_count = vertices.size();
-			vertexStream.vertex_size = sizeof(Vertex);
+	outValue[0] = QuantizeSnorm16(x);
+	outValue[1] = QuantizeSnorm16(y);
+}
 
-			std::vector<uint32_t> indices(vertices.size());
+static void WriteQuantizedVertices(Mesh& ownMesh, const VertexLayout& layout, const float* vertices, size_t vertexCount, Arena& arena)
+{
+	if (vertexCount == 0)
+	{
+		return;
+	}
 
-			ufbx_error indexError;
+	Vector3 minimum = layout.Read<Vector3>(vertices, STAPLE_VERTEX_INDEX_POSITION);
+	Vector3 maximum = minimum;
 
-			uint32_t vertexCount = (uint32_t)ufbx_generate_indices(&vertexStream, 1, indices.data(), vertices.size(), nullptr, &indexError);
+	for (size_t k = 1; k < vertexCount; k++)
+	{
+		Vector3 p = layout.Read<Vector3>(vertices + k * layout.stride, STAPLE_VERTEX_INDEX_POSITION);
 
-			if (indexError.type != UFBX_ERROR_NONE)
-			{
-				PrintError(&indexError, "Mesh index generation failed");
-			}
-			else
-			{
-				ownMesh.vertices = new Vector3[vertexCount];
-				ownMesh.normals = new Vector3[vertexCount];
-				ownMesh.tangents = hasTangents ? new Vector3[vertexCount] : nullptr;
-				ownMesh.bitangents = hasBitangents ? new Vector3[vertexCount] : nullptr;
-				ownMesh.color0 = hasColors[0] ? new Vector4[vertexCount] : nullptr;
-				ownMesh.color1 = hasColors[1] ? new Vector4[vertexCount] : nullptr;
-				ownMesh.color2 = hasColors[2] ? new Vector4[vertexCount] : nullptr;
-				ownMesh.color3 = hasColors[3] ? new Vector4[vertexCount] : nullptr;
-				ownMesh.uv0 = hasUVs[0] ? new Vector2[vertexCount] : nullptr;
-				ownMesh.uv1 = hasUVs[1] ? new Vector2[vertexCount] : nullptr;
-				ownMesh.uv2 = hasUVs[2] ? new Vector2[vertexCount] : nullptr;
-				ownMesh.uv3 = hasUVs[3] ? new Vector2[vertexCount] : nullptr;
-				ownMesh.uv4 = hasUVs[4] ? new Vector2[vertexCount] : nullptr;
-				ownMesh.uv5 = hasUVs[5] ? new Vector2[vertexCount] : nullptr;
-				ownMesh.uv6 = hasUVs[6] ? new Vector2[vertexCount] : nullptr;
-				ownMesh.uv7 = hasUVs[7] ? new Vector2[vertexCount] : nullptr;
-				ownMesh.boneIndices = skin != nullptr ? new Vector4[vertexCount] : nullptr;
-				ownMesh.boneWeights = skin != nullptr ? new Vector4[vertexCount] : nullptr;
-
-				ownMesh.vertexCount = vertexCount;
-				ownMesh.indexCount = (int32_t)indices.size();
-				ownMesh.materialIndex = material != nullptr ? material->typed_id : -1;
-
-				ownMesh.indices = new uint32_t[indices.size()];
-
-				memcpy(ownMesh.indices, indices.data(), indices.size() * sizeof(uint32_t));
-
-				if (bones.size() > 0)
-				{
-					ownMesh.boneCount = (int32_t)bones.size();
+		minimum = Vector3(p.x < minimum.x ? p.x : minimum.x, p.y < minimum.y ? p.y : minimum.y, p.z < minimum.z ? p.z : minimum.z);
+		maximum = Vector3(p.x > maximum.x ? p.x : maximum.x, p.y > maximum.y ? p.y : maximum.y, p.z > maximum.z ? p.z : maximum.z);
+	}
 
-					ownMesh.bones = new MeshBone[ownMesh.boneCount];
+	ownMesh.positionOffset = Vector3((minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f, (minimum.z + maximum.z) * 0.5f);
+	ownMesh.positionScale = Vector3((maximum.x - minimum.x) * 0.5f, (maximum.y - minimum.y) * 0.5f, (maximum.z - minimum.z) * 0.5f);
 
-					for (size_t k = 0; k < ownMesh.boneCount; k++)
-					{
-						ownMesh.bones[k] = bones[k];
-					}
-				}
+	//Flat axes quantize to 0
+	Vector3 inverseScale(ownMesh.positionScale.x > 0 ? 1 / ownMesh.positionScale.x : 0,
+		ownMesh.positionScale.y > 0 ? 1 / ownMesh.positionScale.y : 0,
+		ownMesh.positionScale.z > 0 ? 1 / ownMesh.positionScale.z : 0);
 
-				for (size_t k = 0; k < vertexCount; k++)
-				{
-					const Vertex& v = vertices[k];
+	int16_t* positions = arena.AllocateUninitialized<int16_t>(vertexCount * 4);
 
-					ownMesh.vertices[k] = v.position;
-					ownMesh.normals[k] = v.normal;
+	ownMesh.quantizedPositions = positions;
 
-#define COPYIF(condition, to, from)\
-	if(condition)\
-	{\
-		to[k] = from;\
-	}
-
-					COPYIF(hasTangents, ownMesh.tangents, v.tangent);
-					COPYIF(hasBitangents, ownMesh.bitangents, v.bitangent);
-					COPYIF(hasColors[0], ownMesh.color0, v.color0);
-					COPYIF(hasColors[1], ownMesh.color1, v.color1);
-					COPYIF(hasColors[2], ownMesh.color2, v.color2);
-					COPYIF(hasColors[3], ownMesh.color3, v.color3);
-					COPYIF(hasUVs[0], ownMesh.uv0, v.uv0);
-					COPYIF(hasUVs[1], ownMesh.uv1, v.uv1);
-					COPYIF(hasUVs[2], ownMesh.uv2, v.uv2);
-					COPYIF(hasUVs[3], ownMesh.uv3, v.uv3);
-					COPYIF(hasUVs[4], ownMesh.uv4, v.uv4);
-					COPYIF(hasUVs[5], ownMesh.uv5, v.uv5);
-					COPYIF(hasUVs[6], ownMesh.uv6, v.uv6);
-					COPYIF(hasUVs[7], ownMesh.uv7, v.uv7);
-					COPYIF(skin != nullptr, ownMesh.boneIndices, v.boneIndices);
-					COPYIF(skin != nullptr, ownMesh.boneWeights, v.boneWeights);
-#undef COPYIF
-				}
+	for (size_t k = 0; k < vertexCount; k++)
+	{
+		Vector3 p = layout.Read<Vector3>(vertices + k * layout.stride, STAPLE_VERTEX_INDEX_POSITION);
 
-				meshIndices.push_back((int32_t)meshCache.size());
+		positions[k * 4] = QuantizeSnorm16((p.x - ownMesh.positionOffset.x) * inverseScale.x);
+		positions[k * 4 + 1] = QuantizeSnorm16((p.y - ownMesh.positionOffset.y) * inverseScale.y);
+		positions[k * 4 + 2] = QuantizeSnorm16((p.z - ownMesh.positionOffset.z) * inverseScale.z);
+		positions[k * 4 + 3] = 0;
+	}
 
-				meshCache.push_back(ownMesh);
-			}
-		}
+	int16_t** directions[] = { &ownMesh.quantizedNormals, &ownMesh.quantizedTangents, &ownMesh.quantizedBitangents };
+
+	for (uint32_t l = 0; l < 3; l++)
+	{
+		uint32_t attribute = STAPLE_VERTEX_INDEX_NORMAL + l;
 
-		if (meshIndices.size() > 0)
+		if (layout.Has(attribute) == false)
 		{
-			this->meshCount = (int32_t)meshIndices.size();
-			this->meshIndices = new int32_t[meshIndices.size()];
+			continue;
+		}
 
-			memcpy(this->meshIndices, meshIndices.data(), meshIndices.size() * sizeof(int32_t));
+		int16_t* outValue = arena.AllocateUninitialized<int16_t>(vertexCount * 2);
+
+		*directions[l] = outValue;
+
+		for (size_t k = 0; k < vertexCount; k++)
+		{
+			EncodeOctahedral(layout.Read<Vector3>(vertices + k * layout.stride, attribute), outValue + k * 2);
 		}
 	}
 
-	void Read(ufbx_scene *scene, ufbx_node* node, std::vector<Mesh> &meshCache)
+	uint16_t** UVs[] = { &ownMesh.quantizedUV0, &ownMesh.quantizedUV1, &ownMesh.quantizedUV2, &ownMesh.quantizedUV3,
+		&ownMesh.quantizedUV4, &ownMesh.quantizedUV5, &ownMesh.quantizedUV6, &ownMesh.quantizedUV7 };
+
+	for (uint32_t l = 0; l < 8; l++)
 	{
-		if (node->name.length == 0)
+		uint32_t attribute = STAPLE_VERTEX_INDEX_TEXCOORD0 + l;
+
+		if (layout.Has(attribute) == false)
 		{
-			if (node->is_root)
-			{
-				name = String("internal_root");
-			}
-			else
-			{
-				name = String("internal_group");
-			}
+			continue;
 		}
-		else
+
+		uint16_t* outValue = arena.AllocateUninitialized<uint16_t>(vertexCount * 2);
+
+		*UVs[l] = outValue;
+
+		for (size_t k = 0; k < vertexCount; k++)
 		{
-			name = String(node->name.data, node->name.length);
+			const float* uv = vertices + k * layout.stride + layout.offsets[attribute];
+
+			outValue[k * 2] = FloatToHalf(uv[0]);
+			outValue[k * 2 + 1] = FloatToHalf(uv[1]);
 		}
+	}
 
-		parentIndex = node->parent ? node->parent->typed_id : -1;
+	uint8_t** colors[] = { &ownMesh.quantizedColor0, &ownMesh.quantizedColor1, &ownMesh.quantizedColor2, &ownMesh.quantizedColor3 };
 
-		localTransform = node->node_to_parent;
+	for (uint32_t l = 0; l < 4; l++)
+	{
+		uint32_t attribute = STAPLE_VERTEX_INDEX_COLOR0 + l;
+
+		if (layout.Has(attribute) == false)
+		{
+			continue;
+		}
 
-		if (node->mesh != nullptr)
+		uint8_t* outValue = arena.AllocateUninitialized<uint8_t>(vertexCount * 4);
+
+		*colors[l] = outValue;
+
+		for (size_t k = 0; k < vertexCount; k++)
 		{
-			ReadMesh(node, node->mesh, meshCache);
+			const float* color = vertices + k * layout.stride + layout.offsets[attribute];
+
+			for (uint32_t m = 0; m < 4; m++)
+			{
+				outValue[k * 4 + m] = QuantizeUnorm8(color[m]);
+			}
 		}
 	}
-};
+}
 
-enum TextureWrap : int
+//Corners of a mesh part as MikkTSpace sees them. They're still a plain triangle list, 3 corners per face.
+struct TangentSpaceMesh
 {
-	STAPLE_TEXTURE_WRAP_REPEAT,
-	STAPLE_TEXTURE_WRAP_CLAMP,
-	STAPLE_TEXTURE_WRAP_MIRROR,
+	float* vertices;
+	const VertexLayout* layout;
+	size_t triangleCount;
 };
 
-static TextureWrap UFBXWrapToStapleWrap(ufbx_wrap_mode mode)
+static const float* TangentSpaceAttribute(const SMikkTSpaceContext* context, int face, int vertex, uint32_t attribute)
 {
-	switch (mode)
-	{
-	case UFBX_WRAP_CLAMP:
+	const TangentSpaceMesh* mesh = (const TangentSpaceMesh*)context->m_pUserData;
 
-		return STAPLE_TEXTURE_WRAP_CLAMP;
+	return mesh->vertices + ((size_t)face * 3 + vertex) * mesh->layout->stride + mesh->layout->offsets[attribute];
+}
 
-	case UFBX_WRAP_REPEAT:
+static int TangentSpaceFaceCount(const SMikkTSpaceContext* context)
+{
+	return (int)((const TangentSpaceMesh*)context->m_pUserData)->triangleCount;
+}
 
-		return STAPLE_TEXTURE_WRAP_REPEAT;
+static int TangentSpaceFaceVertexCount(const SMikkTSpaceContext* context, const int face)
+{
+	return 3;
+}
 
-	default:
+static void TangentSpacePosition(const SMikkTSpaceContext* context, float position[], const int face, const int vertex)
+{
+	memcpy(position, TangentSpaceAttribute(context, face, vertex, STAPLE_VERTEX_INDEX_POSITION), 3 * sizeof(float));
+}
 
-		return STAPLE_TEXTURE_WRAP_CLAMP;
+static void TangentSpaceNormal(const SMikkTSpaceContext* context, float normal[], const int face, const int vertex)
+{
+	memcpy(normal, TangentSpaceAttribute(context, face, vertex, STAPLE_VERTEX_INDEX_NORMAL), 3 * sizeof(float));
+}
+
+static void TangentSpaceTexCoord(const SMikkTSpaceContext* context, float uv[], const int face, const int vertex)
+{
+	memcpy(uv, TangentSpaceAttribute(context, face, vertex, STAPLE_VERTEX_INDEX_TEXCOORD0), 2 * sizeof(float));
+}
+
+//The bitangent is rebuilt from the normal and the sign the same way shaders reading MikkTSpace tangents do
+static void TangentSpaceWrite(const SMikkTSpaceContext* context, const float tangent[], const float sign, const int face, const int vertex)
+{
+	const TangentSpaceMesh* mesh = (const TangentSpaceMesh*)context->m_pUserData;
+	const VertexLayout& layout = *mesh->layout;
+
+	float* v = mesh->vertices + ((size_t)face * 3 + vertex) * layout.stride;
+
+	if (layout.Has(STAPLE_VERTEX_INDEX_TANGENT))
+	{
+		layout.WriteArray(v, STAPLE_VERTEX_INDEX_TANGENT, tangent, 3);
+	}
+
+	if (layout.Has(STAPLE_VERTEX_INDEX_BITANGENT))
+	{
+		const float* normal = v + layout.offsets[STAPLE_VERTEX_INDEX_NORMAL];
+
+		float bitangent[3] =
+		{
+			(normal[1] * tangent[2] - normal[2] * tangent[1]) * sign,
+			(normal[2] * tangent[0] - normal[0] * tangent[2]) * sign,
+			(normal[0] * tangent[1] - normal[1] * tangent[0]) * sign,
+		};
+
+		layout.WriteArray(v, STAPLE_VERTEX_INDEX_BITANGENT, bitangent, 3);
 	}
 }
 
-class Material
+//Fills in the tangents and bitangents of a mesh part with the reference MikkTSpace implementation,
+//so they match the ones normal maps are baked with
+static bool GenerateTangents(float* vertices, const VertexLayout& layout, size_t cornerCount)
 {
-public:
+	TangentSpaceMesh mesh;
 
-	String name;
+	mesh.vertices = vertices;
+	mesh.layout = &layout;
+	mesh.triangleCount = cornerCount / 3;
 
-#define MATERIALPROP(name) \
-	Vector4 name ## Color;\
-	String name ## Texture;\
-	TextureWrap name ## WrapU; \
-	TextureWrap name ## WrapV;
+	SMikkTSpaceInterface callbacks;
 
-	MATERIALPROP(diffuse);
-	MATERIALPROP(specular);
-	MATERIALPROP(reflection);
-	MATERIALPROP(transparency);
-	MATERIALPROP(emission);
-	MATERIALPROP(ambient);
-	MATERIALPROP(normalMap);
-	MATERIALPROP(bump);
-	MATERIALPROP(displacement);
-	MATERIALPROP(vectorDisplacement);
+	memset(&callbacks, 0, sizeof(callbacks));
 
-#undef MATERIALPROP
+	callbacks.m_getNumFaces = TangentSpaceFaceCount;
+	callbacks.m_getNumVerticesOfFace = TangentSpaceFaceVertexCount;
+	callbacks.m_getPosition = TangentSpacePosition;
+	callbacks.m_getNormal = TangentSpaceNormal;
+	callbacks.m_getTexCoord = TangentSpaceTexCoord;
+	callbacks.m_setTSpaceBasic = TangentSpaceWrite;
+
+	SMikkTSpaceContext context;
+
+	context.m_pInterface = &callbacks;
+	context.m_pUserData = &mesh;
 
-	Material() : diffuseWrapU(STAPLE_TEXTURE_WRAP_CLAMP), diffuseWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		specularWrapU(STAPLE_TEXTURE_WRAP_CLAMP), specularWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		reflectionWrapU(STAPLE_TEXTURE_WRAP_CLAMP), reflectionWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		transparencyWrapU(STAPLE_TEXTURE_WRAP_CLAMP), transparencyWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		emissionWrapU(STAPLE_TEXTURE_WRAP_CLAMP), emissionWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		ambientWrapU(STAPLE_TEXTURE_WRAP_CLAMP), ambientWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		normalMapWrapU(STAPLE_TEXTURE_WRAP_CLAMP), normalMapWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		bumpWrapU(STAPLE_TEXTURE_WRAP_CLAMP), bumpWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		displacementWrapU(STAPLE_TEXTURE_WRAP_CLAMP), displacementWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		vectorDisplacementWrapU(STAPLE_TEXTURE_WRAP_CLAMP), vectorDisplacementWrapV(STAPLE_TEXTURE_WRAP_CLAMP)
+	if (genTangSpaceDefault(&context) == 0)
 	{
+		printf("ERROR: Tangent generation failed\n");
+
+		return false;
 	}
 
-	Material(const Material& o) : name(o.name),
-		diffuseTexture(o.diffuseTexture), diffuseWrapU(STAPLE_TEXTURE_WRAP_CLAMP), diffuseWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		specularTexture(o.specularTexture), specularWrapU(STAPLE_TEXTURE_WRAP_CLAMP), specularWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		reflectionTexture(o.reflectionTexture), reflectionWrapU(STAPLE_TEXTURE_WRAP_CLAMP), reflectionWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		transparencyTexture(o.transparencyTexture), transparencyWrapU(STAPLE_TEXTURE_WRAP_CLAMP), transparencyWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		emissionTexture(o.emissionTexture), emissionWrapU(STAPLE_TEXTURE_WRAP_CLAMP), emissionWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		ambientTexture(o.ambientTexture), ambientWrapU(STAPLE_TEXTURE_WRAP_CLAMP), ambientWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		normalMapTexture(o.normalMapTexture), normalMapWrapU(STAPLE_TEXTURE_WRAP_CLAMP), normalMapWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		bumpTexture(o.bumpTexture), bumpWrapU(STAPLE_TEXTURE_WRAP_CLAMP), bumpWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		displacementTexture(o.displacementTexture), displacementWrapU(STAPLE_TEXTURE_WRAP_CLAMP), displacementWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
-		vectorDisplacementTexture(o.vectorDisplacementTexture), vectorDisplacementWrapU(STAPLE_TEXTURE_WRAP_CLAMP),
-		vectorDisplacementWrapV(STAPLE_TEXTURE_WRAP_CLAMP)
+	return true;
+}
+
+static bool HasBlendShapes(ufbx_mesh* mesh)
+{
+	for (size_t i = 0; i < mesh->blend_deformers.count; i++)
 	{
+		for (size_t j = 0; j < mesh->blend_deformers[i]->channels.count; j++)
+		{
+			ufbx_blend_shape* shape = mesh->blend_deformers[i]->channels[j]->target_shape;
+
+			if (shape != nullptr && shape->num_offsets > 0)
+			{
+				return true;
+			}
+		}
 	}
 
-	void Read(ufbx_material* material)
+	return false;
+}
+
+//Remaps the offsets of every blend channel of `mesh` to the deduplicated vertices of a mesh part.
+//`vertexSources` holds the ufbx vertex each deduplicated vertex was built from.
+//Only the full weight shape of each channel is used, in-between shapes are skipped.
+//Names are left empty, Scene::ReadMeshes adds them in node order once every part is read.
+static void ReadBlendShapes(ufbx_mesh* mesh, const uint32_t* vertexSources, size_t vertexCount, bool hasNormals, Mesh& ownMesh,
+	Arena& arena)
+{
+	size_t shapeCount = 0;
+
+	for (size_t i = 0; i < mesh->blend_deformers.count; i++)
 	{
-		if (material->name.length > 0)
+		shapeCount += mesh->blend_deformers[i]->channels.count;
+	}
+
+	ownMesh.blendShapes = arena.AllocateArray<BlendShape>(shapeCount);
+
+	//Offset of each ufbx vertex in the current shape, reset after every shape so it's only filled once
+	std::vector<int32_t> offsetIndices(mesh->num_vertices, -1);
+
+	for (size_t i = 0; i < mesh->blend_deformers.count; i++)
+	{
+		ufbx_blend_deformer* deformer = mesh->blend_deformers[i];
+
+		for (size_t j = 0; j < deformer->channels.count; j++)
 		{
-			name = String(material->name.data, material->name.length);
-		}
+			ufbx_blend_channel* channel = deformer->channels[j];
+			ufbx_blend_shape* shape = channel->target_shape;
 
-#define MATERIALCOLOR(to, map)\
-		if (material->fbx.maps[map].has_value && material->fbx.maps[map].value_components > 0)\
-		{\
-			to ## Color = material->fbx.maps[map].value_vec4;\
-		}\
-		else\
-		{\
-			to ## Color = Vector4(1, 1, 1, 1);\
-		}
+			if (shape == nullptr)
+			{
+				continue;
+			}
 
-#define MATERIALTEXTURE(to, map)\
-		if (material->fbx.maps[map].has_value && material->fbx.maps[map].texture != nullptr)\
-		{\
-			ufbx_texture *texture = material->fbx.maps[map].texture; \
-			const ufbx_string &fileName = texture->filename; \
-			\
-			if(fileName.length > 0)\
-			{\
-				to ## Texture = String(fileName.data, fileName.length); \
-			}\
-			\
-			to ## WrapU = UFBXWrapToStapleWrap(texture->wrap_u); \
-			to ## WrapV = UFBXWrapToStapleWrap(texture->wrap_v); \
-		}
+			bool hasNormalOffsets = hasNormals && shape->normal_offsets.count == shape->num_offsets;
 
-#define MATERIALPBRCOLOR(to, map)\
-		if (material->pbr.maps[map].has_value && material->pbr.maps[map].value_components > 0)\
-		{\
-			to ## Color = material->pbr.maps[map].value_vec4; \
-		}\
-		else\
-		{\
-			to ## Color = Vector4(1, 1, 1, 1);\
-		}
+			for (size_t k = 0; k < shape->num_offsets; k++)
+			{
+				uint32_t vertex = shape->offset_vertices[k];
 
-#define MATERIALPBRTEXTURE(to, map)\
-		if (material->pbr.maps[map].has_value && material->pbr.maps[map].texture != nullptr)\
-		{\
-			ufbx_texture *texture = material->pbr.maps[map].texture; \
-			const ufbx_string &fileName = texture->filename; \
-			\
-			if(fileName.length > 0)\
-			{\
-				to ## Texture = String(fileName.data, fileName.length); \
-			}\
-			\
-			to ## WrapU = UFBXWrapToStapleWrap(texture->wrap_u); \
-			to ## WrapV = UFBXWrapToStapleWrap(texture->wrap_v); \
-		}
+				if (vertex < offsetIndices.size())
+				{
+					offsetIndices[vertex] = (int32_t)k;
+				}
+			}
 
-#define DOMATERIAL(to, map)\
-		MATERIALCOLOR(to, map);\
-		\
-		MATERIALTEXTURE(to, map);
+			auto Moves = [&](size_t vertex) -> bool
+			{
+				int32_t offsetIndex = offsetIndices[vertexSources[vertex]];
 
-#define DOPBRMATERIAL(to, map)\
-		MATERIALPBRCOLOR(to, map);\
-		\
-		MATERIALPBRTEXTURE(to, map);
+				if (offsetIndex < 0)
+				{
+					return false;
+				}
 
-		DOMATERIAL(diffuse, UFBX_MATERIAL_FBX_DIFFUSE_COLOR);
-		DOMATERIAL(specular, UFBX_MATERIAL_FBX_SPECULAR_COLOR);
-		DOMATERIAL(reflection, UFBX_MATERIAL_FBX_REFLECTION_COLOR);
-		DOMATERIAL(transparency, UFBX_MATERIAL_FBX_TRANSPARENCY_COLOR);
-		DOMATERIAL(emission, UFBX_MATERIAL_FBX_EMISSION_COLOR);
-		DOMATERIAL(ambient, UFBX_MATERIAL_FBX_AMBIENT_COLOR);
-		DOMATERIAL(normalMap, UFBX_MATERIAL_FBX_NORMAL_MAP);
-		DOMATERIAL(bump, UFBX_MATERIAL_FBX_BUMP);
-		DOMATERIAL(displacement, UFBX_MATERIAL_FBX_DISPLACEMENT);
-		DOMATERIAL(vectorDisplacement, UFBX_MATERIAL_FBX_VECTOR_DISPLACEMENT);
-		
-		DOPBRMATERIAL(diffuse, UFBX_MATERIAL_PBR_BASE_COLOR);
-		DOPBRMATERIAL(specular, UFBX_MATERIAL_PBR_SPECULAR_COLOR);
-		DOPBRMATERIAL(reflection, UFBX_MATERIAL_PBR_METALNESS);
-		DOPBRMATERIAL(transparency, UFBX_MATERIAL_PBR_OPACITY);
+				ufbx_vec3 position = shape->position_offsets[offsetIndex];
+
+				if (position.x != 0 || position.y != 0 || position.z != 0)
+				{
+					return true;
+				}
+
+				if (hasNormalOffsets)
+				{
+					ufbx_vec3 normal = shape->normal_offsets[offsetIndex];
+
+					return normal.x != 0 || normal.y != 0 || normal.z != 0;
+				}
+
+				return false;
+			};
+
+			size_t deltaCount = 0;
+
+			for (size_t k = 0; k < vertexCount; k++)
+			{
+				if (Moves(k))
+				{
+					deltaCount++;
+				}
+			}
+
+			//Shapes that don't move this part are still listed so channel weights stay meaningful for every part of the mesh
+			BlendShape& blendShape = ownMesh.blendShapes[ownMesh.blendShapeCount++];
+
+			blendShape.channelIndex = (int32_t)channel->typed_id;
+			blendShape.weight = (float)channel->weight;
+			blendShape.deltaCount = (int32_t)deltaCount;
+			blendShape.vertexIndices = arena.AllocateUninitialized<uint32_t>(deltaCount);
+			blendShape.positionDeltas = arena.AllocateUninitialized<Vector3>(deltaCount);
+			blendShape.normalDeltas = hasNormalOffsets ? arena.AllocateUninitialized<Vector3>(deltaCount) : nullptr;
+
+			size_t deltaIndex = 0;
+
+			for (size_t k = 0; k < vertexCount && deltaIndex < deltaCount; k++)
+			{
+				if (Moves(k) == false)
+				{
+					continue;
+				}
+
+				int32_t offsetIndex = offsetIndices[vertexSources[k]];
+
+				blendShape.vertexIndices[deltaIndex] = (uint32_t)k;
+				blendShape.positionDeltas[deltaIndex] = Vector3(shape->position_offsets[offsetIndex]);
+
+				if (blendShape.normalDeltas != nullptr)
+				{
+					blendShape.normalDeltas[deltaIndex] = Vector3(shape->normal_offsets[offsetIndex]);
+				}
+
+				deltaIndex++;
+			}
+
+			for (size_t k = 0; k < shape->num_offsets; k++)
+			{
+				uint32_t vertex = shape->offset_vertices[k];
+
+				if (vertex < offsetIndices.size())
+				{
+					offsetIndices[vertex] = -1;
+				}
+			}
+		}
+	}
+}
+
+class Node
+{
+public:
+
+	int32_t parentIndex;
+
+	String name;
+
+	int32_t* meshIndices;
+
+	int32_t meshCount;
+
+	Matrix4x4 localTransform;
+
+	Node() : parentIndex(-1), meshIndices(nullptr), meshCount(0)
+	{
+	}
+
+	//Returns false if the part has no geometry, failed, or the import was cancelled.
+	//Runs in parallel, so names are left empty for Scene::ReadMeshes to add in a fixed order.
+	static bool ReadMeshPart(ufbx_node* node, ufbx_mesh* mesh, size_t j, const SceneLoadOptions& options, Mesh& ownMesh,
+		Arena& arena, ImportProgressTracker& progress)
+	{
+		const ufbx_mesh_part& part = mesh->material_parts[j];
+
+		ownMesh.isSkinned = mesh->skin_deformers.count > 0;
+
+		ufbx_material* material = j < node->materials.count ? node->materials[j] : nullptr;
+
+		ufbx_skin_deformer* skin = mesh->skin_deformers.count > 0 ? mesh->skin_deformers[0] : nullptr;
+
+		uint32_t requested = options.attributes != 0 ? options.attributes : STAPLE_VERTEX_ATTRIBUTE_ALL;
+
+		uint32_t uvCount = mesh->uv_sets.count < 8 ? (uint32_t)mesh->uv_sets.count : 8;
+		uint32_t colorCount = mesh->color_sets.count < 4 ? (uint32_t)mesh->color_sets.count : 4;
+
+		//Only attributes that are both requested and present are emitted, which also keeps them out of the dedup hashing
+		VertexLayout layout;
+
+		layout.Add(STAPLE_VERTEX_INDEX_POSITION, 3);
+
+		if (requested & STAPLE_VERTEX_ATTRIBUTE_NORMAL)
+		{
+			layout.Add(STAPLE_VERTEX_INDEX_NORMAL, 3);
+		}
+
+		//Generated tangents need normals and UVs to come from, and replace the imported ones entirely
+		bool generateTangents = (requested & (STAPLE_VERTEX_ATTRIBUTE_TANGENT | STAPLE_VERTEX_ATTRIBUTE_BITANGENT)) != 0 &&
+			(requested & STAPLE_VERTEX_ATTRIBUTE_NORMAL) != 0 && (requested & STAPLE_VERTEX_ATTRIBUTE_TEXCOORD0) != 0 &&
+			mesh->vertex_normal.exists && mesh->uv_sets.count > 0 &&
+			(options.tangentGeneration == STAPLE_TANGENT_GENERATION_ALWAYS ||
+			(options.tangentGeneration == STAPLE_TANGENT_GENERATION_MISSING && mesh->vertex_tangent.exists == false));
+
+		if ((requested & STAPLE_VERTEX_ATTRIBUTE_TANGENT) && (mesh->vertex_tangent.exists || generateTangents))
+		{
+			layout.Add(STAPLE_VERTEX_INDEX_TANGENT, 3);
+		}
+
+		if ((requested & STAPLE_VERTEX_ATTRIBUTE_BITANGENT) && (mesh->vertex_bitangent.exists || generateTangents))
+		{
+			layout.Add(STAPLE_VERTEX_INDEX_BITANGENT, 3);
+		}
+
+		for (uint32_t l = 0; l < colorCount; l++)
+		{
+			if (requested & (STAPLE_VERTEX_ATTRIBUTE_COLOR0 << l))
+			{
+				layout.Add(STAPLE_VERTEX_INDEX_COLOR0 + l, 4);
+			}
+		}
+
+		for (uint32_t l = 0; l < uvCount; l++)
+		{
+			if (requested & (STAPLE_VERTEX_ATTRIBUTE_TEXCOORD0 << l))
+			{
+				layout.Add(STAPLE_VERTEX_INDEX_TEXCOORD0 + l, 2);
+			}
+		}
+
+		uint32_t influenceCount = options.maxBoneInfluences > 4 ? 8 : 4;
+
+		bool compactSkin = skin != nullptr && (options.compactSkin || options.quantize);
+
+		//Compact skin data is still deduplicated through the float attributes, which are removed from the output afterwards.
+		//They're the last attributes of the layout so this doesn't move any other attribute.
+		if (compactSkin)
+		{
+			requested |= STAPLE_VERTEX_ATTRIBUTE_SKIN;
+		}
+
+		if (skin != nullptr)
+		{
+			for (uint32_t l = 0; l < influenceCount / 4; l++)
+			{
+				uint32_t indicesIndex = l == 0 ? STAPLE_VERTEX_INDEX_BLEND_INDICES : STAPLE_VERTEX_INDEX_BLEND_INDICES1;
+				uint32_t weightsIndex = l == 0 ? STAPLE_VERTEX_INDEX_BLEND_WEIGHTS : STAPLE_VERTEX_INDEX_BLEND_WEIGHTS1;
+
+				if (requested & (1 << indicesIndex))
+				{
+					layout.Add(indicesIndex, 4);
+				}
+
+				if (requested & (1 << weightsIndex))
+				{
+					layout.Add(weightsIndex, 4);
+				}
+			}
+		}
+
+		SkinReader skinReader(skin, influenceCount);
+
+		//Resolve the UV and color sets once so the vertex loop only walks the ones that are emitted
+		const ufbx_vertex_vec2* uvSets[8];
+		uint32_t uvIndices[8];
+		uint32_t activeUVCount = 0;
+
+		for (uint32_t l = 0; l < uvCount; l++)
+		{
+			if (layout.Has(STAPLE_VERTEX_INDEX_TEXCOORD0 + l))
+			{
+				uvSets[activeUVCount] = &mesh->uv_sets[l].vertex_uv;
+				uvIndices[activeUVCount] = STAPLE_VERTEX_INDEX_TEXCOORD0 + l;
+
+				activeUVCount++;
+			}
+		}
+
+		const ufbx_vertex_vec4* colorSets[4];
+		uint32_t colorIndices[4];
+		uint32_t activeColorCount = 0;
+
+		for (uint32_t l = 0; l < colorCount; l++)
+		{
+			if (layout.Has(STAPLE_VERTEX_INDEX_COLOR0 + l))
+			{
+				colorSets[activeColorCount] = &mesh->color_sets[l].vertex_color;
+				colorIndices[activeColorCount] = STAPLE_VERTEX_INDEX_COLOR0 + l;
+
+				activeColorCount++;
+			}
+		}
+
+		bool hasNormals = layout.Has(STAPLE_VERTEX_INDEX_NORMAL);
+		bool hasTangents = layout.Has(STAPLE_VERTEX_INDEX_TANGENT) && generateTangents == false;
+		bool hasBitangents = layout.Has(STAPLE_VERTEX_INDEX_BITANGENT) && generateTangents == false;
+		bool hasSkin = (layout.attributes & STAPLE_VERTEX_ATTRIBUTE_SKIN) != 0;
+
+		//Every buffer is sized up front, so nothing is allocated per face or per vertex
+		std::vector<float> vertices(part.num_triangles * 3 * layout.stride, 0.0f);
+
+		//Blend shapes move ufbx vertices, so the vertex each corner comes from is part of the dedup key.
+		//Otherwise two corners with the same attributes but different shape offsets could be merged.
+		bool hasBlendShapes = HasBlendShapes(mesh);
+
+		std::vector<uint32_t> vertexSources(hasBlendShapes ? part.num_triangles * 3 : 0);
+
+		std::vector<uint32_t> triangleIndices(mesh->max_face_triangles * 3);
+
+		size_t totalVertexCount = 0;
+		size_t reportedVertexCount = 0;
+
+		for (size_t faceIndex = 0; faceIndex < part.num_faces; faceIndex++)
+		{
+			//Large parts report in between so cancelling doesn't have to wait for the whole part
+			if ((faceIndex & 16383) == 16383)
+			{
+				if (progress.Add(STAPLE_IMPORT_STAGE_MESHES, (totalVertexCount - reportedVertexCount) / 3) == false)
+				{
+					return false;
+				}
+
+				reportedVertexCount = totalVertexCount;
+			}
+
+			const ufbx_face& face = mesh->faces[part.face_indices.data[faceIndex]];
+
+			size_t triangleCount = ufbx_triangulate_face(triangleIndices.data(), triangleIndices.size(), mesh, face);
+
+			size_t vertexCount = triangleCount * 3;
+
+			if (totalVertexCount + vertexCount > part.num_triangles * 3)
+			{
+				break;
+			}
+
+			for (size_t k = 0; k < vertexCount; k++)
+			{
+				uint32_t index = triangleIndices[k];
+
+				float* v = &vertices[(totalVertexCount + k) * layout.stride];
+
+				uint32_t vertexIndex = mesh->vertex_indices[index];
+
+				layout.Write(v, STAPLE_VERTEX_INDEX_POSITION, Vector3(mesh->vertices[vertexIndex]));
+
+				if (hasBlendShapes)
+				{
+					vertexSources[totalVertexCount + k] = vertexIndex;
+				}
+
+				if (hasNormals)
+				{
+					uint32_t normalIndex = mesh->vertex_normal.indices[index];
+
+					if (normalIndex < mesh->vertex_normal.values.count)
+					{
+						layout.Write(v, STAPLE_VERTEX_INDEX_NORMAL, Vector3(mesh->vertex_normal.values[normalIndex]));
+					}
+				}
+
+				if (hasTangents)
+				{
+					uint32_t tangentIndex = mesh->vertex_tangent.indices[index];
+
+					if (tangentIndex < mesh->vertex_tangent.values.count)
+					{
+						layout.Write(v, STAPLE_VERTEX_INDEX_TANGENT, Vector3(mesh->vertex_tangent.values[tangentIndex]));
+					}
+				}
+
+				if (hasBitangents)
+				{
+					uint32_t bitangentIndex = mesh->vertex_bitangent.indices[index];
+
+					if (bitangentIndex < mesh->vertex_bitangent.values.count)
+					{
+						layout.Write(v, STAPLE_VERTEX_INDEX_BITANGENT, Vector3(mesh->vertex_bitangent.values[bitangentIndex]));
+					}
+				}
+
+				for (uint32_t l = 0; l < activeUVCount; l++)
+				{
+					const ufbx_vertex_vec2& UVSet = *uvSets[l];
+
+					uint32_t UVIndex = UVSet.indices[index];
+
+					if (UVIndex < UVSet.values.count)
+					{
+						layout.Write(v, uvIndices[l], Vector2(UVSet.values[UVIndex]));
+					}
+				}
+
+				for (uint32_t l = 0; l < activeColorCount; l++)
+				{
+					const ufbx_vertex_vec4& colorSet = *colorSets[l];
+
+					uint32_t colorIndex = colorSet.indices[index];
+
+					if (colorIndex < colorSet.values.count)
+					{
+						layout.Write(v, colorIndices[l], Vector4(colorSet.values[colorIndex]));
+					}
+				}
+
+				if (hasSkin)
+				{
+					float boneIndices[8];
+					float boneWeights[8];
+
+					skinReader.Read(vertexIndex, boneIndices, boneWeights);
+
+					if (layout.Has(STAPLE_VERTEX_INDEX_BLEND_INDICES))
+					{
+						layout.WriteArray(v, STAPLE_VERTEX_INDEX_BLEND_INDICES, boneIndices, 4);
+					}
+
+					if (layout.Has(STAPLE_VERTEX_INDEX_BLEND_WEIGHTS))
+					{
+						layout.WriteArray(v, STAPLE_VERTEX_INDEX_BLEND_WEIGHTS, boneWeights, 4);
+					}
+
+					if (layout.Has(STAPLE_VERTEX_INDEX_BLEND_INDICES1))
+					{
+						layout.WriteArray(v, STAPLE_VERTEX_INDEX_BLEND_INDICES1, boneIndices + 4, 4);
+					}
+
+					if (layout.Has(STAPLE_VERTEX_INDEX_BLEND_WEIGHTS1))
+					{
+						layout.WriteArray(v, STAPLE_VERTEX_INDEX_BLEND_WEIGHTS1, boneWeights + 4, 4);
+					}
+				}
+			}
+
+			totalVertexCount += vertexCount;
+		}
+
+		//Parts that stopped early still count in full so the stage adds up to its total
+		if (progress.Add(STAPLE_IMPORT_STAGE_MESHES, part.num_triangles - reportedVertexCount / 3) == false)
+		{
+			return false;
+		}
+
+		//Done before the corners are merged so corners on either side of a UV seam can keep different tangents.
+		//Mesh parts are read in parallel, so each one runs MikkTSpace on its own thread.
+		if (generateTangents && GenerateTangents(vertices.data(), layout, totalVertexCount) == false)
+		{
+			return false;
+		}
+
+		ownMesh.generatedTangents = generateTangents;
+
+		ufbx_vertex_stream vertexStreams[2];
+
+		memset(vertexStreams, 0, sizeof(vertexStreams));
+
+		vertexStreams[0].data = vertices.data();
+		vertexStreams[0].vertex_count = totalVertexCount;
+		vertexStreams[0].vertex_size = layout.stride * sizeof(float);
+
+		vertexStreams[1].data = vertexSources.data();
+		vertexStreams[1].vertex_count = totalVertexCount;
+		vertexStreams[1].vertex_size = sizeof(uint32_t);
+
+		uint32_t* indices = arena.AllocateUninitialized<uint32_t>(totalVertexCount);
+
+		ufbx_error indexError;
+
+		uint32_t vertexCount = (uint32_t)ufbx_generate_indices(vertexStreams, hasBlendShapes ? 2 : 1, indices, totalVertexCount,
+			nullptr, &indexError);
+
+		if (indexError.type != UFBX_ERROR_NONE)
+		{
+			PrintError(&indexError, "Mesh index generation failed");
+
+			return false;
+		}
+
+		if (options.flipWindingOrder)
+		{
+			for (size_t k = 0; k + 2 < totalVertexCount; k += 3)
+			{
+				std::swap(indices[k + 1], indices[k + 2]);
+			}
+		}
+
+		//Done while the vertices are still packed together, so every stream built from them below follows the new order
+		if (options.optimizeMeshes)
+		{
+			size_t vertexSize = layout.stride * sizeof(float);
+
+			meshopt_optimizeVertexCache(indices, indices, totalVertexCount, vertexCount);
+			meshopt_optimizeOverdraw(indices, indices, totalVertexCount, vertices.data() + layout.offsets[STAPLE_VERTEX_INDEX_POSITION],
+				vertexCount, vertexSize, 1.05f);
+
+			std::vector<uint32_t> remap(vertexCount);
+
+			uint32_t usedVertexCount = (uint32_t)meshopt_optimizeVertexFetchRemap(remap.data(), indices, totalVertexCount, vertexCount);
+
+			meshopt_remapIndexBuffer(indices, indices, totalVertexCount, remap.data());
+
+			//Unused vertices are left out, so the streams end at the used ones
+			meshopt_remapVertexBuffer(vertices.data(), vertices.data(), vertexCount, vertexSize, remap.data());
+
+			vertices.resize((size_t)usedVertexCount * layout.stride);
+
+			if (hasBlendShapes)
+			{
+				meshopt_remapVertexBuffer(vertexSources.data(), vertexSources.data(), vertexCount, sizeof(uint32_t), remap.data());
+
+				vertexSources.resize(usedVertexCount);
+			}
+
+			vertexCount = usedVertexCount;
+		}
+
+		if (options.buildMeshlets)
+		{
+			//meshoptimizer needs the triangle limit to be a multiple of 4
+			size_t maxVertices = options.meshletMaxVertices > 0 ? ClampSize(options.meshletMaxVertices, 3, 256) : 64;
+			size_t maxTriangles = options.meshletMaxTriangles > 0 ? ClampSize(options.meshletMaxTriangles, 4, 512) / 4 * 4 : 124;
+
+			const float* positions = vertices.data() + layout.offsets[STAPLE_VERTEX_INDEX_POSITION];
+			size_t vertexSize = layout.stride * sizeof(float);
+
+			size_t maxMeshlets = meshopt_buildMeshletsBound(totalVertexCount, maxVertices, maxTriangles);
+
+			std::vector<meshopt_Meshlet> clusters(maxMeshlets);
+			std::vector<uint32_t> meshletVertices(maxMeshlets * maxVertices);
+			std::vector<uint8_t> meshletTriangles(maxMeshlets * maxTriangles * 3);
+
+			//The cone weight trades some vertex reuse for meshlets that face one way, which makes backface culling them work more often
+			size_t meshletCount = meshopt_buildMeshlets(clusters.data(), meshletVertices.data(), meshletTriangles.data(), indices,
+				totalVertexCount, positions, vertexCount, vertexSize, maxVertices, maxTriangles, 0.25f);
+
+			std::vector<Meshlet> meshlets(meshletCount);
+
+			for (size_t i = 0; i < meshletCount; i++)
+			{
+				const meshopt_Meshlet& cluster = clusters[i];
+
+				meshopt_Bounds bounds = meshopt_computeMeshletBounds(&meshletVertices[cluster.vertex_offset],
+					&meshletTriangles[cluster.triangle_offset], cluster.triangle_count, positions, vertexCount, vertexSize);
+
+				Meshlet& meshlet = meshlets[i];
+
+				meshlet.vertexOffset = cluster.vertex_offset;
+				meshlet.triangleOffset = cluster.triangle_offset;
+				meshlet.vertexCount = cluster.vertex_count;
+				meshlet.triangleCount = cluster.triangle_count;
+				meshlet.radius = bounds.radius;
+				meshlet.coneCutoff = bounds.cone_cutoff;
+
+				for (uint32_t j = 0; j < 3; j++)
+				{
+					meshlet.center[j] = bounds.center[j];
+					meshlet.coneApex[j] = bounds.cone_apex[j];
+					meshlet.coneAxis[j] = bounds.cone_axis[j];
+				}
+			}
+
+			//The buffers were sized for the worst case, so they're cut after the last meshlet
+			if (meshletCount > 0)
+			{
+				const meshopt_Meshlet& last = clusters[meshletCount - 1];
+
+				meshletVertices.resize(last.vertex_offset + last.vertex_count);
+				meshletTriangles.resize(last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3u));
+			}
+			else
+			{
+				meshletVertices.clear();
+				meshletTriangles.clear();
+			}
+
+			ownMesh.meshlets = arena.Duplicate(meshlets.data(), meshlets.size());
+			ownMesh.meshletCount = (int32_t)meshlets.size();
+			ownMesh.meshletVertices = arena.Duplicate(meshletVertices.data(), meshletVertices.size());
+			ownMesh.meshletVertexCount = (int32_t)meshletVertices.size();
+			ownMesh.meshletTriangles = arena.Duplicate(meshletTriangles.data(), meshletTriangles.size());
+			ownMesh.meshletTriangleIndexCount = (int32_t)meshletTriangles.size();
+		}
+
+		if (progress.Add(STAPLE_IMPORT_STAGE_INDICES, part.num_triangles * 3) == false)
+		{
+			return false;
+		}
+
+		ownMesh.attributes = compactSkin ? (layout.attributes & ~STAPLE_VERTEX_ATTRIBUTE_SKIN) : layout.attributes;
+		ownMesh.vertexCount = vertexCount;
+		ownMesh.indexCount = (int32_t)totalVertexCount;
+		ownMesh.materialIndex = material != nullptr ? material->typed_id : -1;
+
+		ownMesh.indices = indices;
+
+		if (skinReader.bones.size() > 0)
+		{
+			ownMesh.boneCount = (int32_t)skinReader.bones.size();
+
+			ownMesh.bones = arena.Duplicate(skinReader.bones.data(), skinReader.bones.size());
+		}
+
+		if (compactSkin)
+		{
+			WriteCompactSkin(ownMesh, layout, vertices.data(), vertexCount, influenceCount, arena);
+		}
+
+		if (hasBlendShapes)
+		{
+			ReadBlendShapes(mesh, vertexSources.data(), vertexCount, hasNormals, ownMesh, arena);
+		}
+
+		if (options.quantize)
+		{
+			WriteQuantizedVertices(ownMesh, layout, vertices.data(), vertexCount, arena);
+
+			return true;
+		}
+
+		if (options.interleaved)
+		{
+			//The unique vertices were compacted to the start of the buffer, which already is the requested layout
+			//unless the skin attributes at the end of each vertex have to be dropped
+			uint32_t stride = compactSkin ? (uint32_t)layout.offsets[STAPLE_VERTEX_INDEX_BLEND_INDICES] : layout.stride;
+
+			if (stride == layout.stride)
+			{
+				ownMesh.interleavedVertices = arena.Duplicate(vertices.data(), vertexCount * layout.stride);
+			}
+			else
+			{
+				ownMesh.interleavedVertices = arena.AllocateUninitialized<float>(vertexCount * stride);
+
+				for (size_t k = 0; k < vertexCount; k++)
+				{
+					memcpy(ownMesh.interleavedVertices + k * stride, &vertices[k * layout.stride], stride * sizeof(float));
+				}
+			}
+
+			ownMesh.vertexStride = (int32_t)(stride * sizeof(float));
+
+			return true;
+		}
+
+		if (compactSkin)
+		{
+			for (uint32_t l = STAPLE_VERTEX_INDEX_BLEND_INDICES; l < STAPLE_VERTEX_ATTRIBUTE_COUNT; l++)
+			{
+				layout.offsets[l] = -1;
+			}
+		}
+
+#define STREAM(to, type, attribute)\
+	to = layout.Has(attribute) ? arena.AllocateUninitialized<type>(vertexCount) : nullptr;
+
+		STREAM(ownMesh.vertices, Vector3, STAPLE_VERTEX_INDEX_POSITION);
+		STREAM(ownMesh.normals, Vector3, STAPLE_VERTEX_INDEX_NORMAL);
+		STREAM(ownMesh.tangents, Vector3, STAPLE_VERTEX_INDEX_TANGENT);
+		STREAM(ownMesh.bitangents, Vector3, STAPLE_VERTEX_INDEX_BITANGENT);
+		STREAM(ownMesh.color0, Vector4, STAPLE_VERTEX_INDEX_COLOR0);
+		STREAM(ownMesh.color1, Vector4, STAPLE_VERTEX_INDEX_COLOR0 + 1);
+		STREAM(ownMesh.color2, Vector4, STAPLE_VERTEX_INDEX_COLOR0 + 2);
+		STREAM(ownMesh.color3, Vector4, STAPLE_VERTEX_INDEX_COLOR0 + 3);
+		STREAM(ownMesh.uv0, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0);
+		STREAM(ownMesh.uv1, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 1);
+		STREAM(ownMesh.uv2, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 2);
+		STREAM(ownMesh.uv3, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 3);
+		STREAM(ownMesh.uv4, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 4);
+		STREAM(ownMesh.uv5, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 5);
+		STREAM(ownMesh.uv6, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 6);
+		STREAM(ownMesh.uv7, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 7);
+		STREAM(ownMesh.boneIndices, Vector4, STAPLE_VERTEX_INDEX_BLEND_INDICES);
+		STREAM(ownMesh.boneWeights, Vector4, STAPLE_VERTEX_INDEX_BLEND_WEIGHTS);
+		STREAM(ownMesh.boneIndices1, Vector4, STAPLE_VERTEX_INDEX_BLEND_INDICES1);
+		STREAM(ownMesh.boneWeights1, Vector4, STAPLE_VERTEX_INDEX_BLEND_WEIGHTS1);
+#undef STREAM
+
+		for (size_t k = 0; k < vertexCount; k++)
+		{
+			const float* v = &vertices[k * layout.stride];
+
+#define COPYIF(to, type, attribute)\
+	if(to != nullptr)\
+	{\
+		to[k] = layout.Read<type>(v, attribute);\
+	}
+
+			COPYIF(ownMesh.vertices, Vector3, STAPLE_VERTEX_INDEX_POSITION);
+			COPYIF(ownMesh.normals, Vector3, STAPLE_VERTEX_INDEX_NORMAL);
+			COPYIF(ownMesh.tangents, Vector3, STAPLE_VERTEX_INDEX_TANGENT);
+			COPYIF(ownMesh.bitangents, Vector3, STAPLE_VERTEX_INDEX_BITANGENT);
+			COPYIF(ownMesh.color0, Vector4, STAPLE_VERTEX_INDEX_COLOR0);
+			COPYIF(ownMesh.color1, Vector4, STAPLE_VERTEX_INDEX_COLOR0 + 1);
+			COPYIF(ownMesh.color2, Vector4, STAPLE_VERTEX_INDEX_COLOR0 + 2);
+			COPYIF(ownMesh.color3, Vector4, STAPLE_VERTEX_INDEX_COLOR0 + 3);
+			COPYIF(ownMesh.uv0, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0);
+			COPYIF(ownMesh.uv1, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 1);
+			COPYIF(ownMesh.uv2, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 2);
+			COPYIF(ownMesh.uv3, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 3);
+			COPYIF(ownMesh.uv4, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 4);
+			COPYIF(ownMesh.uv5, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 5);
+			COPYIF(ownMesh.uv6, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 6);
+			COPYIF(ownMesh.uv7, Vector2, STAPLE_VERTEX_INDEX_TEXCOORD0 + 7);
+			COPYIF(ownMesh.boneIndices, Vector4, STAPLE_VERTEX_INDEX_BLEND_INDICES);
+			COPYIF(ownMesh.boneWeights, Vector4, STAPLE_VERTEX_INDEX_BLEND_WEIGHTS);
+			COPYIF(ownMesh.boneIndices1, Vector4, STAPLE_VERTEX_INDEX_BLEND_INDICES1);
+			COPYIF(ownMesh.boneWeights1, Vector4, STAPLE_VERTEX_INDEX_BLEND_WEIGHTS1);
+#undef COPYIF
+		}
+
+		return true;
+	}
+
+	void Read(ufbx_scene *scene, ufbx_node* node, StringPool& strings)
+	{
+		if (node->name.length == 0)
+		{
+			if (node->is_root)
+			{
+				name = strings.Add("internal_root");
+			}
+			else
+			{
+				name = strings.Add("internal_group");
+			}
+		}
+		else
+		{
+			name = strings.Add(node->name);
+		}
+
+		parentIndex = node->parent ? node->parent->typed_id : -1;
+
+		localTransform = node->node_to_parent;
+	}
+};
+
+enum TextureWrap : int
+{
+	STAPLE_TEXTURE_WRAP_REPEAT,
+	STAPLE_TEXTURE_WRAP_CLAMP,
+	STAPLE_TEXTURE_WRAP_MIRROR,
+};
+
+static TextureWrap UFBXWrapToStapleWrap(ufbx_wrap_mode mode)
+{
+	switch (mode)
+	{
+	case UFBX_WRAP_CLAMP:
+
+		return STAPLE_TEXTURE_WRAP_CLAMP;
+
+	case UFBX_WRAP_REPEAT:
+
+		return STAPLE_TEXTURE_WRAP_REPEAT;
+
+	default:
+
+		return STAPLE_TEXTURE_WRAP_CLAMP;
+	}
+}
+
+static uint64_t HashCombine(uint64_t seed, uint64_t value)
+{
+	value *= 0x9E3779B97F4A7C15ULL;
+	value ^= value >> 32;
+
+	seed ^= value;
+	seed *= 0xFF51AFD7ED558CCDULL;
+	seed ^= seed >> 29;
+
+	return seed;
+}
+
+static uint64_t HashDouble(uint64_t seed, double value)
+{
+	uint64_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+
+	return HashCombine(seed, bits);
+}
+
+static uint64_t HashBytes(const void* data, size_t size)
+{
+	const uint8_t* ptr = (const uint8_t*)data;
+
+	uint64_t hash = HashCombine(0, size);
+
+	size_t i = 0;
+
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+	{
+		uint64_t value;
+
+		memcpy(&value, ptr + i, sizeof(value));
+
+		hash = HashCombine(hash, value);
+	}
+
+	for (; i < size; i++)
+	{
+		hash = HashCombine(hash, ptr[i]);
+	}
+
+	return hash;
+}
+
+//A texture used by the materials of a scene
+class Texture
+{
+public:
+	String name;
+
+	String fileName;
+
+	//Contents of the file when it's embedded in the scene, like the raw bytes of a .png
+	uint8_t* content;
+
+	int32_t contentSize;
+
+	//Hash of `content`, embedded textures with the same contents are only stored once
+	uint64_t contentHash;
+
+	Texture() : content(nullptr), contentSize(0), contentHash(0)
+	{
+	}
+};
+
+//Gives every texture used by the materials an index into the scene's textures.
+//Embedded textures are merged by their contents, the others by their file name.
+class TextureTable
+{
+public:
+	std::vector<Texture> textures;
+
+	TextureTable(Arena& arena, StringPool& strings) : arena(arena), strings(strings)
+	{
+	}
+
+	//Returns -1 if the texture has neither contents nor a file name
+	int32_t Add(ufbx_texture* texture)
+	{
+		auto it = indices.find(texture);
+
+		if (it != indices.end())
+		{
+			return it->second;
+		}
+
+		int32_t index = -1;
+
+		if (texture->content.size > 0 && texture->content.size <= INT32_MAX)
+		{
+			uint64_t hash = HashBytes(texture->content.data, texture->content.size);
+
+			auto range = byContent.equal_range(hash);
+
+			for (auto entry = range.first; entry != range.second; entry++)
+			{
+				const Texture& other = textures[entry->second];
+
+				if ((size_t)other.contentSize == texture->content.size &&
+					memcmp(other.content, texture->content.data, texture->content.size) == 0)
+				{
+					index = entry->second;
+
+					break;
+				}
+			}
+
+			if (index < 0)
+			{
+				index = Create(texture);
+
+				Texture& outValue = textures[index];
+
+				//The ufbx scene is freed once the import is done, so the contents have to be copied once
+				outValue.content = arena.Duplicate((const uint8_t*)texture->content.data, texture->content.size);
+				outValue.contentSize = (int32_t)texture->content.size;
+				outValue.contentHash = hash;
+
+				byContent.emplace(hash, index);
+			}
+		}
+		else if (texture->filename.length > 0)
+		{
+			std::string key(texture->filename.data, texture->filename.length);
+
+			auto entry = byFileName.find(key);
+
+			if (entry != byFileName.end())
+			{
+				index = entry->second;
+			}
+			else
+			{
+				index = Create(texture);
+
+				byFileName.emplace(key, index);
+			}
+		}
+
+		indices.emplace(texture, index);
+
+		return index;
+	}
+
+private:
+	int32_t Create(ufbx_texture* texture)
+	{
+		Texture outValue;
+
+		outValue.name = strings.Add(texture->name);
+		outValue.fileName = strings.Add(texture->filename);
+
+		textures.push_back(outValue);
+
+		return (int32_t)textures.size() - 1;
+	}
+
+	Arena& arena;
+	StringPool& strings;
+	std::unordered_map<ufbx_texture*, int32_t> indices;
+	std::unordered_multimap<uint64_t, int32_t> byContent;
+	std::unordered_map<std::string, int32_t> byFileName;
+};
+
+class Material
+{
+public:
+
+	String name;
+
+#define MATERIALPROP(name) \
+	Vector4 name ## Color;\
+	String name ## Texture;\
+	int32_t name ## TextureIndex;\
+	TextureWrap name ## WrapU; \
+	TextureWrap name ## WrapV;
+
+	MATERIALPROP(diffuse);
+	MATERIALPROP(specular);
+	MATERIALPROP(reflection);
+	MATERIALPROP(transparency);
+	MATERIALPROP(emission);
+	MATERIALPROP(ambient);
+	MATERIALPROP(normalMap);
+	MATERIALPROP(bump);
+	MATERIALPROP(displacement);
+	MATERIALPROP(vectorDisplacement);
+
+#undef MATERIALPROP
+
+	Material() : diffuseTextureIndex(-1), diffuseWrapU(STAPLE_TEXTURE_WRAP_CLAMP), diffuseWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		specularTextureIndex(-1), specularWrapU(STAPLE_TEXTURE_WRAP_CLAMP), specularWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		reflectionTextureIndex(-1), reflectionWrapU(STAPLE_TEXTURE_WRAP_CLAMP), reflectionWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		transparencyTextureIndex(-1), transparencyWrapU(STAPLE_TEXTURE_WRAP_CLAMP), transparencyWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		emissionTextureIndex(-1), emissionWrapU(STAPLE_TEXTURE_WRAP_CLAMP), emissionWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		ambientTextureIndex(-1), ambientWrapU(STAPLE_TEXTURE_WRAP_CLAMP), ambientWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		normalMapTextureIndex(-1), normalMapWrapU(STAPLE_TEXTURE_WRAP_CLAMP), normalMapWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		bumpTextureIndex(-1), bumpWrapU(STAPLE_TEXTURE_WRAP_CLAMP), bumpWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		displacementTextureIndex(-1), displacementWrapU(STAPLE_TEXTURE_WRAP_CLAMP), displacementWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		vectorDisplacementTextureIndex(-1), vectorDisplacementWrapU(STAPLE_TEXTURE_WRAP_CLAMP), vectorDisplacementWrapV(STAPLE_TEXTURE_WRAP_CLAMP)
+	{
+	}
+
+	Material(const Material& o) : name(o.name),
+		diffuseTexture(o.diffuseTexture), diffuseTextureIndex(o.diffuseTextureIndex), diffuseWrapU(STAPLE_TEXTURE_WRAP_CLAMP), diffuseWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		specularTexture(o.specularTexture), specularTextureIndex(o.specularTextureIndex), specularWrapU(STAPLE_TEXTURE_WRAP_CLAMP), specularWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		reflectionTexture(o.reflectionTexture), reflectionTextureIndex(o.reflectionTextureIndex), reflectionWrapU(STAPLE_TEXTURE_WRAP_CLAMP), reflectionWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		transparencyTexture(o.transparencyTexture), transparencyTextureIndex(o.transparencyTextureIndex), transparencyWrapU(STAPLE_TEXTURE_WRAP_CLAMP), transparencyWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		emissionTexture(o.emissionTexture), emissionTextureIndex(o.emissionTextureIndex), emissionWrapU(STAPLE_TEXTURE_WRAP_CLAMP), emissionWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		ambientTexture(o.ambientTexture), ambientTextureIndex(o.ambientTextureIndex), ambientWrapU(STAPLE_TEXTURE_WRAP_CLAMP), ambientWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		normalMapTexture(o.normalMapTexture), normalMapTextureIndex(o.normalMapTextureIndex), normalMapWrapU(STAPLE_TEXTURE_WRAP_CLAMP), normalMapWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		bumpTexture(o.bumpTexture), bumpTextureIndex(o.bumpTextureIndex), bumpWrapU(STAPLE_TEXTURE_WRAP_CLAMP), bumpWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		displacementTexture(o.displacementTexture), displacementTextureIndex(o.displacementTextureIndex), displacementWrapU(STAPLE_TEXTURE_WRAP_CLAMP), displacementWrapV(STAPLE_TEXTURE_WRAP_CLAMP),
+		vectorDisplacementTexture(o.vectorDisplacementTexture), vectorDisplacementTextureIndex(o.vectorDisplacementTextureIndex), vectorDisplacementWrapU(STAPLE_TEXTURE_WRAP_CLAMP),
+		vectorDisplacementWrapV(STAPLE_TEXTURE_WRAP_CLAMP)
+	{
+	}
+
+	void Read(ufbx_material* material, StringPool& strings, TextureTable& textures)
+	{
+		if (material->name.length > 0)
+		{
+			name = strings.Add(material->name);
+		}
+
+#define MATERIALCOLOR(to, map)\
+		if (material->fbx.maps[map].has_value && material->fbx.maps[map].value_components > 0)\
+		{\
+			to ## Color = material->fbx.maps[map].value_vec4;\
+		}\
+		else\
+		{\
+			to ## Color = Vector4(1, 1, 1, 1);\
+		}
+
+#define MATERIALTEXTURE(to, map)\
+		if (material->fbx.maps[map].has_value && material->fbx.maps[map].texture != nullptr)\
+		{\
+			ufbx_texture *texture = material->fbx.maps[map].texture; \
+			const ufbx_string &fileName = texture->filename; \
+			\
+			if(fileName.length > 0)\
+			{\
+				to ## Texture = strings.Add(fileName); \
+			}\
+			\
+			int32_t textureIndex = textures.Add(texture); \
+			\
+			if(textureIndex >= 0)\
+			{\
+				to ## TextureIndex = textureIndex; \
+			}\
+			\
+			to ## WrapU = UFBXWrapToStapleWrap(texture->wrap_u); \
+			to ## WrapV = UFBXWrapToStapleWrap(texture->wrap_v); \
+		}
+
+#define MATERIALPBRCOLOR(to, map)\
+		if (material->pbr.maps[map].has_value && material->pbr.maps[map].value_components > 0)\
+		{\
+			to ## Color = material->pbr.maps[map].value_vec4; \
+		}\
+		else\
+		{\
+			to ## Color = Vector4(1, 1, 1, 1);\
+		}
+
+#define MATERIALPBRTEXTURE(to, map)\
+		if (material->pbr.maps[map].has_value && material->pbr.maps[map].texture != nullptr)\
+		{\
+			ufbx_texture *texture = material->pbr.maps[map].texture; \
+			const ufbx_string &fileName = texture->filename; \
+			\
+			if(fileName.length > 0)\
+			{\
+				to ## Texture = strings.Add(fileName); \
+			}\
+			\
+			int32_t textureIndex = textures.Add(texture); \
+			\
+			if(textureIndex >= 0)\
+			{\
+				to ## TextureIndex = textureIndex; \
+			}\
+			\
+			to ## WrapU = UFBXWrapToStapleWrap(texture->wrap_u); \
+			to ## WrapV = UFBXWrapToStapleWrap(texture->wrap_v); \
+		}
+
+#define DOMATERIAL(to, map)\
+		MATERIALCOLOR(to, map);\
+		\
+		MATERIALTEXTURE(to, map);
+
+#define DOPBRMATERIAL(to, map)\
+		MATERIALPBRCOLOR(to, map);\
+		\
+		MATERIALPBRTEXTURE(to, map);
+
+		DOMATERIAL(diffuse, UFBX_MATERIAL_FBX_DIFFUSE_COLOR);
+		DOMATERIAL(specular, UFBX_MATERIAL_FBX_SPECULAR_COLOR);
+		DOMATERIAL(reflection, UFBX_MATERIAL_FBX_REFLECTION_COLOR);
+		DOMATERIAL(transparency, UFBX_MATERIAL_FBX_TRANSPARENCY_COLOR);
+		DOMATERIAL(emission, UFBX_MATERIAL_FBX_EMISSION_COLOR);
+		DOMATERIAL(ambient, UFBX_MATERIAL_FBX_AMBIENT_COLOR);
+		DOMATERIAL(normalMap, UFBX_MATERIAL_FBX_NORMAL_MAP);
+		DOMATERIAL(bump, UFBX_MATERIAL_FBX_BUMP);
+		DOMATERIAL(displacement, UFBX_MATERIAL_FBX_DISPLACEMENT);
+		DOMATERIAL(vectorDisplacement, UFBX_MATERIAL_FBX_VECTOR_DISPLACEMENT);
+		
+		DOPBRMATERIAL(diffuse, UFBX_MATERIAL_PBR_BASE_COLOR);
+		DOPBRMATERIAL(specular, UFBX_MATERIAL_PBR_SPECULAR_COLOR);
+		DOPBRMATERIAL(reflection, UFBX_MATERIAL_PBR_METALNESS);
+		DOPBRMATERIAL(transparency, UFBX_MATERIAL_PBR_OPACITY);
 		DOPBRMATERIAL(emission, UFBX_MATERIAL_PBR_EMISSION_COLOR);
 		DOPBRMATERIAL(ambient, UFBX_MATERIAL_PBR_AMBIENT_OCCLUSION);
 		DOPBRMATERIAL(normalMap, UFBX_MATERIAL_PBR_NORMAL_MAP);
 		DOPBRMATERIAL(displacement, UFBX_MATERIAL_PBR_DISPLACEMENT_MAP);
 
-#undef DOMATERIAL
-#undef DOPBRMATERIAL
-#undef MATERIALTEXTURE
-#undef MATERIALPBRTEXTURE
-#undef MATERIALCOLOR
-#undef MATERIALPBRCOLOR
-	}
-};
+#undef DOMATERIAL
+#undef DOPBRMATERIAL
+#undef MATERIALTEXTURE
+#undef MATERIALPBRTEXTURE
+#undef MATERIALCOLOR
+#undef MATERIALPBRCOLOR
+	}
+};
+
+class Vector3Key
+{
+public:
+	float time;
+	Vector3 value;
+
+	Vector3Key() : time(0)
+	{
+	}
+};
+
+class QuaternionKey
+{
+public:
+	float time;
+	Vector4 value;
+
+	QuaternionKey() : time(0)
+	{
+	}
+};
+
+class FloatKey
+{
+public:
+	float time;
+	float value;
+
+	FloatKey() : time(0), value(0)
+	{
+	}
+};
+
+//Weight of a blend channel over time, from 0 to 1
+class BlendShapeAnimation
+{
+public:
+	int32_t channelIndex;
+	FloatKey* weights;
+	int32_t weightCount;
+
+	BlendShapeAnimation() : channelIndex(-1), weights(nullptr), weightCount(0)
+	{
+	}
+};
+
+class NodeAnimation
+{
+public:
+
+	//Index into Scene::nodes. Channels are sorted by it and there's at most one per node.
+	int32_t nodeIndex;
+	Vector3Key* positions;
+	QuaternionKey* rotations;
+	Vector3Key* scales;
+
+	int32_t positionCount;
+	int32_t rotationCount;
+	int32_t scaleCount;
+
+	NodeAnimation() : nodeIndex(-1), positions(nullptr), rotations(nullptr), scales(nullptr),
+		positionCount(0), rotationCount(0), scaleCount(0)
+	{
+	}
+};
+
+class Animation
+{
+public:
+	String name;
+
+	float duration;
+
+	NodeAnimation* nodes;
+	int32_t nodeCount;
+
+	BlendShapeAnimation* blendShapes;
+	int32_t blendShapeCount;
+
+	Animation() : duration(0), nodes(nullptr), nodeCount(0), blendShapes(nullptr), blendShapeCount(0)
+	{
+	}
+
+	//Blend channel weights are baked as DeformPercent properties, from 0 to 100
+	void ReadBlendShapes(ufbx_baked_anim* bakedAnim, ufbx_anim_stack* stack, ufbx_scene* scene, Arena& arena)
+	{
+		auto FindWeights = [&](const ufbx_baked_element& element) -> const ufbx_baked_prop*
+		{
+			if (scene->elements[element.element_id]->type != UFBX_ELEMENT_BLEND_CHANNEL)
+			{
+				return nullptr;
+			}
+
+			for (size_t i = 0; i < element.props.count; i++)
+			{
+				if (strcmp(element.props[i].name.data, "DeformPercent") == 0)
+				{
+					return &element.props[i];
+				}
+			}
+
+			return nullptr;
+		};
+
+		for (size_t i = 0; i < bakedAnim->elements.count; i++)
+		{
+			if (FindWeights(bakedAnim->elements[i]) != nullptr)
+			{
+				blendShapeCount++;
+			}
+		}
+
+		blendShapes = arena.AllocateArray<BlendShapeAnimation>(blendShapeCount);
+
+		int32_t index = 0;
+
+		for (size_t i = 0; i < bakedAnim->elements.count && index < blendShapeCount; i++)
+		{
+			const ufbx_baked_element& element = bakedAnim->elements[i];
+			const ufbx_baked_prop* prop = FindWeights(element);
+
+			if (prop == nullptr)
+			{
+				continue;
+			}
+
+			BlendShapeAnimation& animation = blendShapes[index++];
+
+			animation.channelIndex = (int32_t)scene->elements[element.element_id]->typed_id;
+			animation.weightCount = (int32_t)prop->keys.count;
+			animation.weights = arena.AllocateUninitialized<FloatKey>(prop->keys.count);
+
+			for (size_t j = 0; j < prop->keys.count; j++)
+			{
+				animation.weights[j].time = (float)(prop->keys[j].time - stack->time_begin);
+				animation.weights[j].value = (float)(prop->keys[j].value.x / 100.0);
+			}
+		}
+	}
+
+	//Runs in parallel, so the name is left for Scene::ReadAnimations to add. Returns false if the stack couldn't be baked.
+	bool Read(ufbx_anim_stack* stack, ufbx_scene* scene, const ufbx_bake_opts& bakeOpts, Arena& arena)
+	{
+		ufbx_baked_anim* bakedAnim = ufbx_bake_anim(scene, stack->anim, &bakeOpts, NULL);
+
+		if (bakedAnim == nullptr)
+		{
+			return false;
+		}
+
+		duration = (float)bakedAnim->playback_duration;
+
+		nodeCount = (int32_t)bakedAnim->nodes.count;
+
+		nodes = arena.AllocateArray<NodeAnimation>(nodeCount);
+
+		//Channels follow the order of the scene's nodes, so importers can use the node index as is
+		std::vector<const ufbx_baked_node*> bakedNodes(nodeCount);
+
+		for (int32_t i = 0; i < nodeCount; i++)
+		{
+			bakedNodes[i] = &bakedAnim->nodes[i];
+		}
+
+		std::stable_sort(bakedNodes.begin(), bakedNodes.end(), [](const ufbx_baked_node* a, const ufbx_baked_node* b)
+		{
+			return a->typed_id < b->typed_id;
+		});
+
+		for (int32_t i = 0; i < nodeCount; i++)
+		{
+			const ufbx_baked_node* node = bakedNodes[i];
+			NodeAnimation& animatedNode = nodes[i];
+
+			animatedNode.nodeIndex = node->typed_id;
+
+			//Constant tracks only need one key, which holds for the whole animation
+			animatedNode.positionCount = node->constant_translation && node->translation_keys.count > 0 ? 1 : (int32_t)node->translation_keys.count;
+			animatedNode.rotationCount = node->constant_rotation && node->rotation_keys.count > 0 ? 1 : (int32_t)node->rotation_keys.count;
+			animatedNode.scaleCount = node->constant_scale && node->scale_keys.count > 0 ? 1 : (int32_t)node->scale_keys.count;
+
+			animatedNode.positions = arena.AllocateUninitialized<Vector3Key>(animatedNode.positionCount);
+			animatedNode.rotations = arena.AllocateUninitialized<QuaternionKey>(animatedNode.rotationCount);
+			animatedNode.scales = arena.AllocateUninitialized<Vector3Key>(animatedNode.scaleCount);
+
+			for (int32_t j = 0; j < animatedNode.positionCount; j++)
+			{
+				Vector3Key* key = &animatedNode.positions[j];
+				ufbx_baked_vec3* v = &node->translation_keys[j];
+
+				key->time = animatedNode.positionCount > 1 ? (float)(v->time - stack->time_begin) : 0;
+				key->value = v->value;
+			}
+
+			for (int32_t j = 0; j < animatedNode.rotationCount; j++)
+			{
+				QuaternionKey* key = &animatedNode.rotations[j];
+				ufbx_baked_quat* v = &node->rotation_keys[j];
+
+				key->time = animatedNode.rotationCount > 1 ? (float)(v->time - stack->time_begin) : 0;
+				key->value = v->value;
+			}
+
+			for (int32_t j = 0; j < animatedNode.scaleCount; j++)
+			{
+				Vector3Key* key = &animatedNode.scales[j];
+				ufbx_baked_vec3* v = &node->scale_keys[j];
+
+				key->time = animatedNode.scaleCount > 1 ? (float)(v->time - stack->time_begin) : 0;
+				key->value = v->value;
+			}
+		}
+
+		ReadBlendShapes(bakedAnim, stack, scene, arena);
+
+		ufbx_free_baked_anim(bakedAnim);
+
+		return true;
+	}
+};
+
+class LODLevel
+{
+public:
+	//Distance the level starts at in meters, or the screen size percentage it starts at if LODGroup::relativeDistances is set
+	float distance;
+
+	//Child of the group that holds this level, or -1 if the group has fewer children than levels
+	int32_t nodeIndex;
+
+	//Meshes of the level's node and every node below it
+	int32_t* meshIndices;
+	int32_t meshCount;
+
+	LODLevel() : distance(0), nodeIndex(-1), meshIndices(nullptr), meshCount(0)
+	{
+	}
+};
+
+//A node whose children are levels of detail of the same object, only one of them should be shown at a time
+class LODGroup
+{
+public:
+	int32_t nodeIndex;
+
+	bool relativeDistances;
+
+	//Whether the whole group is hidden outside of the distance limits
+	bool useDistanceLimit;
+	float distanceLimitMin;
+	float distanceLimitMax;
+
+	LODLevel* levels;
+	int32_t levelCount;
+
+	LODGroup() : nodeIndex(-1), relativeDistances(false), useDistanceLimit(false), distanceLimitMin(0), distanceLimitMax(0),
+		levels(nullptr), levelCount(0)
+	{
+	}
+};
+
+class Scene
+{
+public:
+	Node* nodes;
+
+	int32_t nodeCount;
+
+	Mesh* meshes;
+
+	int32_t meshCount;
+
+	Material* materials;
+
+	int32_t materialCount;
+
+	Animation* animations;
+
+	int32_t animationCount;
+
+	//UTF-8 data referenced by every String of the scene
+	const char* strings;
+
+	int32_t stringsLength;
+
+	LODGroup* lodGroups;
+
+	int32_t lodGroupCount;
+
+	//Textures referenced by Material::diffuseTextureIndex and the other texture indices
+	Texture* textures;
+
+	int32_t textureCount;
+
+	//Owns every array of the scene, released in one go by UFBXFreeScene
+	Arena* arena;
+
+	Scene() : nodes(nullptr), nodeCount(0),
+		meshes(nullptr), meshCount(0),
+		materials(nullptr), materialCount(0),
+		animations(nullptr), animationCount(0),
+		strings(nullptr), stringsLength(0),
+		lodGroups(nullptr), lodGroupCount(0), textures(nullptr), textureCount(0), arena(new Arena()) {}
+
+	~Scene()
+	{
+		delete arena;
+	}
+
+	Scene(const Scene&) = delete;
+	Scene& operator=(const Scene&) = delete;
+
+	//Every material part is extracted independently, then merged in node/part order so the result
+	//doesn't depend on the amount of threads used. Returns false if the import was cancelled.
+	bool ReadMeshes(ufbx_scene* scene, const SceneLoadOptions& options, StringPool& strings, ImportProgressTracker& progress)
+	{
+		class MeshPartJob
+		{
+		public:
+			int32_t nodeIndex;
+			size_t partIndex;
+			Mesh mesh;
+			bool valid;
+
+			MeshPartJob() : nodeIndex(-1), partIndex(0), valid(false)
+			{
+			}
+		};
+
+		size_t jobCount = 0;
+		size_t triangleCount = 0;
+
+		for (int32_t i = 0; i < nodeCount; i++)
+		{
+			ufbx_mesh* mesh = scene->nodes.data[i]->mesh;
+
+			if (mesh == nullptr)
+			{
+				continue;
+			}
+
+			for (size_t j = 0; j < mesh->material_parts.count; j++)
+			{
+				if (mesh->material_parts[j].num_triangles > 0)
+				{
+					jobCount++;
+					triangleCount += mesh->material_parts[j].num_triangles;
+				}
+			}
+		}
+
+		if (jobCount == 0)
+		{
+			return true;
+		}
+
+		progress.SetTotal(STAPLE_IMPORT_STAGE_MESHES, triangleCount);
+		progress.SetTotal(STAPLE_IMPORT_STAGE_INDICES, triangleCount * 3);
+
+		std::vector<MeshPartJob> jobs(jobCount);
+
+		size_t jobIndex = 0;
+
+		for (int32_t i = 0; i < nodeCount; i++)
+		{
+			ufbx_mesh* mesh = scene->nodes.data[i]->mesh;
+
+			if (mesh == nullptr)
+			{
+				continue;
+			}
+
+			for (size_t j = 0; j < mesh->material_parts.count; j++)
+			{
+				if (mesh->material_parts[j].num_triangles > 0)
+				{
+					jobs[jobIndex].nodeIndex = i;
+					jobs[jobIndex].partIndex = j;
+
+					jobIndex++;
+				}
+			}
+		}
+
+		{
+			TaskGroup group;
+
+			if (options.threadCount != 1 && jobCount > 1)
+			{
+				group.SetPool(ThreadPool::Shared());
+			}
+
+			size_t batchCount = options.threadCount > 0 && (size_t)options.threadCount < jobCount ? (size_t)options.threadCount : jobCount;
+
+			MeshPartJob* jobData = jobs.data();
+
+			for (size_t i = 0; i < batchCount; i++)
+			{
+				Arena* arena = this->arena;
+				const SceneLoadOptions* loadOptions = &options;
+				ImportProgressTracker* progressTracker = &progress;
+
+				group.Run([scene, arena, loadOptions, progressTracker, jobData, jobCount, batchCount, i]()
+				{
+					for (size_t j = i; j < jobCount && progressTracker->Cancelled() == false; j += batchCount)
+					{
+						MeshPartJob& job = jobData[j];
+
+						ufbx_node* node = scene->nodes.data[job.nodeIndex];
+
+						job.valid = Node::ReadMeshPart(node, node->mesh, job.partIndex, *loadOptions, job.mesh, *arena, *progressTracker);
+					}
+				});
+			}
+
+			group.Wait();
+		}
+
+		if (progress.Cancelled())
+		{
+			return false;
+		}
+
+		meshCount = 0;
+
+		for (size_t i = 0; i < jobCount; i++)
+		{
+			if (jobs[i].valid)
+			{
+				meshCount++;
+			}
+		}
+
+		if (meshCount == 0)
+		{
+			return true;
+		}
+
+		meshes = arena->AllocateUninitialized<Mesh>(meshCount);
+
+		int32_t meshIndex = 0;
+
+		jobIndex = 0;
+
+		for (int32_t i = 0; i < nodeCount; i++)
+		{
+			int32_t firstMesh = meshIndex;
+
+			for (; jobIndex < jobCount && jobs[jobIndex].nodeIndex == i; jobIndex++)
+			{
+				if (jobs[jobIndex].valid)
+				{
+					//Only the stream pointers are copied, the data stays in place
+					Mesh& mesh = meshes[meshIndex++];
+
+					mesh = jobs[jobIndex].mesh;
+
+					//Strings are added here rather than by the jobs so their offsets don't depend on thread scheduling
+					mesh.name = strings.Add(scene->nodes.data[i]->name);
+
+					for (int32_t j = 0; j < mesh.blendShapeCount; j++)
+					{
+						BlendShape& blendShape = mesh.blendShapes[j];
+
+						blendShape.name = strings.Add(scene->blend_channels[blendShape.channelIndex]->name);
+					}
+				}
+			}
+
+			if (meshIndex > firstMesh)
+			{
+				nodes[i].meshCount = meshIndex - firstMesh;
+				nodes[i].meshIndices = arena->AllocateUninitialized<int32_t>(nodes[i].meshCount);
+
+				for (int32_t j = 0; j < nodes[i].meshCount; j++)
+				{
+					nodes[i].meshIndices[j] = firstMesh + j;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void AddMeshIndices(ufbx_node* node, std::vector<int32_t>& meshIndices)
+	{
+		const Node& ownNode = nodes[node->typed_id];
+
+		meshIndices.insert(meshIndices.end(), ownNode.meshIndices, ownNode.meshIndices + ownNode.meshCount);
+
+		for (size_t i = 0; i < node->children.count; i++)
+		{
+			AddMeshIndices(node->children[i], meshIndices);
+		}
+	}
+
+	//Must run after the meshes are read. Level distances aren't affected by unit conversion in ufbx, so they're converted here.
+	void ReadLODGroups(ufbx_scene* scene)
+	{
+		for (size_t i = 0; i < scene->nodes.count; i++)
+		{
+			if (ufbx_as_lod_group(scene->nodes[i]->attrib) != nullptr)
+			{
+				lodGroupCount++;
+			}
+		}
+
+		if (lodGroupCount == 0)
+		{
+			return;
+		}
+
+		lodGroups = arena->AllocateArray<LODGroup>(lodGroupCount);
+
+		float unitScale = scene->settings.unit_meters > 0 ? (float)(scene->settings.original_unit_meters / scene->settings.unit_meters) : 1.0f;
+
+		std::vector<int32_t> meshIndices;
+
+		int32_t groupIndex = 0;
+
+		for (size_t i = 0; i < scene->nodes.count; i++)
+		{
+			ufbx_node* node = scene->nodes[i];
+			ufbx_lod_group* lod = ufbx_as_lod_group(node->attrib);
+
+			if (lod == nullptr)
+			{
+				continue;
+			}
+
+			LODGroup& group = lodGroups[groupIndex++];
+
+			group.nodeIndex = (int32_t)node->typed_id;
+			group.relativeDistances = lod->relative_distances;
+			group.useDistanceLimit = lod->use_distance_limit;
+			group.distanceLimitMin = (float)lod->distance_limit_min * unitScale;
+			group.distanceLimitMax = (float)lod->distance_limit_max * unitScale;
+			group.levelCount = (int32_t)lod->lod_levels.count;
+			group.levels = arena->AllocateArray<LODLevel>(group.levelCount);
+
+			for (int32_t j = 0; j < group.levelCount; j++)
+			{
+				LODLevel& level = group.levels[j];
+
+				level.distance = lod->relative_distances ? (float)lod->lod_levels[j].distance : (float)lod->lod_levels[j].distance * unitScale;
+
+				if ((size_t)j >= node->children.count)
+				{
+					continue;
+				}
+
+				ufbx_node* child = node->children[j];
+
+				level.nodeIndex = (int32_t)child->typed_id;
+
+				meshIndices.clear();
+
+				AddMeshIndices(child, meshIndices);
+
+				level.meshCount = (int32_t)meshIndices.size();
+				level.meshIndices = arena->Duplicate(meshIndices.data(), meshIndices.size());
+			}
+		}
+	}
+
+	//Stacks are baked in parallel, each into its own slot. Returns false if the import was cancelled.
+	bool ReadAnimations(ufbx_scene* scene, const SceneLoadOptions& options, StringPool& strings, ImportProgressTracker& progress)
+	{
+		animationCount = (int32_t)scene->anim_stacks.count;
+
+		if (animationCount == 0)
+		{
+			return true;
+		}
+
+		animations = arena->AllocateArray<Animation>(animationCount);
+
+		progress.SetTotal(STAPLE_IMPORT_STAGE_ANIMATIONS, animationCount);
+
+		ufbx_bake_opts bakeOpts;
+
+		memset(&bakeOpts, 0, sizeof(bakeOpts));
+
+		bakeOpts.resample_rate = options.animationSampleRate;
+		bakeOpts.minimum_sample_rate = options.animationMinimumSampleRate;
+		bakeOpts.maximum_sample_rate = options.animationMaximumSampleRate;
+		bakeOpts.key_reduction_enabled = options.animationKeyReduction;
+		bakeOpts.key_reduction_threshold = options.animationKeyReductionThreshold;
+		bakeOpts.max_keyframe_segments = options.animationMaxKeyframeSegments > 0 ? (size_t)options.animationMaxKeyframeSegments : 0;
+
+		size_t stackCount = (size_t)animationCount;
+
+		std::vector<uint8_t> baked(stackCount);
+
+		{
+			TaskGroup group;
+
+			if (options.threadCount != 1 && animationCount > 1)
+			{
+				group.SetPool(ThreadPool::Shared());
+			}
+
+			size_t batchCount = options.threadCount > 0 && (size_t)options.threadCount < stackCount ? (size_t)options.threadCount : stackCount;
+
+			for (size_t i = 0; i < batchCount; i++)
+			{
+				Animation* animationData = animations;
+				Arena* arena = this->arena;
+				uint8_t* bakedData = baked.data();
+				const ufbx_bake_opts* bakeOptions = &bakeOpts;
+				ImportProgressTracker* progressTracker = &progress;
+
+				group.Run([scene, animationData, arena, bakedData, bakeOptions, progressTracker, stackCount, batchCount, i]()
+				{
+					for (size_t j = i; j < stackCount; j += batchCount)
+					{
+						bakedData[j] = animationData[j].Read(scene->anim_stacks[j], scene, *bakeOptions, *arena) ? 1 : 0;
+
+						if (progressTracker->Add(STAPLE_IMPORT_STAGE_ANIMATIONS, 1) == false)
+						{
+							break;
+						}
+					}
+				});
+			}
+
+			group.Wait();
+		}
+
+		if (progress.Cancelled())
+		{
+			return false;
+		}
+
+		//Added in stack order once the jobs are done so string offsets don't depend on thread scheduling
+		for (size_t i = 0; i < stackCount; i++)
+		{
+			if (baked[i])
+			{
+				animations[i].name = strings.Add(scene->anim_stacks[i]->name);
+			}
+		}
+
+		return true;
+	}
+
+	//Returns false if the import was cancelled, in which case the scene is incomplete and must be freed
+	bool Read(ufbx_scene* scene, const SceneLoadOptions& options, ImportProgressTracker& progress)
+	{
+		nodeCount = (int32_t)scene->nodes.count;
+
+		nodes = arena->AllocateArray<Node>(nodeCount);
+
+		StringPool stringPool;
+
+		for (int32_t i = 0; i < nodeCount; i++)
+		{
+			nodes[i].Read(scene, scene->nodes.data[i], stringPool);
+		}
+
+		if (ReadMeshes(scene, options, stringPool, progress) == false)
+		{
+			return false;
+		}
+
+		ReadLODGroups(scene);
+
+		materialCount = (int32_t)scene->materials.count;
+
+		if (materialCount > 0)
+		{
+			materials = arena->AllocateArray<Material>(materialCount);
+
+			TextureTable textureTable(*arena, stringPool);
+
+			for (int32_t i = 0; i < materialCount; i++)
+			{
+				materials[i].Read(scene->materials[i], stringPool, textureTable);
+			}
+
+			textureCount = (int32_t)textureTable.textures.size();
+			textures = arena->Duplicate(textureTable.textures.data(), textureTable.textures.size());
+		}
+
+		if (ReadAnimations(scene, options, stringPool, progress) == false)
+		{
+			return false;
+		}
+
+		stringsLength = (int32_t)stringPool.Data().size();
+		strings = arena->Duplicate(stringPool.Data().data(), stringPool.Data().size());
+
+		return true;
+	}
+};
+
+class UFBXThreadPoolState
+{
+public:
+	ThreadPool* pool;
+	uint32_t maxConcurrentTasks;
+	TaskGroup groups[UFBX_THREAD_GROUP_COUNT];
+
+	UFBXThreadPoolState(ThreadPool& pool, uint32_t maxConcurrentTasks) : pool(&pool), maxConcurrentTasks(maxConcurrentTasks)
+	{
+		for (uint32_t i = 0; i < UFBX_THREAD_GROUP_COUNT; i++)
+		{
+			groups[i].SetPool(pool);
+		}
+	}
+};
+
+static void UFBXThreadPoolRun(void* user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t startIndex, uint32_t count)
+{
+	UFBXThreadPoolState* state = (UFBXThreadPoolState*)user;
+
+	uint32_t batchCount = count < state->maxConcurrentTasks ? count : state->maxConcurrentTasks;
+
+	for (uint32_t i = 0; i < batchCount; i++)
+	{
+		state->groups[group].Run([ctx, startIndex, count, batchCount, i]()
+		{
+			for (uint32_t j = i; j < count; j += batchCount)
+			{
+				ufbx_thread_pool_run_task(ctx, startIndex + j);
+			}
+		});
+	}
+}
+
+static void UFBXThreadPoolWait(void* user, ufbx_thread_pool_context, uint32_t group, uint32_t)
+{
+	UFBXThreadPoolState* state = (UFBXThreadPoolState*)user;
+
+	state->groups[group].Wait();
+}
+
+static ufbx_progress_result UFBXProgress(void* user, const ufbx_progress* progress)
+{
+	ImportProgressTracker* tracker = (ImportProgressTracker*)user;
+
+	tracker->Set(STAPLE_IMPORT_STAGE_PARSE, progress->bytes_read, progress->bytes_total);
+
+	return tracker->Report(STAPLE_IMPORT_STAGE_PARSE) ? UFBX_PROGRESS_CONTINUE : UFBX_PROGRESS_CANCEL;
+}
+
+//Conversions every import uses, so all scenes come out in the engine's coordinate space
+static void InitLoadOptions(ufbx_load_opts& opts)
+{
+	memset(&opts, 0, sizeof(opts));
+
+	opts.load_external_files = true;
+	opts.ignore_missing_external_files = true;
+	opts.generate_missing_normals = true;
+
+	opts.target_axes = ufbx_axes_left_handed_y_up;
+
+	opts.handedness_conversion_axis = UFBX_MIRROR_AXIS_X;
+
+	opts.target_unit_meters = 1.0f;
+
+	opts.space_conversion = UFBX_SPACE_CONVERSION_MODIFY_GEOMETRY;
+
+	opts.obj_search_mtl_by_filename = true;
+}
+
+//Data source provided by the caller, with the same callbacks as ufbx_stream
+class SceneStream
+{
+public:
+	//Reads up to `size` bytes and returns the amount read, or SIZE_MAX on error
+	size_t (*read)(void* user, void* data, size_t size);
+
+	//Optional, reads are used to skip data if missing
+	bool (*skip)(void* user, size_t size);
+
+	//Optional, returns 0 if unknown
+	uint64_t (*size)(void* user);
+
+	//Optional, called once ufbx is done with the stream
+	void (*close)(void* user);
+
+	void* user;
+};
+
+//Lets the caller resolve files referenced by a scene, such as the .mtl files of an OBJ, without going through the disk
+class SceneFileSystem
+{
+public:
+	//Fills `stream` for `path` and returns true, or returns false if the file doesn't exist
+	bool (*open)(void* user, const char* path, int32_t pathLength, SceneStream* stream);
+
+	void* user;
+};
+
+static bool UFBXOpenFile(void* user, ufbx_stream* stream, const char* path, size_t pathLength, const ufbx_open_file_info*)
+{
+	const SceneFileSystem* fileSystem = (const SceneFileSystem*)user;
+
+	SceneStream sceneStream;
+
+	memset(&sceneStream, 0, sizeof(sceneStream));
+
+	if (fileSystem->open(fileSystem->user, path, (int32_t)pathLength, &sceneStream) == false || sceneStream.read == nullptr)
+	{
+		return false;
+	}
+
+	stream->read_fn = sceneStream.read;
+	stream->skip_fn = sceneStream.skip;
+	stream->size_fn = sceneStream.size;
+	stream->close_fn = sceneStream.close;
+	stream->user = sceneStream.user;
+
+	return true;
+}
+
+//Sets up parsing on the shared pool and converts the result. `load` calls the ufbx_load_* function for the source.
+//`fileName` is optional for memory and stream sources, it's used to detect the format and resolve external files.
+template<typename Loader>
+static Scene* LoadScene(const SceneLoadOptions* options, const char* fileName, const SceneFileSystem* fileSystem, Loader load)
+{
+	SceneLoadOptions defaultOptions;
+
+	if (options == nullptr)
+	{
+		options = &defaultOptions;
+	}
+
+	ufbx_load_opts opts;
+
+	InitLoadOptions(opts);
+
+	if (fileName != nullptr)
+	{
+		opts.filename.data = fileName;
+		opts.filename.length = strlen(fileName);
+	}
+
+	if (fileSystem != nullptr && fileSystem->open != nullptr)
+	{
+		opts.open_file_cb.fn = UFBXOpenFile;
+		opts.open_file_cb.user = (void*)fileSystem;
+	}
+
+	ImportProgressTracker progress(*options);
+
+	if (options->progressCallback != nullptr)
+	{
+		opts.progress_cb.fn = UFBXProgress;
+		opts.progress_cb.user = &progress;
+	}
+
+	ThreadPool& pool = ThreadPool::Shared();
+
+	uint32_t threadCount = options->threadCount > 0 ? (uint32_t)options->threadCount : pool.ThreadCount();
+
+	UFBXThreadPoolState threadState(pool, threadCount);
+
+	if (threadCount > 1)
+	{
+		opts.thread_opts.pool.run_fn = UFBXThreadPoolRun;
+		opts.thread_opts.pool.wait_fn = UFBXThreadPoolWait;
+		opts.thread_opts.pool.user = &threadState;
+	}
+
+	ufbx_error error;
+
+	ufbx_scene* scene = load(opts, error);
+
+	if (scene == nullptr)
+	{
+		if (error.type != UFBX_ERROR_CANCELLED)
+		{
+			PrintError(&error, "Failed to load scene");
+		}
+
+		return nullptr;
+	}
+
+	//ufbx stops reporting before the end of the file
+	if (progress.Complete(STAPLE_IMPORT_STAGE_PARSE) == false)
+	{
+		ufbx_free_scene(scene);
+
+		return nullptr;
+	}
+
+	//Everything built so far lives in the scene's arena, so a cancelled import is released in one go
+	Scene* ownScene = new Scene();
+
+	bool completed = ownScene->Read(scene, *options, progress);
+
+	ufbx_free_scene(scene);
+
+	if (completed == false)
+	{
+		delete ownScene;
+
+		return nullptr;
+	}
+
+	return ownScene;
+}
+
+CEXPORT Scene* UFBXLoadSceneWithOptions(const char* fileName, const SceneLoadOptions* options)
+{
+	return LoadScene(options, nullptr, nullptr, [fileName](const ufbx_load_opts& opts, ufbx_error& error)
+	{
+		return ufbx_load_file(fileName, &opts, &error);
+	});
+}
+
+//The data isn't copied and must stay valid until this returns
+CEXPORT Scene* UFBXLoadSceneFromMemory(const void* data, size_t size, const char* fileName, const SceneLoadOptions* options,
+	const SceneFileSystem* fileSystem)
+{
+	return LoadScene(options, fileName, fileSystem, [data, size](const ufbx_load_opts& opts, ufbx_error& error)
+	{
+		return ufbx_load_memory(data, size, &opts, &error);
+	});
+}
+
+//The stream is closed before this returns
+CEXPORT Scene* UFBXLoadSceneFromStream(const SceneStream* stream, const char* fileName, const SceneLoadOptions* options,
+	const SceneFileSystem* fileSystem)
+{
+	if (stream == nullptr || stream->read == nullptr)
+	{
+		return nullptr;
+	}
+
+	ufbx_stream ufbxStream;
+
+	memset(&ufbxStream, 0, sizeof(ufbxStream));
+
+	ufbxStream.read_fn = stream->read;
+	ufbxStream.skip_fn = stream->skip;
+	ufbxStream.size_fn = stream->size;
+	ufbxStream.close_fn = stream->close;
+	ufbxStream.user = stream->user;
+
+	return LoadScene(options, fileName, fileSystem, [&ufbxStream](const ufbx_load_opts& opts, ufbx_error& error)
+	{
+		return ufbx_load_stream(&ufbxStream, &opts, &error);
+	});
+}
+
+CEXPORT Scene* UFBXLoadScene(const char* fileName)
+{
+	return UFBXLoadSceneWithOptions(fileName, nullptr);
+}
+
+CEXPORT int32_t UFBXABIVersion()
+{
+	return UFBX_ABI_VERSION;
+}
+
+CEXPORT void UFBXFreeScene(Scene* ptr)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	delete ptr;
+}
+
+//Called once for every file of a batch as soon as it's done, from any thread and possibly at the same time for different files.
+//`scene` is null if the file failed to load, otherwise it belongs to the caller and must be freed with UFBXFreeScene.
+typedef void (*SceneBatchCallback)(void* user, int32_t index, Scene* scene);
+
+//Files at least this big keep splitting their own work across the pool, smaller ones are loaded on a single thread each
+#define UFBX_BATCH_LARGE_FILE_SIZE (16 * 1024 * 1024)
+
+static uint64_t BatchFileSize(const char* path)
+{
+	FILE* fp = fopen(path, "rb");
+
+	if (fp == nullptr)
+	{
+		return 0;
+	}
+
+	int64_t size = FileSize(fp);
+
+	fclose(fp);
+
+	return size > 0 ? (uint64_t)size : 0;
+}
+
+//Loads `count` files on the shared pool and returns once every callback ran. `options` has one entry per file, or is null for defaults.
+//Files start from the biggest so a large one doesn't end up running alone at the end. Only one worker per pool thread picks files,
+//so the jobs of a large file aren't queued behind the rest of the batch.
+CEXPORT void UFBXLoadScenes(const char* const* fileNames, const SceneLoadOptions* options, int32_t count, SceneBatchCallback callback,
+	void* user)
+{
+	if (fileNames == nullptr || count <= 0 || callback == nullptr)
+	{
+		return;
+	}
+
+	std::vector<uint64_t> sizes((size_t)count);
+	std::vector<int32_t> order((size_t)count);
+
+	for (int32_t i = 0; i < count; i++)
+	{
+		sizes[i] = fileNames[i] != nullptr ? BatchFileSize(fileNames[i]) : 0;
+		order[i] = i;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&sizes](int32_t a, int32_t b)
+	{
+		return sizes[a] > sizes[b];
+	});
+
+	ThreadPool& pool = ThreadPool::Shared();
+
+	std::atomic<int32_t> next(0);
+
+	auto worker = [&]()
+	{
+		for (;;)
+		{
+			int32_t position = next.fetch_add(1);
+
+			if (position >= count)
+			{
+				return;
+			}
+
+			int32_t index = order[position];
+
+			SceneLoadOptions fileOptions = options != nullptr ? options[index] : SceneLoadOptions();
+
+			if (sizes[index] < UFBX_BATCH_LARGE_FILE_SIZE)
+			{
+				fileOptions.threadCount = 1;
+			}
+
+			Scene* scene = fileNames[index] != nullptr ? UFBXLoadSceneWithOptions(fileNames[index], &fileOptions) : nullptr;
+
+			callback(user, index, scene);
+		}
+	};
+
+	uint32_t workerCount = pool.ThreadCount() < (uint32_t)count ? pool.ThreadCount() : (uint32_t)count;
+
+	TaskGroup group(pool);
+
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		group.Run(worker);
+	}
+
+	group.Wait();
+}
+
+//Bumped whenever the extracted data changes without the ABI changing, so stale scene caches are rebuilt
+#define UFBX_SCENE_CACHE_VERSION 2
+
+#define UFBX_SCENE_CACHE_MAGIC 0x43534653
+
+//Start of a scene cache file. Pointers are stored as offsets from the start of the file, 0 being null.
+class SceneCacheHeader
+{
+public:
+	uint32_t magic;
+	uint32_t abiVersion;
+	uint32_t pointerSize;
+	uint32_t cacheVersion;
+	uint64_t key;
+	uint64_t size;
+
+	Node* nodes;
+	int32_t nodeCount;
+	Mesh* meshes;
+	int32_t meshCount;
+	Material* materials;
+	int32_t materialCount;
+	Animation* animations;
+	int32_t animationCount;
+	const char* strings;
+	int32_t stringsLength;
+	LODGroup* lodGroups;
+	int32_t lodGroupCount;
+	Texture* textures;
+	int32_t textureCount;
+
+	SceneCacheHeader() : magic(UFBX_SCENE_CACHE_MAGIC), abiVersion(UFBX_ABI_VERSION), pointerSize(sizeof(void*)),
+		cacheVersion(UFBX_SCENE_CACHE_VERSION), key(0), size(0), nodes(nullptr), nodeCount(0), meshes(nullptr), meshCount(0),
+		materials(nullptr), materialCount(0), animations(nullptr), animationCount(0), strings(nullptr), stringsLength(0),
+		lodGroups(nullptr), lodGroupCount(0), textures(nullptr), textureCount(0)
+	{
+	}
+};
+
+//Flattens a scene into a single buffer. Arrays without pointers (streams, indices, bones, keys) are deduplicated,
+//arrays of structs are copied with their pointers replaced by offsets.
+class SceneCacheWriter
+{
+public:
+	std::vector<uint8_t> data;
+
+	SceneCacheWriter() : data(sizeof(SceneCacheHeader))
+	{
+	}
+
+	template<typename T>
+	T* Write(const T* ptr, size_t count, bool deduplicate = true)
+	{
+		size_t size = sizeof(T) * count;
+
+		if (ptr == nullptr || size == 0)
+		{
+			return nullptr;
+		}
+
+		uint64_t hash = 0;
+
+		if (deduplicate)
+		{
+			hash = HashBytes(ptr, size);
+
+			auto range = blobs.equal_range(hash);
+
+			for (auto it = range.first; it != range.second; it++)
+			{
+				if (it->second.size == size && memcmp(data.data() + it->second.offset, ptr, size) == 0)
+				{
+					return (T*)(uintptr_t)it->second.offset;
+				}
+			}
+		}
+
+		size_t offset = (data.size() + 15) & ~(size_t)15;
+
+		data.resize(offset + size);
+
+		memcpy(data.data() + offset, (const void*)ptr, size);
+
+		if (deduplicate)
+		{
+			Blob blob;
+
+			blob.offset = offset;
+			blob.size = size;
+
+			blobs.emplace(hash, blob);
+		}
+
+		return (T*)(uintptr_t)offset;
+	}
+
+	//Byte copies of `count` structs whose pointers are about to be replaced
+	template<typename T>
+	static std::vector<T> Copy(const T* ptr, size_t count)
+	{
+		std::vector<T> outValue(count);
+
+		if (count > 0)
+		{
+			memcpy((void*)outValue.data(), (const void*)ptr, sizeof(T) * count);
+		}
+
+		return outValue;
+	}
+
+	void Write(const Scene* scene, uint64_t key)
+	{
+		SceneCacheHeader header;
+
+		header.key = key;
+
+		std::vector<Node> nodes = Copy(scene->nodes, scene->nodeCount);
+
+		for (auto& node : nodes)
+		{
+			node.meshIndices = Write(node.meshIndices, node.meshCount);
+		}
+
+		header.nodes = Write(nodes.data(), nodes.size(), false);
+		header.nodeCount = scene->nodeCount;
+
+		std::vector<Mesh> meshes = Copy(scene->meshes, scene->meshCount);
+
+		for (auto& mesh : meshes)
+		{
+			size_t vertexCount = (size_t)mesh.vertexCount;
+
+			Vector3** vector3Streams[] = { &mesh.vertices, &mesh.normals, &mesh.tangents, &mesh.bitangents };
+			Vector2** vector2Streams[] = { &mesh.uv0, &mesh.uv1, &mesh.uv2, &mesh.uv3, &mesh.uv4, &mesh.uv5, &mesh.uv6, &mesh.uv7 };
+			Vector4** vector4Streams[] = { &mesh.color0, &mesh.color1, &mesh.color2, &mesh.color3,
+				&mesh.boneIndices, &mesh.boneWeights, &mesh.boneIndices1, &mesh.boneWeights1 };
+
+			for (auto stream : vector3Streams)
+			{
+				*stream = Write(*stream, vertexCount);
+			}
+
+			for (auto stream : vector2Streams)
+			{
+				*stream = Write(*stream, vertexCount);
+			}
+
+			for (auto stream : vector4Streams)
+			{
+				*stream = Write(*stream, vertexCount);
+			}
+
+			mesh.indices = Write(mesh.indices, mesh.indexCount);
+			mesh.bones = Write(mesh.bones, mesh.boneCount);
+			mesh.interleavedVertices = Write(mesh.interleavedVertices, vertexCount * mesh.vertexStride / sizeof(float));
+			mesh.skinIndices = Write((const uint8_t*)mesh.skinIndices, vertexCount * mesh.skinInfluenceCount * mesh.skinIndexSize);
+			mesh.skinWeights = Write(mesh.skinWeights, vertexCount * mesh.skinInfluenceCount);
+
+			std::vector<BlendShape> blendShapes = Copy(mesh.blendShapes, mesh.blendShapeCount);
+
+			for (auto& blendShape : blendShapes)
+			{
+				blendShape.vertexIndices = Write(blendShape.vertexIndices, blendShape.deltaCount);
+				blendShape.positionDeltas = Write(blendShape.positionDeltas, blendShape.deltaCount);
+				blendShape.normalDeltas = Write(blendShape.normalDeltas, blendShape.deltaCount);
+			}
+
+			mesh.blendShapes = Write(blendShapes.data(), blendShapes.size(), false);
+			mesh.meshlets = Write(mesh.meshlets, mesh.meshletCount, false);
+			mesh.meshletVertices = Write(mesh.meshletVertices, mesh.meshletVertexCount);
+			mesh.meshletTriangles = Write(mesh.meshletTriangles, mesh.meshletTriangleIndexCount);
+
+			int16_t** quantizedDirections[] = { &mesh.quantizedNormals, &mesh.quantizedTangents, &mesh.quantizedBitangents };
+			uint16_t** quantizedUVs[] = { &mesh.quantizedUV0, &mesh.quantizedUV1, &mesh.quantizedUV2, &mesh.quantizedUV3,
+				&mesh.quantizedUV4, &mesh.quantizedUV5, &mesh.quantizedUV6, &mesh.quantizedUV7 };
+			uint8_t** quantizedColors[] = { &mesh.quantizedColor0, &mesh.quantizedColor1, &mesh.quantizedColor2, &mesh.quantizedColor3 };
+
+			mesh.quantizedPositions = Write(mesh.quantizedPositions, vertexCount * 4);
+
+			for (auto stream : quantizedDirections)
+			{
+				*stream = Write(*stream, vertexCount * 2);
+			}
+
+			for (auto stream : quantizedUVs)
+			{
+				*stream = Write(*stream, vertexCount * 2);
+			}
+
+			for (auto stream : quantizedColors)
+			{
+				*stream = Write(*stream, vertexCount * 4);
+			}
+		}
+
+		header.meshes = Write(meshes.data(), meshes.size(), false);
+		header.meshCount = scene->meshCount;
+
+		header.materials = Write(scene->materials, scene->materialCount, false);
+		header.materialCount = scene->materialCount;
+
+		std::vector<Animation> animations = Copy(scene->animations, scene->animationCount);
+
+		for (auto& animation : animations)
+		{
+			std::vector<NodeAnimation> nodeAnimations = Copy(animation.nodes, animation.nodeCount);
+
+			for (auto& nodeAnimation : nodeAnimations)
+			{
+				nodeAnimation.positions = Write(nodeAnimation.positions, nodeAnimation.positionCount);
+				nodeAnimation.rotations = Write(nodeAnimation.rotations, nodeAnimation.rotationCount);
+				nodeAnimation.scales = Write(nodeAnimation.scales, nodeAnimation.scaleCount);
+			}
+
+			animation.nodes = Write(nodeAnimations.data(), nodeAnimations.size(), false);
+
+			std::vector<BlendShapeAnimation> blendShapes = Copy(animation.blendShapes, animation.blendShapeCount);
+
+			for (auto& blendShape : blendShapes)
+			{
+				blendShape.weights = Write(blendShape.weights, blendShape.weightCount);
+			}
+
+			animation.blendShapes = Write(blendShapes.data(), blendShapes.size(), false);
+		}
+
+		header.animations = Write(animations.data(), animations.size(), false);
+		header.animationCount = scene->animationCount;
+
+		header.strings = Write(scene->strings, scene->stringsLength, false);
+		header.stringsLength = scene->stringsLength;
+
+		std::vector<LODGroup> lodGroups = Copy(scene->lodGroups, scene->lodGroupCount);
+
+		for (auto& lodGroup : lodGroups)
+		{
+			std::vector<LODLevel> levels = Copy(lodGroup.levels, lodGroup.levelCount);
+
+			for (auto& level : levels)
+			{
+				level.meshIndices = Write(level.meshIndices, level.meshCount);
+			}
+
+			lodGroup.levels = Write(levels.data(), levels.size(), false);
+		}
+
+		header.lodGroups = Write(lodGroups.data(), lodGroups.size(), false);
+		header.lodGroupCount = scene->lodGroupCount;
 
-class Vector3Key
-{
-public:
-	float time;
-	Vector3 value;
+		std::vector<Texture> textures = Copy(scene->textures, scene->textureCount);
 
-	Vector3Key() : time(0)
-	{
-	}
-};
+		for (auto& texture : textures)
+		{
+			texture.content = Write(texture.content, texture.contentSize);
+		}
 
-class QuaternionKey
-{
-public:
-	float time;
-	Vector4 value;
+		header.textures = Write(textures.data(), textures.size(), false);
+		header.textureCount = scene->textureCount;
 
-	QuaternionKey() : time(0)
-	{
+		header.size = data.size();
+
+		memcpy(data.data(), (const void*)&header, sizeof(header));
 	}
+
+private:
+	class Blob
+	{
+	public:
+		size_t offset;
+		size_t size;
+	};
+
+	std::unordered_multimap<uint64_t, Blob> blobs;
 };
 
-class NodeAnimation
+//Turns the offsets of a loaded cache back into pointers, checking that everything stays inside the file
+class SceneCacheReader
 {
 public:
+	uint8_t* data;
+	uint64_t size;
+	const char* strings;
+	int32_t stringsLength;
+	bool valid;
 
-	int32_t nodeIndex;
-	Vector3Key* positions;
-	QuaternionKey* rotations;
-	Vector3Key* scales;
-
-	int32_t positionCount;
-	int32_t rotationCount;
-	int32_t scaleCount;
-
-	NodeAnimation() : nodeIndex(-1), positions(nullptr), rotations(nullptr), scales(nullptr),
-		positionCount(0), rotationCount(0), scaleCount(0)
+	SceneCacheReader(uint8_t* data, uint64_t size) : data(data), size(size), strings(nullptr), stringsLength(0), valid(true)
 	{
 	}
 
-	~NodeAnimation()
+	//Optional arrays may be null even if `count` isn't 0, like the streams of attributes a mesh doesn't have
+	template<typename T>
+	void Relocate(T*& ptr, int64_t count, bool optional = false)
 	{
-		DELETE(positions);
-		DELETE(rotations);
-		DELETE(scales);
-	}
-};
+		uint64_t offset = (uint64_t)(uintptr_t)ptr;
 
-class Animation
-{
-public:
-	String name;
+		ptr = nullptr;
 
-	float duration;
+		if (offset == 0)
+		{
+			if (optional == false && count != 0)
+			{
+				valid = false;
+			}
 
-	NodeAnimation* nodes;
-	int32_t nodeCount;
+			return;
+		}
 
-	Animation() : duration(0), nodes(nullptr), nodeCount(0)
-	{
+		if (count <= 0 || offset % alignof(T) != 0 || offset >= size || (uint64_t)count > (size - offset) / sizeof(T))
+		{
+			valid = false;
+
+			return;
+		}
+
+		ptr = (T*)(data + offset);
 	}
 
-	~Animation()
+	void Check(const String& string)
 	{
-		DELETE(nodes);
+		if (string.offset < 0 || string.length < 0 || (int64_t)string.offset + string.length >= stringsLength ||
+			strings[string.offset + string.length] != '\0')
+		{
+			valid = false;
+		}
 	}
 
-	void Read(ufbx_anim_stack* stack, ufbx_scene* scene)
+	void Read(SceneCacheHeader& header)
 	{
-		ufbx_baked_anim* bakedAnim = ufbx_bake_anim(scene, stack->anim, NULL, NULL);
+		Relocate(header.strings, header.stringsLength);
 
-		if (bakedAnim == nullptr)
-		{
-			return;
-		}
+		strings = header.strings;
+		stringsLength = strings != nullptr ? header.stringsLength : 0;
 
-		duration = (float)bakedAnim->playback_duration;
+		Relocate(header.nodes, header.nodeCount);
 
-		name = String(stack->name.data, stack->name.length);
+		for (int32_t i = 0; valid && i < header.nodeCount; i++)
+		{
+			Node& node = header.nodes[i];
 
-		nodeCount = (int32_t)bakedAnim->nodes.count;
+			Check(node.name);
+			Relocate(node.meshIndices, node.meshCount);
+		}
 
-		nodes = new NodeAnimation[nodeCount];
+		Relocate(header.meshes, header.meshCount);
 
-		for (int32_t i = 0; i < nodeCount; i++)
+		for (int32_t i = 0; valid && i < header.meshCount; i++)
 		{
-			ufbx_baked_node* node = &bakedAnim->nodes[i];
-			NodeAnimation& animatedNode = nodes[i];
+			Mesh& mesh = header.meshes[i];
+
+			int64_t vertexCount = mesh.vertexCount;
+
+			valid = vertexCount >= 0;
+
+			Check(mesh.name);
+
+			Relocate(mesh.vertices, vertexCount, true);
+			Relocate(mesh.normals, vertexCount, true);
+			Relocate(mesh.tangents, vertexCount, true);
+			Relocate(mesh.bitangents, vertexCount, true);
+			Relocate(mesh.uv0, vertexCount, true);
+			Relocate(mesh.uv1, vertexCount, true);
+			Relocate(mesh.uv2, vertexCount, true);
+			Relocate(mesh.uv3, vertexCount, true);
+			Relocate(mesh.uv4, vertexCount, true);
+			Relocate(mesh.uv5, vertexCount, true);
+			Relocate(mesh.uv6, vertexCount, true);
+			Relocate(mesh.uv7, vertexCount, true);
+			Relocate(mesh.color0, vertexCount, true);
+			Relocate(mesh.color1, vertexCount, true);
+			Relocate(mesh.color2, vertexCount, true);
+			Relocate(mesh.color3, vertexCount, true);
+			Relocate(mesh.boneIndices, vertexCount, true);
+			Relocate(mesh.boneWeights, vertexCount, true);
+			Relocate(mesh.boneIndices1, vertexCount, true);
+			Relocate(mesh.boneWeights1, vertexCount, true);
+			Relocate(mesh.indices, mesh.indexCount);
+			Relocate(mesh.bones, mesh.boneCount);
+			Relocate(mesh.interleavedVertices, vertexCount * mesh.vertexStride / (int64_t)sizeof(float), true);
+
+			uint8_t* skinIndices = (uint8_t*)mesh.skinIndices;
+
+			Relocate(skinIndices, vertexCount * mesh.skinInfluenceCount * mesh.skinIndexSize, true);
+
+			mesh.skinIndices = skinIndices;
+
+			Relocate(mesh.skinWeights, vertexCount * mesh.skinInfluenceCount, true);
+			Relocate(mesh.blendShapes, mesh.blendShapeCount);
+
+			for (int32_t j = 0; valid && j < mesh.blendShapeCount; j++)
+			{
+				BlendShape& blendShape = mesh.blendShapes[j];
 
-			animatedNode.nodeIndex = node->typed_id;
+				Check(blendShape.name);
+				Relocate(blendShape.vertexIndices, blendShape.deltaCount);
+				Relocate(blendShape.positionDeltas, blendShape.deltaCount);
+				Relocate(blendShape.normalDeltas, blendShape.deltaCount, true);
+
+				for (int32_t k = 0; valid && blendShape.vertexIndices != nullptr && k < blendShape.deltaCount; k++)
+				{
+					valid = blendShape.vertexIndices[k] < (uint32_t)vertexCount;
+				}
+			}
 
-			animatedNode.positionCount = (int32_t)node->translation_keys.count;
-			animatedNode.rotationCount = (int32_t)node->rotation_keys.count;
-			animatedNode.scaleCount = (int32_t)node->scale_keys.count;
+			for (int32_t j = 0; valid && mesh.indices != nullptr && j < mesh.indexCount; j++)
+			{
+				valid = mesh.indices[j] < (uint32_t)vertexCount;
+			}
 
-			animatedNode.positions = new Vector3Key[animatedNode.positionCount];
-			animatedNode.rotations = new QuaternionKey[animatedNode.rotationCount];
-			animatedNode.scales = new Vector3Key[animatedNode.scaleCount];
+			Relocate(mesh.meshlets, mesh.meshletCount);
+			Relocate(mesh.meshletVertices, mesh.meshletVertexCount);
+			Relocate(mesh.meshletTriangles, mesh.meshletTriangleIndexCount);
+			Relocate(mesh.quantizedPositions, vertexCount * 4, true);
+			Relocate(mesh.quantizedNormals, vertexCount * 2, true);
+			Relocate(mesh.quantizedTangents, vertexCount * 2, true);
+			Relocate(mesh.quantizedBitangents, vertexCount * 2, true);
+			Relocate(mesh.quantizedUV0, vertexCount * 2, true);
+			Relocate(mesh.quantizedUV1, vertexCount * 2, true);
+			Relocate(mesh.quantizedUV2, vertexCount * 2, true);
+			Relocate(mesh.quantizedUV3, vertexCount * 2, true);
+			Relocate(mesh.quantizedUV4, vertexCount * 2, true);
+			Relocate(mesh.quantizedUV5, vertexCount * 2, true);
+			Relocate(mesh.quantizedUV6, vertexCount * 2, true);
+			Relocate(mesh.quantizedUV7, vertexCount * 2, true);
+			Relocate(mesh.quantizedColor0, vertexCount * 4, true);
+			Relocate(mesh.quantizedColor1, vertexCount * 4, true);
+			Relocate(mesh.quantizedColor2, vertexCount * 4, true);
+			Relocate(mesh.quantizedColor3, vertexCount * 4, true);
+
+			for (int32_t j = 0; valid && j < mesh.meshletVertexCount; j++)
+			{
+				valid = mesh.meshletVertices[j] < (uint32_t)vertexCount;
+			}
 
-			for (int32_t j = 0; j < node->translation_keys.count; j++)
+			for (int32_t j = 0; valid && j < mesh.meshletCount; j++)
 			{
-				Vector3Key* key = &animatedNode.positions[j];
-				ufbx_baked_vec3* v = &node->translation_keys[j];
+				const Meshlet& meshlet = mesh.meshlets[j];
 
-				key->time = (float)(v->time - stack->time_begin);
-				key->value = v->value;
+				valid = (uint64_t)meshlet.vertexOffset + meshlet.vertexCount <= (uint64_t)mesh.meshletVertexCount &&
+					(uint64_t)meshlet.triangleOffset + meshlet.triangleCount * 3ull <= (uint64_t)mesh.meshletTriangleIndexCount;
+
+				for (uint32_t k = 0; valid && k < meshlet.triangleCount * 3; k++)
+				{
+					valid = mesh.meshletTriangles[meshlet.triangleOffset + k] < meshlet.vertexCount;
+				}
 			}
+		}
+
+		Relocate(header.materials, header.materialCount);
 
-			for (int32_t j = 0; j < node->rotation_keys.count; j++)
+		for (int32_t i = 0; valid && i < header.materialCount; i++)
+		{
+			Material& material = header.materials[i];
+
+			Check(material.name);
+			Check(material.diffuseTexture);
+			Check(material.specularTexture);
+			Check(material.reflectionTexture);
+			Check(material.transparencyTexture);
+			Check(material.emissionTexture);
+			Check(material.ambientTexture);
+			Check(material.normalMapTexture);
+			Check(material.bumpTexture);
+			Check(material.displacementTexture);
+			Check(material.vectorDisplacementTexture);
+
+			const int32_t textureIndices[] = { material.diffuseTextureIndex, material.specularTextureIndex,
+				material.reflectionTextureIndex, material.transparencyTextureIndex, material.emissionTextureIndex,
+				material.ambientTextureIndex, material.normalMapTextureIndex, material.bumpTextureIndex,
+				material.displacementTextureIndex, material.vectorDisplacementTextureIndex };
+
+			for (auto index : textureIndices)
 			{
-				QuaternionKey* key = &animatedNode.rotations[j];
-				ufbx_baked_quat* v = &node->rotation_keys[j];
+				if (index < -1 || index >= header.textureCount)
+				{
+					valid = false;
+				}
+			}
+		}
 
-				key->time = (float)(v->time - stack->time_begin);
-				key->value = v->value;
+		Relocate(header.animations, header.animationCount);
+
+		for (int32_t i = 0; valid && i < header.animationCount; i++)
+		{
+			Animation& animation = header.animations[i];
+
+			Check(animation.name);
+			Relocate(animation.nodes, animation.nodeCount);
+
+			for (int32_t j = 0; valid && j < animation.nodeCount; j++)
+			{
+				NodeAnimation& nodeAnimation = animation.nodes[j];
+
+				if (nodeAnimation.nodeIndex < 0 || nodeAnimation.nodeIndex >= header.nodeCount ||
+					(j > 0 && animation.nodes[j - 1].nodeIndex >= nodeAnimation.nodeIndex))
+				{
+					valid = false;
+				}
+
+				Relocate(nodeAnimation.positions, nodeAnimation.positionCount);
+				Relocate(nodeAnimation.rotations, nodeAnimation.rotationCount);
+				Relocate(nodeAnimation.scales, nodeAnimation.scaleCount);
 			}
 
-			for (int32_t j = 0; j < node->scale_keys.count; j++)
+			Relocate(animation.blendShapes, animation.blendShapeCount);
+
+			for (int32_t j = 0; valid && j < animation.blendShapeCount; j++)
 			{
-				Vector3Key* key = &animatedNode.scales[j];
-				ufbx_baked_vec3* v = &node->scale_keys[j];
+				Relocate(animation.blendShapes[j].weights, animation.blendShapes[j].weightCount);
+			}
+		}
 
-				key->time = (float)(v->time - stack->time_begin);
-				key->value = v->value;
+		Relocate(header.lodGroups, header.lodGroupCount);
+
+		for (int32_t i = 0; valid && i < header.lodGroupCount; i++)
+		{
+			LODGroup& lodGroup = header.lodGroups[i];
+
+			Relocate(lodGroup.levels, lodGroup.levelCount);
+
+			for (int32_t j = 0; valid && j < lodGroup.levelCount; j++)
+			{
+				Relocate(lodGroup.levels[j].meshIndices, lodGroup.levels[j].meshCount);
 			}
 		}
 
-		ufbx_free_baked_anim(bakedAnim);
+		Relocate(header.textures, header.textureCount);
+
+		for (int32_t i = 0; valid && i < header.textureCount; i++)
+		{
+			Texture& texture = header.textures[i];
+
+			Check(texture.name);
+			Check(texture.fileName);
+			Relocate(texture.content, texture.contentSize);
+		}
 	}
 };
 
-class Scene
+//Key of the cache of a scene loaded with `options` from a source whose bytes hash to `sourceHash`.
+//Only the options that change the extracted scene are included, threading and progress reporting aren't.
+CEXPORT uint64_t UFBXSceneCacheKey(uint64_t sourceHash, const SceneLoadOptions* options)
 {
-public:
-	Node* nodes;
+	SceneLoadOptions defaultOptions;
 
-	int32_t nodeCount;
+	if (options == nullptr)
+	{
+		options = &defaultOptions;
+	}
 
-	Mesh* meshes;
+	uint64_t key = HashCombine(sourceHash, ((uint64_t)UFBX_ABI_VERSION << 32) | UFBX_SCENE_CACHE_VERSION);
+
+	key = HashCombine(key, options->attributes != 0 ? options->attributes : STAPLE_VERTEX_ATTRIBUTE_ALL);
+	key = HashCombine(key, options->interleaved);
+	key = HashCombine(key, options->maxBoneInfluences > 4 ? 8 : 4);
+	key = HashCombine(key, options->compactSkin);
+	key = HashCombine(key, options->quantize);
+	key = HashCombine(key, (uint64_t)options->tangentGeneration);
+	key = HashDouble(key, options->animationSampleRate);
+	key = HashDouble(key, options->animationMinimumSampleRate);
+	key = HashDouble(key, options->animationMaximumSampleRate);
+	key = HashCombine(key, options->animationKeyReduction);
+	key = HashDouble(key, options->animationKeyReductionThreshold);
+	key = HashCombine(key, options->animationMaxKeyframeSegments);
+	key = HashCombine(key, options->flipWindingOrder);
+	key = HashCombine(key, options->optimizeMeshes);
+	key = HashCombine(key, options->buildMeshlets);
+
+	if (options->buildMeshlets)
+	{
+		key = HashCombine(key, options->meshletMaxVertices > 0 ? ClampSize(options->meshletMaxVertices, 3, 256) : 64);
+		key = HashCombine(key, options->meshletMaxTriangles > 0 ? ClampSize(options->meshletMaxTriangles, 4, 512) / 4 * 4 : 124);
+	}
 
-	int32_t meshCount;
+	return key;
+}
 
-	Material* materials;
+//Writes a scene to `path` so it can be loaded back with UFBXLoadSceneCache.
+//The file is written next to `path` first and moved in place, so readers never see a partial cache.
+CEXPORT bool UFBXSaveSceneCache(const Scene* scene, const char* path, uint64_t key)
+{
+	if (scene == nullptr || path == nullptr)
+	{
+		return false;
+	}
 
-	int32_t materialCount;
+	SceneCacheWriter writer;
 
-	Animation* animations;
+	writer.Write(scene, key);
 
-	int32_t animationCount;
+	std::string tempPath = std::string(path) + ".tmp";
 
-	Scene() : nodes(nullptr), nodeCount(0),
-		meshes(nullptr), meshCount(0),
-		materials(nullptr), materialCount(0),
-		animations(nullptr), animationCount(0) {}
+	FILE* fp = fopen(tempPath.c_str(), "wb");
 
-	~Scene()
+	if (fp == nullptr)
 	{
-		DELETE(nodes);
-		DELETE(meshes);
-		DELETE(materials);
-		DELETE(animations);
+		printf("ERROR: Failed to write scene cache %s\n", path);
+
+		return false;
 	}
 
-	void Read(ufbx_scene* scene)
+	bool written = fwrite(writer.data.data(), 1, writer.data.size(), fp) == writer.data.size();
+
+	written = fclose(fp) == 0 && written;
+
+	//The old cache is only replaced by a complete one, and stays in place if writing failed
+	if (written == false || MoveFileOver(tempPath.c_str(), path) == false)
 	{
-		nodeCount = (int32_t)scene->nodes.count;
+		printf("ERROR: Failed to write scene cache %s\n", path);
+
+		remove(tempPath.c_str());
 
-		nodes = new Node[nodeCount];
+		return false;
+	}
 
-		std::vector<Mesh> meshCache;
+	return true;
+}
 
-		for (int32_t i = 0; i < nodeCount; i++)
-		{
-			nodes[i].Read(scene, scene->nodes.data[i], meshCache);
-		}
+//Loads a scene written by UFBXSaveSceneCache. The file is read in one go and its offsets turned into pointers, nothing is parsed.
+//It's read rather than mapped since every offset is rewritten in place, which would copy most pages of a private mapping anyway,
+//and the importer copies every stream out right after. This also keeps the scene in its arena like any other.
+//Returns null if the file doesn't exist, was written for another key or by another version, or is corrupted.
+CEXPORT Scene* UFBXLoadSceneCache(const char* path, uint64_t key)
+{
+	if (path == nullptr)
+	{
+		return nullptr;
+	}
 
-		meshCount = (int32_t)meshCache.size();
+	FILE* fp = fopen(path, "rb");
 
-		if (meshCount > 0)
-		{
-			meshes = new Mesh[meshCount];
+	if (fp == nullptr)
+	{
+		return nullptr;
+	}
 
-			for (int32_t i = 0; i < meshCount; i++)
-			{
-				meshes[i] = meshCache[i];
-			}
-		}
+	SceneCacheHeader header;
+
+	if (fread(&header, sizeof(header), 1, fp) != 1 ||
+		header.magic != UFBX_SCENE_CACHE_MAGIC ||
+		header.abiVersion != UFBX_ABI_VERSION ||
+		header.pointerSize != sizeof(void*) ||
+		header.cacheVersion != UFBX_SCENE_CACHE_VERSION ||
+		header.key != key ||
+		header.size < sizeof(header) ||
+		header.size > SIZE_MAX ||
+		FileSize(fp) != (int64_t)header.size ||
+		fseek(fp, 0, SEEK_SET) != 0)
+	{
+		fclose(fp);
 
-		materialCount = (int32_t)scene->materials.count;
+		return nullptr;
+	}
 
-		if (materialCount > 0)
-		{
-			materials = new Material[materialCount];
+	Scene* scene = new Scene();
 
-			for (int32_t i = 0; i < materialCount; i++)
-			{
-				materials[i].Read(scene->materials[i]);
-			}
-		}
+	uint8_t* data = (uint8_t*)scene->arena->Allocate((size_t)header.size);
 
-		animationCount = (int32_t)scene->anim_stacks.count;
+	bool read = fread(data, 1, (size_t)header.size, fp) == header.size;
+
+	fclose(fp);
+
+	SceneCacheReader reader(data, header.size);
+
+	SceneCacheHeader& cachedHeader = *(SceneCacheHeader*)data;
+
+	if (read)
+	{
+		reader.Read(cachedHeader);
+	}
+
+	if (read == false || reader.valid == false)
+	{
+		printf("ERROR: Scene cache %s is corrupted\n", path);
+
+		delete scene;
+
+		return nullptr;
+	}
+
+	scene->nodes = cachedHeader.nodes;
+	scene->nodeCount = cachedHeader.nodeCount;
+	scene->meshes = cachedHeader.meshes;
+	scene->meshCount = cachedHeader.meshCount;
+	scene->materials = cachedHeader.materials;
+	scene->materialCount = cachedHeader.materialCount;
+	scene->animations = cachedHeader.animations;
+	scene->animationCount = cachedHeader.animationCount;
+	scene->strings = cachedHeader.strings;
+	scene->stringsLength = cachedHeader.stringsLength;
+	scene->lodGroups = cachedHeader.lodGroups;
+	scene->lodGroupCount = cachedHeader.lodGroupCount;
+	scene->textures = cachedHeader.textures;
+	scene->textureCount = cachedHeader.textureCount;
+
+	return scene;
+}
+
+//Amount of objects the benchmark grid is split into, so there's work for every thread of the pool
+#define UFBX_BENCHMARK_OBJECT_COUNT 16
+
+//Measures mesh extraction on a synthetic grid of about `triangleCount` triangles made of quads with positions, normals and UVs.
+//The grid is split into bands of rows, each its own object, so the parts are extracted in parallel unless `options` says otherwise.
+//Only Scene::Read is timed, the grid is parsed once up front.
+//Returns the best throughput of all iterations in triangles per second, or a negative value on failure.
+CEXPORT double UFBXBenchmarkMeshExtraction(int32_t triangleCount, int32_t iterations, const SceneLoadOptions* options)
+{
+	SceneLoadOptions defaultOptions;
+
+	if (options == nullptr)
+	{
+		options = &defaultOptions;
+	}
+
+	if (triangleCount < 2 || iterations < 1)
+	{
+		return -1;
+	}
+
+	uint32_t columns = (uint32_t)sqrt(triangleCount / 2.0);
+
+	if (columns == 0)
+	{
+		columns = 1;
+	}
+
+	uint32_t rows = ((uint32_t)triangleCount / 2 + columns - 1) / columns;
+
+	std::string obj;
 
-		if (animationCount > 0)
+	obj.reserve((size_t)(columns + 1) * (rows + 1) * 96 + (size_t)columns * rows * 64);
+
+	char line[256];
+
+	for (uint32_t y = 0; y <= rows; y++)
+	{
+		for (uint32_t x = 0; x <= columns; x++)
 		{
-			animations = new Animation[animationCount];
+			float u = x / (float)columns;
+			float v = y / (float)rows;
 
-			for (int32_t i = 0; i < animationCount; i++)
-			{
-				animations[i].Read(scene->anim_stacks[i], scene);
-			}
+			snprintf(line, sizeof(line), "v %f %f %f\nvt %f %f\nvn 0 1 0\n", u * 100.0f, sinf(u * 31.0f) * cosf(v * 17.0f), v * 100.0f, u, v);
+
+			obj += line;
 		}
 	}
-};
 
-CEXPORT Scene* UFBXLoadScene(const char* fileName)
-{
-	ufbx_load_opts opts;
+	uint32_t bandCount = rows < UFBX_BENCHMARK_OBJECT_COUNT ? rows : UFBX_BENCHMARK_OBJECT_COUNT;
+	uint32_t band = UINT32_MAX;
 
-	memset(&opts, 0, sizeof(opts));
+	for (uint32_t y = 0; y < rows; y++)
+	{
+		if ((uint64_t)y * bandCount / rows != band)
+		{
+			band = (uint32_t)((uint64_t)y * bandCount / rows);
 
-	opts.load_external_files = true;
-	opts.ignore_missing_external_files = true;
-	opts.generate_missing_normals = true;
+			snprintf(line, sizeof(line), "o Band%u\n", band);
 
-	opts.target_axes = ufbx_axes_left_handed_y_up;
+			obj += line;
+		}
 
-	opts.handedness_conversion_axis = UFBX_MIRROR_AXIS_X;
+		for (uint32_t x = 0; x < columns; x++)
+		{
+			uint32_t a = y * (columns + 1) + x + 1;
+			uint32_t b = a + 1;
+			uint32_t c = b + columns + 1;
+			uint32_t d = a + columns + 1;
 
-	opts.target_unit_meters = 1.0f;
+			snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c, d, d, d);
 
-	opts.space_conversion = UFBX_SPACE_CONVERSION_MODIFY_GEOMETRY;
+			obj += line;
+		}
+	}
 
-	opts.obj_search_mtl_by_filename = true;
+	ufbx_load_opts opts;
+
+	InitLoadOptions(opts);
+
+	opts.load_external_files = false;
+	opts.file_format = UFBX_FILE_FORMAT_OBJ;
 
 	ufbx_error error;
 
-	ufbx_scene* scene = ufbx_load_file(fileName, &opts, &error);
+	ufbx_scene* scene = ufbx_load_memory(obj.data(), obj.size(), &opts, &error);
 
 	if (scene == nullptr)
 	{
-		PrintError(&error, "Failed to load scene");
+		PrintError(&error, "Failed to load benchmark scene");
 
-		return nullptr;
+		return -1;
 	}
 
-	Scene* ownScene = new Scene();
+	double best = 0;
 
-	ownScene->Read(scene);
+	for (int32_t i = 0; i < iterations; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
 
-	ufbx_free_scene(scene);
+		Scene* ownScene = new Scene();
 
-	return ownScene;
-}
+		ImportProgressTracker progress(*options);
 
-CEXPORT void UFBXFreeScene(Scene* ptr)
-{
-	if (ptr == nullptr)
-	{
-		return;
+		ownScene->Read(scene, *options, progress);
+
+		auto end = std::chrono::steady_clock::now();
+
+		delete ownScene;
+
+		double seconds = std::chrono::duration<double>(end - start).count();
+
+		if (seconds > 0 && rows * columns * 2 / seconds > best)
+		{
+			best = rows * columns * 2 / seconds;
+		}
 	}
 
-	delete ptr;
+	ufbx_free_scene(scene);
+
+	return best;
 }
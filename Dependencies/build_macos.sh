@@ -28,6 +28,27 @@ rm -f $SLANG_FILENAME
 
 cd ..
 
+MESHOPTIMIZER_RELEASE=0.22
+MESHOPTIMIZER_FILENAME=meshoptimizer-$MESHOPTIMIZER_RELEASE.tar.gz
+MESHOPTIMIZER_URL=https://github.com/zeux/meshoptimizer/archive/refs/tags/v$MESHOPTIMIZER_RELEASE.tar.gz
+
+curl -L -o $MESHOPTIMIZER_FILENAME $MESHOPTIMIZER_URL
+
+tar -zxf $MESHOPTIMIZER_FILENAME
+
+rm -f $MESHOPTIMIZER_FILENAME
+
+rm -rf meshoptimizer
+
+mv meshoptimizer-$MESHOPTIMIZER_RELEASE meshoptimizer
+
+MIKKTSPACE_URL=https://raw.githubusercontent.com/mmikk/MikkTSpace/master
+
+mkdir -p MikkTSpace
+
+curl -L -o MikkTSpace/mikktspace.c $MIKKTSPACE_URL/mikktspace.c
+curl -L -o MikkTSpace/mikktspace.h $MIKKTSPACE_URL/mikktspace.h
+
 premake5 --os=macosx xcode4
 premake5 --os=macosx --file=NativeFileDialog/build/premake5.lua xcode4
 
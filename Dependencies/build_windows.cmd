@@ -26,6 +26,27 @@ del /S /Q %SLANG_FILENAME%
 
 cd ..
 
+set MESHOPTIMIZER_RELEASE=0.22
+set MESHOPTIMIZER_FILENAME=meshoptimizer-%MESHOPTIMIZER_RELEASE%.tar.gz
+set MESHOPTIMIZER_URL=https://github.com/zeux/meshoptimizer/archive/refs/tags/v%MESHOPTIMIZER_RELEASE%.tar.gz
+
+curl -L -o %MESHOPTIMIZER_FILENAME% "%MESHOPTIMIZER_URL%"
+
+tar -zxf %MESHOPTIMIZER_FILENAME%
+
+del /S /Q %MESHOPTIMIZER_FILENAME%
+
+if exist meshoptimizer rmdir /S /Q meshoptimizer
+
+move meshoptimizer-%MESHOPTIMIZER_RELEASE% meshoptimizer
+
+set MIKKTSPACE_URL=https://raw.githubusercontent.com/mmikk/MikkTSpace/master
+
+if not exist MikkTSpace mkdir MikkTSpace
+
+curl -L -o MikkTSpace\mikktspace.c "%MIKKTSPACE_URL%/mikktspace.c"
+curl -L -o MikkTSpace\mikktspace.h "%MIKKTSPACE_URL%/mikktspace.h"
+
 call premake5 vs2026
 call premake5 --file=NativeFileDialog/build/premake5.lua vs2026
 
@@ -2,6 +2,8 @@ local BUILD_DIR = path.join("build", "native")
 local SUPPORT_DIR = "StapleSupport"
 local TOOLING_SUPPORT_DIR = "StapleToolingSupport"
 local UFBX_DIR = "ufbx"
+local MESHOPTIMIZER_DIR = path.join("meshoptimizer", "src")
+local MIKKTSPACE_DIR = "MikkTSpace"
 local NFD_DIR = "NativeFileDialog"
 
 solution "Dependencies"
@@ -62,6 +64,8 @@ project "StapleToolingSupport"
 	includedirs {
 		SUPPORT_DIR,
 		"ufbx",
+		MESHOPTIMIZER_DIR,
+		MIKKTSPACE_DIR,
 	}
 	
 	defines { "UFBX_REAL_IS_FLOAT" }
@@ -76,8 +80,15 @@ project "StapleToolingSupport"
 		path.join(TOOLING_SUPPORT_DIR, "**.hpp");
 		path.join(UFBX_DIR, "*.h");
 		path.join(UFBX_DIR, "*.c");
+		path.join(MESHOPTIMIZER_DIR, "*.h");
+		path.join(MESHOPTIMIZER_DIR, "*.cpp");
+		path.join(MIKKTSPACE_DIR, "*.h");
+		path.join(MIKKTSPACE_DIR, "*.c");
 	}
 
+	filter "system:linux"
+		links { "pthread" }
+
 	filter "system:macosx"
 		files { path.join(SUPPORT_DIR, "*.m") }
 
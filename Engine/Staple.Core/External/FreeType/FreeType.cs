@@ -35,6 +35,27 @@ namespace Staple.Internal
             public uint xAdvance;
         }
 
+        public enum GlyphFormat
+        {
+            RGBA,
+            Coverage,
+            SDF,
+            MSDF,
+        }
+
+        [StructLayout(LayoutKind.Sequential, Pack = 0)]
+        public struct AtlasGlyph
+        {
+            public uint codepoint;
+            public int x;
+            public int y;
+            public int width;
+            public int height;
+            public int xOffset;
+            public int yOffset;
+            public int xAdvance;
+        }
+
         [LibraryImport(DllName, EntryPoint = "FreeTypeLoadFont")]
         [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
         public static unsafe partial nint LoadFont(byte* ptr, int size);
@@ -52,6 +73,38 @@ namespace Staple.Internal
         public static unsafe partial nint LoadGlyph(nint ptr, uint character, uint fontSize, Color textColor, Color secondaryTextColor,
             int borderSize, Color borderColor);
 
+        [LibraryImport(DllName, EntryPoint = "FreeTypeBuildAtlas")]
+        [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+        public static unsafe partial int BuildAtlas(nint ptr, uint* codepoints, int codepointCount, uint fontSize, GlyphFormat format,
+            Color textColor, Color secondaryTextColor, int borderSize, Color borderColor, byte* atlas, int atlasWidth, int atlasHeight,
+            int padding, AtlasGlyph* glyphs);
+
+        [LibraryImport(DllName, EntryPoint = "FreeTypeLoadDistanceFieldGlyph")]
+        [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+        public static unsafe partial nint LoadDistanceFieldGlyph(nint ptr, uint character, uint fontSize, GlyphFormat format, int spread);
+
+        [LibraryImport(DllName, EntryPoint = "FreeTypeBuildDistanceFieldAtlas")]
+        [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+        public static unsafe partial int BuildDistanceFieldAtlas(nint ptr, uint* codepoints, int codepointCount, uint fontSize,
+            GlyphFormat format, int spread, byte* atlas, int atlasWidth, int atlasHeight, int padding, AtlasGlyph* glyphs);
+
+        [LibraryImport(DllName, EntryPoint = "FreeTypeCreateGlyphCache")]
+        [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+        public static unsafe partial nint CreateGlyphCache(nint ptr, uint fontSize, GlyphFormat format, int borderSize, int spread,
+            int width, int height, int padding);
+
+        [LibraryImport(DllName, EntryPoint = "FreeTypeCacheGlyph")]
+        [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+        public static unsafe partial int CacheGlyph(nint cache, uint codepoint, uint use, AtlasGlyph* glyph);
+
+        [LibraryImport(DllName, EntryPoint = "FreeTypeGlyphCacheTakeDirtyRegion")]
+        [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+        public static unsafe partial int GlyphCacheTakeDirtyRegion(nint cache, int* x, int* y, int* width, int* height, byte* pixels);
+
+        [LibraryImport(DllName, EntryPoint = "FreeTypeFreeGlyphCache")]
+        [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
+        public static unsafe partial void FreeGlyphCache(nint cache);
+
         [LibraryImport(DllName, EntryPoint = "FreeTypeFreeGlyph")]
         [UnmanagedCallConv(CallConvs = [typeof(System.Runtime.CompilerServices.CallConvCdecl)])]
         public static unsafe partial void FreeGlyph(nint ptr);
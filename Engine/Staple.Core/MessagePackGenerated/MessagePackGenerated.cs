@@ -50,151 +50,158 @@ namespace MessagePack.Resolvers
 
         static GeneratedResolverGetFormatterHelper()
         {
-            lookup = new global::System.Collections.Generic.Dictionary<Type, int>(143)
+            lookup = new global::System.Collections.Generic.Dictionary<Type, int>(150)
             {
                 { typeof(global::Staple.ColliderMask.Item[]), 0 },
                 { typeof(global::Staple.Internal.MeshAssetAnimation[]), 1 },
                 { typeof(global::Staple.Internal.MeshAssetAnimationChannel[]), 2 },
                 { typeof(global::Staple.Internal.MeshAssetBone[]), 3 },
-                { typeof(global::Staple.Internal.MeshAssetMeshInfo[]), 4 },
-                { typeof(global::Staple.Internal.MeshAssetNode[]), 5 },
-                { typeof(global::Staple.Internal.MeshAssetQuaternionAnimationKey[]), 6 },
-                { typeof(global::Staple.Internal.MeshAssetVectorAnimationKey[]), 7 },
-                { typeof(global::Staple.Internal.SceneComponent[]), 8 },
-                { typeof(global::Staple.Internal.SceneObject[]), 9 },
-                { typeof(global::Staple.Internal.ShaderInstanceParameter[]), 10 },
-                { typeof(global::Staple.Internal.ShaderUniform[]), 11 },
-                { typeof(global::Staple.Internal.ShaderUniformField[]), 12 },
-                { typeof(global::Staple.Internal.Vector2Holder[]), 13 },
-                { typeof(global::Staple.Internal.Vector3Holder[]), 14 },
-                { typeof(global::Staple.Internal.Vector4Holder[]), 15 },
-                { typeof(global::Staple.VertexAttribute[]), 16 },
-                { typeof(global::System.Collections.Generic.Dictionary<global::Staple.AppPlatform, global::Staple.Internal.TextureMetadataOverride>), 17 },
-                { typeof(global::System.Collections.Generic.Dictionary<global::Staple.AppPlatform, global::System.Collections.Generic.List<global::Staple.RendererType>>), 18 },
-                { typeof(global::System.Collections.Generic.Dictionary<global::Staple.RendererType, global::Staple.Internal.SerializableShaderEntry>), 19 },
-                { typeof(global::System.Collections.Generic.Dictionary<string, global::Staple.Internal.MaterialParameter>), 20 },
-                { typeof(global::System.Collections.Generic.Dictionary<string, global::Staple.Internal.SerializableShaderData>), 21 },
-                { typeof(global::System.Collections.Generic.Dictionary<string, global::Staple.Internal.SerializableStapleAssetParameter>), 22 },
-                { typeof(global::System.Collections.Generic.Dictionary<string, global::System.Collections.Generic.List<global::Staple.Internal.SerializableAssetDatabaseAssetInfo>>), 23 },
-                { typeof(global::System.Collections.Generic.Dictionary<string, object>), 24 },
-                { typeof(global::System.Collections.Generic.List<global::Staple.Internal.SerializableAssetDatabaseAssetInfo>), 25 },
-                { typeof(global::System.Collections.Generic.List<global::Staple.Internal.ShaderUniformMapping>), 26 },
-                { typeof(global::System.Collections.Generic.List<global::Staple.Internal.TextureSpriteInfo>), 27 },
-                { typeof(global::System.Collections.Generic.List<global::Staple.RendererType>), 28 },
-                { typeof(global::System.Collections.Generic.List<int>), 29 },
-                { typeof(global::System.Collections.Generic.List<string>), 30 },
-                { typeof(global::Staple.AppPlatform), 31 },
-                { typeof(global::Staple.AppProfilingMode), 32 },
-                { typeof(global::Staple.BlendMode), 33 },
-                { typeof(global::Staple.CullingMode), 34 },
-                { typeof(global::Staple.EntityHierarchyVisibility), 35 },
-                { typeof(global::Staple.Internal.AudioClipFormat), 36 },
-                { typeof(global::Staple.Internal.AudioRecompression), 37 },
-                { typeof(global::Staple.Internal.FontCharacterSet), 38 },
-                { typeof(global::Staple.Internal.MaterialParameterSource), 39 },
-                { typeof(global::Staple.Internal.MaterialParameterType), 40 },
-                { typeof(global::Staple.Internal.MeshAssetRotation), 41 },
-                { typeof(global::Staple.Internal.MeshAssetType), 42 },
-                { typeof(global::Staple.Internal.MeshNormalsMode), 43 },
-                { typeof(global::Staple.Internal.MeshSimplifyTarget), 44 },
-                { typeof(global::Staple.Internal.MeshTangentsMode), 45 },
-                { typeof(global::Staple.Internal.SceneObjectKind), 46 },
-                { typeof(global::Staple.Internal.ShaderType), 47 },
-                { typeof(global::Staple.Internal.ShaderUniformType), 48 },
-                { typeof(global::Staple.Internal.SpriteTextureMethod), 49 },
-                { typeof(global::Staple.Internal.TextureFilter), 50 },
-                { typeof(global::Staple.Internal.TextureMetadataFormat), 51 },
-                { typeof(global::Staple.Internal.TextureMetadataQuality), 52 },
-                { typeof(global::Staple.Internal.TextureSpriteRotation), 53 },
-                { typeof(global::Staple.Internal.TextureType), 54 },
-                { typeof(global::Staple.Internal.TextureWrap), 55 },
-                { typeof(global::Staple.MaterialLighting), 56 },
-                { typeof(global::Staple.MaterialRenderQueue), 57 },
-                { typeof(global::Staple.MeshTopology), 58 },
-                { typeof(global::Staple.RendererType), 59 },
-                { typeof(global::Staple.StandardTextureColorComponents), 60 },
-                { typeof(global::Staple.VertexAttribute), 61 },
-                { typeof(global::Staple.WindowMode), 62 },
-                { typeof(global::Staple.X64InstructionLevel), 63 },
-                { typeof(global::Staple.AppSettings), 64 },
-                { typeof(global::Staple.ColliderMask.Item), 65 },
-                { typeof(global::Staple.Color), 66 },
-                { typeof(global::Staple.Color32), 67 },
-                { typeof(global::Staple.Internal.AppSettingsHeader), 68 },
-                { typeof(global::Staple.Internal.AssetHolder), 69 },
-                { typeof(global::Staple.Internal.AudioClipMetadata), 70 },
-                { typeof(global::Staple.Internal.ComputeShaderMetrics), 71 },
-                { typeof(global::Staple.Internal.FolderAsset), 72 },
-                { typeof(global::Staple.Internal.FontGlyphInfo), 73 },
-                { typeof(global::Staple.Internal.FontMetadata), 74 },
-                { typeof(global::Staple.Internal.MaterialMetadata), 75 },
-                { typeof(global::Staple.Internal.MaterialParameter), 76 },
-                { typeof(global::Staple.Internal.Matrix4x4Holder), 77 },
-                { typeof(global::Staple.Internal.MeshAdjustmentTransform), 78 },
-                { typeof(global::Staple.Internal.MeshAssetAnimation), 79 },
-                { typeof(global::Staple.Internal.MeshAssetAnimationChannel), 80 },
-                { typeof(global::Staple.Internal.MeshAssetBone), 81 },
-                { typeof(global::Staple.Internal.MeshAssetMeshInfo), 82 },
-                { typeof(global::Staple.Internal.MeshAssetMetadata), 83 },
-                { typeof(global::Staple.Internal.MeshAssetNode), 84 },
-                { typeof(global::Staple.Internal.MeshAssetQuaternionAnimationKey), 85 },
-                { typeof(global::Staple.Internal.MeshAssetVectorAnimationKey), 86 },
-                { typeof(global::Staple.Internal.ResourcePak.Entry), 87 },
-                { typeof(global::Staple.Internal.ResourcePak.Header), 88 },
-                { typeof(global::Staple.Internal.SceneComponent), 89 },
-                { typeof(global::Staple.Internal.SceneList), 90 },
-                { typeof(global::Staple.Internal.SceneListHeader), 91 },
-                { typeof(global::Staple.Internal.SceneObject), 92 },
-                { typeof(global::Staple.Internal.SceneObjectTransform), 93 },
-                { typeof(global::Staple.Internal.SerializableAssetDatabase), 94 },
-                { typeof(global::Staple.Internal.SerializableAssetDatabaseAssetInfo), 95 },
-                { typeof(global::Staple.Internal.SerializableAssetDatabaseHeader), 96 },
-                { typeof(global::Staple.Internal.SerializableAudioClip), 97 },
-                { typeof(global::Staple.Internal.SerializableAudioClipHeader), 98 },
-                { typeof(global::Staple.Internal.SerializableFont), 99 },
-                { typeof(global::Staple.Internal.SerializableFontHeader), 100 },
-                { typeof(global::Staple.Internal.SerializableMaterial), 101 },
-                { typeof(global::Staple.Internal.SerializableMaterialHeader), 102 },
-                { typeof(global::Staple.Internal.SerializableMeshAsset), 103 },
-                { typeof(global::Staple.Internal.SerializableMeshAssetHeader), 104 },
-                { typeof(global::Staple.Internal.SerializablePrefab), 105 },
-                { typeof(global::Staple.Internal.SerializablePrefabHeader), 106 },
-                { typeof(global::Staple.Internal.SerializableScene), 107 },
-                { typeof(global::Staple.Internal.SerializableSceneHeader), 108 },
-                { typeof(global::Staple.Internal.SerializableShader), 109 },
-                { typeof(global::Staple.Internal.SerializableShaderData), 110 },
-                { typeof(global::Staple.Internal.SerializableShaderEntry), 111 },
-                { typeof(global::Staple.Internal.SerializableShaderHeader), 112 },
-                { typeof(global::Staple.Internal.SerializableStapleAsset), 113 },
-                { typeof(global::Staple.Internal.SerializableStapleAssetContainer), 114 },
-                { typeof(global::Staple.Internal.SerializableStapleAssetHeader), 115 },
-                { typeof(global::Staple.Internal.SerializableStapleAssetParameter), 116 },
-                { typeof(global::Staple.Internal.SerializableTextAsset), 117 },
-                { typeof(global::Staple.Internal.SerializableTextAssetHeader), 118 },
-                { typeof(global::Staple.Internal.SerializableTexture), 119 },
-                { typeof(global::Staple.Internal.SerializableTextureCPUData), 120 },
-                { typeof(global::Staple.Internal.SerializableTextureHeader), 121 },
-                { typeof(global::Staple.Internal.ShaderInstanceParameter), 122 },
-                { typeof(global::Staple.Internal.ShaderMetadata), 123 },
-                { typeof(global::Staple.Internal.ShaderUniform), 124 },
-                { typeof(global::Staple.Internal.ShaderUniformContainer), 125 },
-                { typeof(global::Staple.Internal.ShaderUniformField), 126 },
-                { typeof(global::Staple.Internal.ShaderUniformMapping), 127 },
-                { typeof(global::Staple.Internal.ShaderUniformTypeInfo), 128 },
-                { typeof(global::Staple.Internal.TextAssetMetadata), 129 },
-                { typeof(global::Staple.Internal.TextureMetadata), 130 },
-                { typeof(global::Staple.Internal.TextureMetadataOverride), 131 },
-                { typeof(global::Staple.Internal.TextureSpriteInfo), 132 },
-                { typeof(global::Staple.Internal.Vector2Holder), 133 },
-                { typeof(global::Staple.Internal.Vector3Holder), 134 },
-                { typeof(global::Staple.Internal.Vector4Holder), 135 },
-                { typeof(global::Staple.Internal.VertexFragmentShaderMetrics), 136 },
-                { typeof(global::Staple.LayerMask), 137 },
-                { typeof(global::Staple.Rect), 138 },
-                { typeof(global::Staple.RectFloat), 139 },
-                { typeof(global::Staple.Vector2Int), 140 },
-                { typeof(global::Staple.Vector3Int), 141 },
-                { typeof(global::Staple.Vector4Int), 142 },
+                { typeof(global::Staple.Internal.MeshAssetLODGroup[]), 4 },
+                { typeof(global::Staple.Internal.MeshAssetLODLevel[]), 5 },
+                { typeof(global::Staple.Internal.MeshAssetMeshInfo[]), 6 },
+                { typeof(global::Staple.Internal.MeshAssetMeshlet[]), 7 },
+                { typeof(global::Staple.Internal.MeshAssetNode[]), 8 },
+                { typeof(global::Staple.Internal.MeshAssetQuaternionAnimationKey[]), 9 },
+                { typeof(global::Staple.Internal.MeshAssetVectorAnimationKey[]), 10 },
+                { typeof(global::Staple.Internal.SceneComponent[]), 11 },
+                { typeof(global::Staple.Internal.SceneObject[]), 12 },
+                { typeof(global::Staple.Internal.ShaderInstanceParameter[]), 13 },
+                { typeof(global::Staple.Internal.ShaderUniform[]), 14 },
+                { typeof(global::Staple.Internal.ShaderUniformField[]), 15 },
+                { typeof(global::Staple.Internal.Vector2Holder[]), 16 },
+                { typeof(global::Staple.Internal.Vector3Holder[]), 17 },
+                { typeof(global::Staple.Internal.Vector4Holder[]), 18 },
+                { typeof(global::Staple.VertexAttribute[]), 19 },
+                { typeof(global::System.Collections.Generic.Dictionary<global::Staple.AppPlatform, global::Staple.Internal.TextureMetadataOverride>), 20 },
+                { typeof(global::System.Collections.Generic.Dictionary<global::Staple.AppPlatform, global::System.Collections.Generic.List<global::Staple.RendererType>>), 21 },
+                { typeof(global::System.Collections.Generic.Dictionary<global::Staple.RendererType, global::Staple.Internal.SerializableShaderEntry>), 22 },
+                { typeof(global::System.Collections.Generic.Dictionary<string, global::Staple.Internal.MaterialParameter>), 23 },
+                { typeof(global::System.Collections.Generic.Dictionary<string, global::Staple.Internal.SerializableShaderData>), 24 },
+                { typeof(global::System.Collections.Generic.Dictionary<string, global::Staple.Internal.SerializableStapleAssetParameter>), 25 },
+                { typeof(global::System.Collections.Generic.Dictionary<string, global::System.Collections.Generic.List<global::Staple.Internal.SerializableAssetDatabaseAssetInfo>>), 26 },
+                { typeof(global::System.Collections.Generic.Dictionary<string, object>), 27 },
+                { typeof(global::System.Collections.Generic.List<global::Staple.Internal.SerializableAssetDatabaseAssetInfo>), 28 },
+                { typeof(global::System.Collections.Generic.List<global::Staple.Internal.ShaderUniformMapping>), 29 },
+                { typeof(global::System.Collections.Generic.List<global::Staple.Internal.TextureSpriteInfo>), 30 },
+                { typeof(global::System.Collections.Generic.List<global::Staple.RendererType>), 31 },
+                { typeof(global::System.Collections.Generic.List<int>), 32 },
+                { typeof(global::System.Collections.Generic.List<string>), 33 },
+                { typeof(global::Staple.AppPlatform), 34 },
+                { typeof(global::Staple.AppProfilingMode), 35 },
+                { typeof(global::Staple.BlendMode), 36 },
+                { typeof(global::Staple.CullingMode), 37 },
+                { typeof(global::Staple.EntityHierarchyVisibility), 38 },
+                { typeof(global::Staple.Internal.AudioClipFormat), 39 },
+                { typeof(global::Staple.Internal.AudioRecompression), 40 },
+                { typeof(global::Staple.Internal.FontCharacterSet), 41 },
+                { typeof(global::Staple.Internal.FontRenderMode), 42 },
+                { typeof(global::Staple.Internal.MaterialParameterSource), 43 },
+                { typeof(global::Staple.Internal.MaterialParameterType), 44 },
+                { typeof(global::Staple.Internal.MeshAssetRotation), 45 },
+                { typeof(global::Staple.Internal.MeshAssetType), 46 },
+                { typeof(global::Staple.Internal.MeshNormalsMode), 47 },
+                { typeof(global::Staple.Internal.MeshSimplifyTarget), 48 },
+                { typeof(global::Staple.Internal.MeshTangentsMode), 49 },
+                { typeof(global::Staple.Internal.SceneObjectKind), 50 },
+                { typeof(global::Staple.Internal.ShaderType), 51 },
+                { typeof(global::Staple.Internal.ShaderUniformType), 52 },
+                { typeof(global::Staple.Internal.SpriteTextureMethod), 53 },
+                { typeof(global::Staple.Internal.TextureFilter), 54 },
+                { typeof(global::Staple.Internal.TextureMetadataFormat), 55 },
+                { typeof(global::Staple.Internal.TextureMetadataQuality), 56 },
+                { typeof(global::Staple.Internal.TextureSpriteRotation), 57 },
+                { typeof(global::Staple.Internal.TextureType), 58 },
+                { typeof(global::Staple.Internal.TextureWrap), 59 },
+                { typeof(global::Staple.MaterialLighting), 60 },
+                { typeof(global::Staple.MaterialRenderQueue), 61 },
+                { typeof(global::Staple.MeshTopology), 62 },
+                { typeof(global::Staple.RendererType), 63 },
+                { typeof(global::Staple.StandardTextureColorComponents), 64 },
+                { typeof(global::Staple.VertexAttribute), 65 },
+                { typeof(global::Staple.WindowMode), 66 },
+                { typeof(global::Staple.X64InstructionLevel), 67 },
+                { typeof(global::Staple.AppSettings), 68 },
+                { typeof(global::Staple.ColliderMask.Item), 69 },
+                { typeof(global::Staple.Color), 70 },
+                { typeof(global::Staple.Color32), 71 },
+                { typeof(global::Staple.Internal.AppSettingsHeader), 72 },
+                { typeof(global::Staple.Internal.AssetHolder), 73 },
+                { typeof(global::Staple.Internal.AudioClipMetadata), 74 },
+                { typeof(global::Staple.Internal.ComputeShaderMetrics), 75 },
+                { typeof(global::Staple.Internal.FolderAsset), 76 },
+                { typeof(global::Staple.Internal.FontGlyphInfo), 77 },
+                { typeof(global::Staple.Internal.FontMetadata), 78 },
+                { typeof(global::Staple.Internal.MaterialMetadata), 79 },
+                { typeof(global::Staple.Internal.MaterialParameter), 80 },
+                { typeof(global::Staple.Internal.Matrix4x4Holder), 81 },
+                { typeof(global::Staple.Internal.MeshAdjustmentTransform), 82 },
+                { typeof(global::Staple.Internal.MeshAssetAnimation), 83 },
+                { typeof(global::Staple.Internal.MeshAssetAnimationChannel), 84 },
+                { typeof(global::Staple.Internal.MeshAssetBone), 85 },
+                { typeof(global::Staple.Internal.MeshAssetLODGroup), 86 },
+                { typeof(global::Staple.Internal.MeshAssetLODLevel), 87 },
+                { typeof(global::Staple.Internal.MeshAssetMeshInfo), 88 },
+                { typeof(global::Staple.Internal.MeshAssetMeshlet), 89 },
+                { typeof(global::Staple.Internal.MeshAssetMetadata), 90 },
+                { typeof(global::Staple.Internal.MeshAssetNode), 91 },
+                { typeof(global::Staple.Internal.MeshAssetQuaternionAnimationKey), 92 },
+                { typeof(global::Staple.Internal.MeshAssetVectorAnimationKey), 93 },
+                { typeof(global::Staple.Internal.ResourcePak.Entry), 94 },
+                { typeof(global::Staple.Internal.ResourcePak.Header), 95 },
+                { typeof(global::Staple.Internal.SceneComponent), 96 },
+                { typeof(global::Staple.Internal.SceneList), 97 },
+                { typeof(global::Staple.Internal.SceneListHeader), 98 },
+                { typeof(global::Staple.Internal.SceneObject), 99 },
+                { typeof(global::Staple.Internal.SceneObjectTransform), 100 },
+                { typeof(global::Staple.Internal.SerializableAssetDatabase), 101 },
+                { typeof(global::Staple.Internal.SerializableAssetDatabaseAssetInfo), 102 },
+                { typeof(global::Staple.Internal.SerializableAssetDatabaseHeader), 103 },
+                { typeof(global::Staple.Internal.SerializableAudioClip), 104 },
+                { typeof(global::Staple.Internal.SerializableAudioClipHeader), 105 },
+                { typeof(global::Staple.Internal.SerializableFont), 106 },
+                { typeof(global::Staple.Internal.SerializableFontHeader), 107 },
+                { typeof(global::Staple.Internal.SerializableMaterial), 108 },
+                { typeof(global::Staple.Internal.SerializableMaterialHeader), 109 },
+                { typeof(global::Staple.Internal.SerializableMeshAsset), 110 },
+                { typeof(global::Staple.Internal.SerializableMeshAssetHeader), 111 },
+                { typeof(global::Staple.Internal.SerializablePrefab), 112 },
+                { typeof(global::Staple.Internal.SerializablePrefabHeader), 113 },
+                { typeof(global::Staple.Internal.SerializableScene), 114 },
+                { typeof(global::Staple.Internal.SerializableSceneHeader), 115 },
+                { typeof(global::Staple.Internal.SerializableShader), 116 },
+                { typeof(global::Staple.Internal.SerializableShaderData), 117 },
+                { typeof(global::Staple.Internal.SerializableShaderEntry), 118 },
+                { typeof(global::Staple.Internal.SerializableShaderHeader), 119 },
+                { typeof(global::Staple.Internal.SerializableStapleAsset), 120 },
+                { typeof(global::Staple.Internal.SerializableStapleAssetContainer), 121 },
+                { typeof(global::Staple.Internal.SerializableStapleAssetHeader), 122 },
+                { typeof(global::Staple.Internal.SerializableStapleAssetParameter), 123 },
+                { typeof(global::Staple.Internal.SerializableTextAsset), 124 },
+                { typeof(global::Staple.Internal.SerializableTextAssetHeader), 125 },
+                { typeof(global::Staple.Internal.SerializableTexture), 126 },
+                { typeof(global::Staple.Internal.SerializableTextureCPUData), 127 },
+                { typeof(global::Staple.Internal.SerializableTextureHeader), 128 },
+                { typeof(global::Staple.Internal.ShaderInstanceParameter), 129 },
+                { typeof(global::Staple.Internal.ShaderMetadata), 130 },
+                { typeof(global::Staple.Internal.ShaderUniform), 131 },
+                { typeof(global::Staple.Internal.ShaderUniformContainer), 132 },
+                { typeof(global::Staple.Internal.ShaderUniformField), 133 },
+                { typeof(global::Staple.Internal.ShaderUniformMapping), 134 },
+                { typeof(global::Staple.Internal.ShaderUniformTypeInfo), 135 },
+                { typeof(global::Staple.Internal.TextAssetMetadata), 136 },
+                { typeof(global::Staple.Internal.TextureMetadata), 137 },
+                { typeof(global::Staple.Internal.TextureMetadataOverride), 138 },
+                { typeof(global::Staple.Internal.TextureSpriteInfo), 139 },
+                { typeof(global::Staple.Internal.Vector2Holder), 140 },
+                { typeof(global::Staple.Internal.Vector3Holder), 141 },
+                { typeof(global::Staple.Internal.Vector4Holder), 142 },
+                { typeof(global::Staple.Internal.VertexFragmentShaderMetrics), 143 },
+                { typeof(global::Staple.LayerMask), 144 },
+                { typeof(global::Staple.Rect), 145 },
+                { typeof(global::Staple.RectFloat), 146 },
+                { typeof(global::Staple.Vector2Int), 147 },
+                { typeof(global::Staple.Vector3Int), 148 },
+                { typeof(global::Staple.Vector4Int), 149 },
             };
         }
 
@@ -212,145 +219,152 @@ namespace MessagePack.Resolvers
                 case 1: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetAnimation>();
                 case 2: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetAnimationChannel>();
                 case 3: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetBone>();
-                case 4: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetMeshInfo>();
-                case 5: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetNode>();
-                case 6: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetQuaternionAnimationKey>();
-                case 7: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetVectorAnimationKey>();
-                case 8: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.SceneComponent>();
-                case 9: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.SceneObject>();
-                case 10: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.ShaderInstanceParameter>();
-                case 11: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.ShaderUniform>();
-                case 12: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.ShaderUniformField>();
-                case 13: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.Vector2Holder>();
-                case 14: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.Vector3Holder>();
-                case 15: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.Vector4Holder>();
-                case 16: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.VertexAttribute>();
-                case 17: return new global::MessagePack.Formatters.DictionaryFormatter<global::Staple.AppPlatform, global::Staple.Internal.TextureMetadataOverride>();
-                case 18: return new global::MessagePack.Formatters.DictionaryFormatter<global::Staple.AppPlatform, global::System.Collections.Generic.List<global::Staple.RendererType>>();
-                case 19: return new global::MessagePack.Formatters.DictionaryFormatter<global::Staple.RendererType, global::Staple.Internal.SerializableShaderEntry>();
-                case 20: return new global::MessagePack.Formatters.DictionaryFormatter<string, global::Staple.Internal.MaterialParameter>();
-                case 21: return new global::MessagePack.Formatters.DictionaryFormatter<string, global::Staple.Internal.SerializableShaderData>();
-                case 22: return new global::MessagePack.Formatters.DictionaryFormatter<string, global::Staple.Internal.SerializableStapleAssetParameter>();
-                case 23: return new global::MessagePack.Formatters.DictionaryFormatter<string, global::System.Collections.Generic.List<global::Staple.Internal.SerializableAssetDatabaseAssetInfo>>();
-                case 24: return new global::MessagePack.Formatters.DictionaryFormatter<string, object>();
-                case 25: return new global::MessagePack.Formatters.ListFormatter<global::Staple.Internal.SerializableAssetDatabaseAssetInfo>();
-                case 26: return new global::MessagePack.Formatters.ListFormatter<global::Staple.Internal.ShaderUniformMapping>();
-                case 27: return new global::MessagePack.Formatters.ListFormatter<global::Staple.Internal.TextureSpriteInfo>();
-                case 28: return new global::MessagePack.Formatters.ListFormatter<global::Staple.RendererType>();
-                case 29: return new global::MessagePack.Formatters.ListFormatter<int>();
-                case 30: return new global::MessagePack.Formatters.ListFormatter<string>();
-                case 31: return new MessagePack.Formatters.Staple.AppPlatformFormatter();
-                case 32: return new MessagePack.Formatters.Staple.AppProfilingModeFormatter();
-                case 33: return new MessagePack.Formatters.Staple.BlendModeFormatter();
-                case 34: return new MessagePack.Formatters.Staple.CullingModeFormatter();
-                case 35: return new MessagePack.Formatters.Staple.EntityHierarchyVisibilityFormatter();
-                case 36: return new MessagePack.Formatters.Staple.Internal.AudioClipFormatFormatter();
-                case 37: return new MessagePack.Formatters.Staple.Internal.AudioRecompressionFormatter();
-                case 38: return new MessagePack.Formatters.Staple.Internal.FontCharacterSetFormatter();
-                case 39: return new MessagePack.Formatters.Staple.Internal.MaterialParameterSourceFormatter();
-                case 40: return new MessagePack.Formatters.Staple.Internal.MaterialParameterTypeFormatter();
-                case 41: return new MessagePack.Formatters.Staple.Internal.MeshAssetRotationFormatter();
-                case 42: return new MessagePack.Formatters.Staple.Internal.MeshAssetTypeFormatter();
-                case 43: return new MessagePack.Formatters.Staple.Internal.MeshNormalsModeFormatter();
-                case 44: return new MessagePack.Formatters.Staple.Internal.MeshSimplifyTargetFormatter();
-                case 45: return new MessagePack.Formatters.Staple.Internal.MeshTangentsModeFormatter();
-                case 46: return new MessagePack.Formatters.Staple.Internal.SceneObjectKindFormatter();
-                case 47: return new MessagePack.Formatters.Staple.Internal.ShaderTypeFormatter();
-                case 48: return new MessagePack.Formatters.Staple.Internal.ShaderUniformTypeFormatter();
-                case 49: return new MessagePack.Formatters.Staple.Internal.SpriteTextureMethodFormatter();
-                case 50: return new MessagePack.Formatters.Staple.Internal.TextureFilterFormatter();
-                case 51: return new MessagePack.Formatters.Staple.Internal.TextureMetadataFormatFormatter();
-                case 52: return new MessagePack.Formatters.Staple.Internal.TextureMetadataQualityFormatter();
-                case 53: return new MessagePack.Formatters.Staple.Internal.TextureSpriteRotationFormatter();
-                case 54: return new MessagePack.Formatters.Staple.Internal.TextureTypeFormatter();
-                case 55: return new MessagePack.Formatters.Staple.Internal.TextureWrapFormatter();
-                case 56: return new MessagePack.Formatters.Staple.MaterialLightingFormatter();
-                case 57: return new MessagePack.Formatters.Staple.MaterialRenderQueueFormatter();
-                case 58: return new MessagePack.Formatters.Staple.MeshTopologyFormatter();
-                case 59: return new MessagePack.Formatters.Staple.RendererTypeFormatter();
-                case 60: return new MessagePack.Formatters.Staple.StandardTextureColorComponentsFormatter();
-                case 61: return new MessagePack.Formatters.Staple.VertexAttributeFormatter();
-                case 62: return new MessagePack.Formatters.Staple.WindowModeFormatter();
-                case 63: return new MessagePack.Formatters.Staple.X64InstructionLevelFormatter();
-                case 64: return new MessagePack.Formatters.Staple.AppSettingsFormatter();
-                case 65: return new MessagePack.Formatters.Staple.ColliderMask_ItemFormatter();
-                case 66: return new MessagePack.Formatters.Staple.ColorFormatter();
-                case 67: return new MessagePack.Formatters.Staple.Color32Formatter();
-                case 68: return new MessagePack.Formatters.Staple.Internal.AppSettingsHeaderFormatter();
-                case 69: return new MessagePack.Formatters.Staple.Internal.AssetHolderFormatter();
-                case 70: return new MessagePack.Formatters.Staple.Internal.AudioClipMetadataFormatter();
-                case 71: return new MessagePack.Formatters.Staple.Internal.ComputeShaderMetricsFormatter();
-                case 72: return new MessagePack.Formatters.Staple.Internal.FolderAssetFormatter();
-                case 73: return new MessagePack.Formatters.Staple.Internal.FontGlyphInfoFormatter();
-                case 74: return new MessagePack.Formatters.Staple.Internal.FontMetadataFormatter();
-                case 75: return new MessagePack.Formatters.Staple.Internal.MaterialMetadataFormatter();
-                case 76: return new MessagePack.Formatters.Staple.Internal.MaterialParameterFormatter();
-                case 77: return new MessagePack.Formatters.Staple.Internal.Matrix4x4HolderFormatter();
-                case 78: return new MessagePack.Formatters.Staple.Internal.MeshAdjustmentTransformFormatter();
-                case 79: return new MessagePack.Formatters.Staple.Internal.MeshAssetAnimationFormatter();
-                case 80: return new MessagePack.Formatters.Staple.Internal.MeshAssetAnimationChannelFormatter();
-                case 81: return new MessagePack.Formatters.Staple.Internal.MeshAssetBoneFormatter();
-                case 82: return new MessagePack.Formatters.Staple.Internal.MeshAssetMeshInfoFormatter();
-                case 83: return new MessagePack.Formatters.Staple.Internal.MeshAssetMetadataFormatter();
-                case 84: return new MessagePack.Formatters.Staple.Internal.MeshAssetNodeFormatter();
-                case 85: return new MessagePack.Formatters.Staple.Internal.MeshAssetQuaternionAnimationKeyFormatter();
-                case 86: return new MessagePack.Formatters.Staple.Internal.MeshAssetVectorAnimationKeyFormatter();
-                case 87: return new MessagePack.Formatters.Staple.Internal.ResourcePak_EntryFormatter();
-                case 88: return new MessagePack.Formatters.Staple.Internal.ResourcePak_HeaderFormatter();
-                case 89: return new MessagePack.Formatters.Staple.Internal.SceneComponentFormatter();
-                case 90: return new MessagePack.Formatters.Staple.Internal.SceneListFormatter();
-                case 91: return new MessagePack.Formatters.Staple.Internal.SceneListHeaderFormatter();
-                case 92: return new MessagePack.Formatters.Staple.Internal.SceneObjectFormatter();
-                case 93: return new MessagePack.Formatters.Staple.Internal.SceneObjectTransformFormatter();
-                case 94: return new MessagePack.Formatters.Staple.Internal.SerializableAssetDatabaseFormatter();
-                case 95: return new MessagePack.Formatters.Staple.Internal.SerializableAssetDatabaseAssetInfoFormatter();
-                case 96: return new MessagePack.Formatters.Staple.Internal.SerializableAssetDatabaseHeaderFormatter();
-                case 97: return new MessagePack.Formatters.Staple.Internal.SerializableAudioClipFormatter();
-                case 98: return new MessagePack.Formatters.Staple.Internal.SerializableAudioClipHeaderFormatter();
-                case 99: return new MessagePack.Formatters.Staple.Internal.SerializableFontFormatter();
-                case 100: return new MessagePack.Formatters.Staple.Internal.SerializableFontHeaderFormatter();
-                case 101: return new MessagePack.Formatters.Staple.Internal.SerializableMaterialFormatter();
-                case 102: return new MessagePack.Formatters.Staple.Internal.SerializableMaterialHeaderFormatter();
-                case 103: return new MessagePack.Formatters.Staple.Internal.SerializableMeshAssetFormatter();
-                case 104: return new MessagePack.Formatters.Staple.Internal.SerializableMeshAssetHeaderFormatter();
-                case 105: return new MessagePack.Formatters.Staple.Internal.SerializablePrefabFormatter();
-                case 106: return new MessagePack.Formatters.Staple.Internal.SerializablePrefabHeaderFormatter();
-                case 107: return new MessagePack.Formatters.Staple.Internal.SerializableSceneFormatter();
-                case 108: return new MessagePack.Formatters.Staple.Internal.SerializableSceneHeaderFormatter();
-                case 109: return new MessagePack.Formatters.Staple.Internal.SerializableShaderFormatter();
-                case 110: return new MessagePack.Formatters.Staple.Internal.SerializableShaderDataFormatter();
-                case 111: return new MessagePack.Formatters.Staple.Internal.SerializableShaderEntryFormatter();
-                case 112: return new MessagePack.Formatters.Staple.Internal.SerializableShaderHeaderFormatter();
-                case 113: return new MessagePack.Formatters.Staple.Internal.SerializableStapleAssetFormatter();
-                case 114: return new MessagePack.Formatters.Staple.Internal.SerializableStapleAssetContainerFormatter();
-                case 115: return new MessagePack.Formatters.Staple.Internal.SerializableStapleAssetHeaderFormatter();
-                case 116: return new MessagePack.Formatters.Staple.Internal.SerializableStapleAssetParameterFormatter();
-                case 117: return new MessagePack.Formatters.Staple.Internal.SerializableTextAssetFormatter();
-                case 118: return new MessagePack.Formatters.Staple.Internal.SerializableTextAssetHeaderFormatter();
-                case 119: return new MessagePack.Formatters.Staple.Internal.SerializableTextureFormatter();
-                case 120: return new MessagePack.Formatters.Staple.Internal.SerializableTextureCPUDataFormatter();
-                case 121: return new MessagePack.Formatters.Staple.Internal.SerializableTextureHeaderFormatter();
-                case 122: return new MessagePack.Formatters.Staple.Internal.ShaderInstanceParameterFormatter();
-                case 123: return new MessagePack.Formatters.Staple.Internal.ShaderMetadataFormatter();
-                case 124: return new MessagePack.Formatters.Staple.Internal.ShaderUniformFormatter();
-                case 125: return new MessagePack.Formatters.Staple.Internal.ShaderUniformContainerFormatter();
-                case 126: return new MessagePack.Formatters.Staple.Internal.ShaderUniformFieldFormatter();
-                case 127: return new MessagePack.Formatters.Staple.Internal.ShaderUniformMappingFormatter();
-                case 128: return new MessagePack.Formatters.Staple.Internal.ShaderUniformTypeInfoFormatter();
-                case 129: return new MessagePack.Formatters.Staple.Internal.TextAssetMetadataFormatter();
-                case 130: return new MessagePack.Formatters.Staple.Internal.TextureMetadataFormatter();
-                case 131: return new MessagePack.Formatters.Staple.Internal.TextureMetadataOverrideFormatter();
-                case 132: return new MessagePack.Formatters.Staple.Internal.TextureSpriteInfoFormatter();
-                case 133: return new MessagePack.Formatters.Staple.Internal.Vector2HolderFormatter();
-                case 134: return new MessagePack.Formatters.Staple.Internal.Vector3HolderFormatter();
-                case 135: return new MessagePack.Formatters.Staple.Internal.Vector4HolderFormatter();
-                case 136: return new MessagePack.Formatters.Staple.Internal.VertexFragmentShaderMetricsFormatter();
-                case 137: return new MessagePack.Formatters.Staple.LayerMaskFormatter();
-                case 138: return new MessagePack.Formatters.Staple.RectFormatter();
-                case 139: return new MessagePack.Formatters.Staple.RectFloatFormatter();
-                case 140: return new MessagePack.Formatters.Staple.Vector2IntFormatter();
-                case 141: return new MessagePack.Formatters.Staple.Vector3IntFormatter();
-                case 142: return new MessagePack.Formatters.Staple.Vector4IntFormatter();
+                case 4: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetLODGroup>();
+                case 5: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetLODLevel>();
+                case 6: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetMeshInfo>();
+                case 7: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetMeshlet>();
+                case 8: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetNode>();
+                case 9: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetQuaternionAnimationKey>();
+                case 10: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.MeshAssetVectorAnimationKey>();
+                case 11: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.SceneComponent>();
+                case 12: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.SceneObject>();
+                case 13: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.ShaderInstanceParameter>();
+                case 14: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.ShaderUniform>();
+                case 15: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.ShaderUniformField>();
+                case 16: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.Vector2Holder>();
+                case 17: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.Vector3Holder>();
+                case 18: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.Internal.Vector4Holder>();
+                case 19: return new global::MessagePack.Formatters.ArrayFormatter<global::Staple.VertexAttribute>();
+                case 20: return new global::MessagePack.Formatters.DictionaryFormatter<global::Staple.AppPlatform, global::Staple.Internal.TextureMetadataOverride>();
+                case 21: return new global::MessagePack.Formatters.DictionaryFormatter<global::Staple.AppPlatform, global::System.Collections.Generic.List<global::Staple.RendererType>>();
+                case 22: return new global::MessagePack.Formatters.DictionaryFormatter<global::Staple.RendererType, global::Staple.Internal.SerializableShaderEntry>();
+                case 23: return new global::MessagePack.Formatters.DictionaryFormatter<string, global::Staple.Internal.MaterialParameter>();
+                case 24: return new global::MessagePack.Formatters.DictionaryFormatter<string, global::Staple.Internal.SerializableShaderData>();
+                case 25: return new global::MessagePack.Formatters.DictionaryFormatter<string, global::Staple.Internal.SerializableStapleAssetParameter>();
+                case 26: return new global::MessagePack.Formatters.DictionaryFormatter<string, global::System.Collections.Generic.List<global::Staple.Internal.SerializableAssetDatabaseAssetInfo>>();
+                case 27: return new global::MessagePack.Formatters.DictionaryFormatter<string, object>();
+                case 28: return new global::MessagePack.Formatters.ListFormatter<global::Staple.Internal.SerializableAssetDatabaseAssetInfo>();
+                case 29: return new global::MessagePack.Formatters.ListFormatter<global::Staple.Internal.ShaderUniformMapping>();
+                case 30: return new global::MessagePack.Formatters.ListFormatter<global::Staple.Internal.TextureSpriteInfo>();
+                case 31: return new global::MessagePack.Formatters.ListFormatter<global::Staple.RendererType>();
+                case 32: return new global::MessagePack.Formatters.ListFormatter<int>();
+                case 33: return new global::MessagePack.Formatters.ListFormatter<string>();
+                case 34: return new MessagePack.Formatters.Staple.AppPlatformFormatter();
+                case 35: return new MessagePack.Formatters.Staple.AppProfilingModeFormatter();
+                case 36: return new MessagePack.Formatters.Staple.BlendModeFormatter();
+                case 37: return new MessagePack.Formatters.Staple.CullingModeFormatter();
+                case 38: return new MessagePack.Formatters.Staple.EntityHierarchyVisibilityFormatter();
+                case 39: return new MessagePack.Formatters.Staple.Internal.AudioClipFormatFormatter();
+                case 40: return new MessagePack.Formatters.Staple.Internal.AudioRecompressionFormatter();
+                case 41: return new MessagePack.Formatters.Staple.Internal.FontCharacterSetFormatter();
+                case 42: return new MessagePack.Formatters.Staple.Internal.FontRenderModeFormatter();
+                case 43: return new MessagePack.Formatters.Staple.Internal.MaterialParameterSourceFormatter();
+                case 44: return new MessagePack.Formatters.Staple.Internal.MaterialParameterTypeFormatter();
+                case 45: return new MessagePack.Formatters.Staple.Internal.MeshAssetRotationFormatter();
+                case 46: return new MessagePack.Formatters.Staple.Internal.MeshAssetTypeFormatter();
+                case 47: return new MessagePack.Formatters.Staple.Internal.MeshNormalsModeFormatter();
+                case 48: return new MessagePack.Formatters.Staple.Internal.MeshSimplifyTargetFormatter();
+                case 49: return new MessagePack.Formatters.Staple.Internal.MeshTangentsModeFormatter();
+                case 50: return new MessagePack.Formatters.Staple.Internal.SceneObjectKindFormatter();
+                case 51: return new MessagePack.Formatters.Staple.Internal.ShaderTypeFormatter();
+                case 52: return new MessagePack.Formatters.Staple.Internal.ShaderUniformTypeFormatter();
+                case 53: return new MessagePack.Formatters.Staple.Internal.SpriteTextureMethodFormatter();
+                case 54: return new MessagePack.Formatters.Staple.Internal.TextureFilterFormatter();
+                case 55: return new MessagePack.Formatters.Staple.Internal.TextureMetadataFormatFormatter();
+                case 56: return new MessagePack.Formatters.Staple.Internal.TextureMetadataQualityFormatter();
+                case 57: return new MessagePack.Formatters.Staple.Internal.TextureSpriteRotationFormatter();
+                case 58: return new MessagePack.Formatters.Staple.Internal.TextureTypeFormatter();
+                case 59: return new MessagePack.Formatters.Staple.Internal.TextureWrapFormatter();
+                case 60: return new MessagePack.Formatters.Staple.MaterialLightingFormatter();
+                case 61: return new MessagePack.Formatters.Staple.MaterialRenderQueueFormatter();
+                case 62: return new MessagePack.Formatters.Staple.MeshTopologyFormatter();
+                case 63: return new MessagePack.Formatters.Staple.RendererTypeFormatter();
+                case 64: return new MessagePack.Formatters.Staple.StandardTextureColorComponentsFormatter();
+                case 65: return new MessagePack.Formatters.Staple.VertexAttributeFormatter();
+                case 66: return new MessagePack.Formatters.Staple.WindowModeFormatter();
+                case 67: return new MessagePack.Formatters.Staple.X64InstructionLevelFormatter();
+                case 68: return new MessagePack.Formatters.Staple.AppSettingsFormatter();
+                case 69: return new MessagePack.Formatters.Staple.ColliderMask_ItemFormatter();
+                case 70: return new MessagePack.Formatters.Staple.ColorFormatter();
+                case 71: return new MessagePack.Formatters.Staple.Color32Formatter();
+                case 72: return new MessagePack.Formatters.Staple.Internal.AppSettingsHeaderFormatter();
+                case 73: return new MessagePack.Formatters.Staple.Internal.AssetHolderFormatter();
+                case 74: return new MessagePack.Formatters.Staple.Internal.AudioClipMetadataFormatter();
+                case 75: return new MessagePack.Formatters.Staple.Internal.ComputeShaderMetricsFormatter();
+                case 76: return new MessagePack.Formatters.Staple.Internal.FolderAssetFormatter();
+                case 77: return new MessagePack.Formatters.Staple.Internal.FontGlyphInfoFormatter();
+                case 78: return new MessagePack.Formatters.Staple.Internal.FontMetadataFormatter();
+                case 79: return new MessagePack.Formatters.Staple.Internal.MaterialMetadataFormatter();
+                case 80: return new MessagePack.Formatters.Staple.Internal.MaterialParameterFormatter();
+                case 81: return new MessagePack.Formatters.Staple.Internal.Matrix4x4HolderFormatter();
+                case 82: return new MessagePack.Formatters.Staple.Internal.MeshAdjustmentTransformFormatter();
+                case 83: return new MessagePack.Formatters.Staple.Internal.MeshAssetAnimationFormatter();
+                case 84: return new MessagePack.Formatters.Staple.Internal.MeshAssetAnimationChannelFormatter();
+                case 85: return new MessagePack.Formatters.Staple.Internal.MeshAssetBoneFormatter();
+                case 86: return new MessagePack.Formatters.Staple.Internal.MeshAssetLODGroupFormatter();
+                case 87: return new MessagePack.Formatters.Staple.Internal.MeshAssetLODLevelFormatter();
+                case 88: return new MessagePack.Formatters.Staple.Internal.MeshAssetMeshInfoFormatter();
+                case 89: return new MessagePack.Formatters.Staple.Internal.MeshAssetMeshletFormatter();
+                case 90: return new MessagePack.Formatters.Staple.Internal.MeshAssetMetadataFormatter();
+                case 91: return new MessagePack.Formatters.Staple.Internal.MeshAssetNodeFormatter();
+                case 92: return new MessagePack.Formatters.Staple.Internal.MeshAssetQuaternionAnimationKeyFormatter();
+                case 93: return new MessagePack.Formatters.Staple.Internal.MeshAssetVectorAnimationKeyFormatter();
+                case 94: return new MessagePack.Formatters.Staple.Internal.ResourcePak_EntryFormatter();
+                case 95: return new MessagePack.Formatters.Staple.Internal.ResourcePak_HeaderFormatter();
+                case 96: return new MessagePack.Formatters.Staple.Internal.SceneComponentFormatter();
+                case 97: return new MessagePack.Formatters.Staple.Internal.SceneListFormatter();
+                case 98: return new MessagePack.Formatters.Staple.Internal.SceneListHeaderFormatter();
+                case 99: return new MessagePack.Formatters.Staple.Internal.SceneObjectFormatter();
+                case 100: return new MessagePack.Formatters.Staple.Internal.SceneObjectTransformFormatter();
+                case 101: return new MessagePack.Formatters.Staple.Internal.SerializableAssetDatabaseFormatter();
+                case 102: return new MessagePack.Formatters.Staple.Internal.SerializableAssetDatabaseAssetInfoFormatter();
+                case 103: return new MessagePack.Formatters.Staple.Internal.SerializableAssetDatabaseHeaderFormatter();
+                case 104: return new MessagePack.Formatters.Staple.Internal.SerializableAudioClipFormatter();
+                case 105: return new MessagePack.Formatters.Staple.Internal.SerializableAudioClipHeaderFormatter();
+                case 106: return new MessagePack.Formatters.Staple.Internal.SerializableFontFormatter();
+                case 107: return new MessagePack.Formatters.Staple.Internal.SerializableFontHeaderFormatter();
+                case 108: return new MessagePack.Formatters.Staple.Internal.SerializableMaterialFormatter();
+                case 109: return new MessagePack.Formatters.Staple.Internal.SerializableMaterialHeaderFormatter();
+                case 110: return new MessagePack.Formatters.Staple.Internal.SerializableMeshAssetFormatter();
+                case 111: return new MessagePack.Formatters.Staple.Internal.SerializableMeshAssetHeaderFormatter();
+                case 112: return new MessagePack.Formatters.Staple.Internal.SerializablePrefabFormatter();
+                case 113: return new MessagePack.Formatters.Staple.Internal.SerializablePrefabHeaderFormatter();
+                case 114: return new MessagePack.Formatters.Staple.Internal.SerializableSceneFormatter();
+                case 115: return new MessagePack.Formatters.Staple.Internal.SerializableSceneHeaderFormatter();
+                case 116: return new MessagePack.Formatters.Staple.Internal.SerializableShaderFormatter();
+                case 117: return new MessagePack.Formatters.Staple.Internal.SerializableShaderDataFormatter();
+                case 118: return new MessagePack.Formatters.Staple.Internal.SerializableShaderEntryFormatter();
+                case 119: return new MessagePack.Formatters.Staple.Internal.SerializableShaderHeaderFormatter();
+                case 120: return new MessagePack.Formatters.Staple.Internal.SerializableStapleAssetFormatter();
+                case 121: return new MessagePack.Formatters.Staple.Internal.SerializableStapleAssetContainerFormatter();
+                case 122: return new MessagePack.Formatters.Staple.Internal.SerializableStapleAssetHeaderFormatter();
+                case 123: return new MessagePack.Formatters.Staple.Internal.SerializableStapleAssetParameterFormatter();
+                case 124: return new MessagePack.Formatters.Staple.Internal.SerializableTextAssetFormatter();
+                case 125: return new MessagePack.Formatters.Staple.Internal.SerializableTextAssetHeaderFormatter();
+                case 126: return new MessagePack.Formatters.Staple.Internal.SerializableTextureFormatter();
+                case 127: return new MessagePack.Formatters.Staple.Internal.SerializableTextureCPUDataFormatter();
+                case 128: return new MessagePack.Formatters.Staple.Internal.SerializableTextureHeaderFormatter();
+                case 129: return new MessagePack.Formatters.Staple.Internal.ShaderInstanceParameterFormatter();
+                case 130: return new MessagePack.Formatters.Staple.Internal.ShaderMetadataFormatter();
+                case 131: return new MessagePack.Formatters.Staple.Internal.ShaderUniformFormatter();
+                case 132: return new MessagePack.Formatters.Staple.Internal.ShaderUniformContainerFormatter();
+                case 133: return new MessagePack.Formatters.Staple.Internal.ShaderUniformFieldFormatter();
+                case 134: return new MessagePack.Formatters.Staple.Internal.ShaderUniformMappingFormatter();
+                case 135: return new MessagePack.Formatters.Staple.Internal.ShaderUniformTypeInfoFormatter();
+                case 136: return new MessagePack.Formatters.Staple.Internal.TextAssetMetadataFormatter();
+                case 137: return new MessagePack.Formatters.Staple.Internal.TextureMetadataFormatter();
+                case 138: return new MessagePack.Formatters.Staple.Internal.TextureMetadataOverrideFormatter();
+                case 139: return new MessagePack.Formatters.Staple.Internal.TextureSpriteInfoFormatter();
+                case 140: return new MessagePack.Formatters.Staple.Internal.Vector2HolderFormatter();
+                case 141: return new MessagePack.Formatters.Staple.Internal.Vector3HolderFormatter();
+                case 142: return new MessagePack.Formatters.Staple.Internal.Vector4HolderFormatter();
+                case 143: return new MessagePack.Formatters.Staple.Internal.VertexFragmentShaderMetricsFormatter();
+                case 144: return new MessagePack.Formatters.Staple.LayerMaskFormatter();
+                case 145: return new MessagePack.Formatters.Staple.RectFormatter();
+                case 146: return new MessagePack.Formatters.Staple.RectFloatFormatter();
+                case 147: return new MessagePack.Formatters.Staple.Vector2IntFormatter();
+                case 148: return new MessagePack.Formatters.Staple.Vector3IntFormatter();
+                case 149: return new MessagePack.Formatters.Staple.Vector4IntFormatter();
                 default: return null;
             }
         }
@@ -625,6 +639,19 @@ namespace MessagePack.Formatters.Staple.Internal
         }
     }
 
+    public sealed class FontRenderModeFormatter : global::MessagePack.Formatters.IMessagePackFormatter<global::Staple.Internal.FontRenderMode>
+    {
+        public void Serialize(ref MessagePackWriter writer, global::Staple.Internal.FontRenderMode value, global::MessagePack.MessagePackSerializerOptions options)
+        {
+            writer.Write((Int32)value);
+        }
+
+        public global::Staple.Internal.FontRenderMode Deserialize(ref MessagePackReader reader, global::MessagePack.MessagePackSerializerOptions options)
+        {
+            return (global::Staple.Internal.FontRenderMode)reader.ReadInt32();
+        }
+    }
+
     public sealed class MaterialParameterSourceFormatter : global::MessagePack.Formatters.IMessagePackFormatter<global::Staple.Internal.MaterialParameterSource>
     {
         public void Serialize(ref MessagePackWriter writer, global::Staple.Internal.MaterialParameterSource value, global::MessagePack.MessagePackSerializerOptions options)
@@ -1893,13 +1920,16 @@ namespace MessagePack.Formatters.Staple.Internal
             }
 
             global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
-            writer.WriteArrayHeader(6);
+            writer.WriteArrayHeader(9);
             formatterResolver.GetFormatterWithVerify<string>().Serialize(ref writer, value.guid, options);
             formatterResolver.GetFormatterWithVerify<global::System.Collections.Generic.List<int>>().Serialize(ref writer, value.expectedSizes, options);
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.FontCharacterSet>().Serialize(ref writer, value.includedCharacterSets, options);
             writer.Write(value.textureSize);
             writer.Write(value.useAntiAliasing);
             formatterResolver.GetFormatterWithVerify<string>().Serialize(ref writer, value.typeName, options);
+            formatterResolver.GetFormatterWithVerify<global::Staple.Internal.FontRenderMode>().Serialize(ref writer, value.renderMode, options);
+            writer.Write(value.distanceFieldSpread);
+            writer.Write(value.distanceFieldSize);
         }
 
         public global::Staple.Internal.FontMetadata Deserialize(ref global::MessagePack.MessagePackReader reader, global::MessagePack.MessagePackSerializerOptions options)
@@ -1936,6 +1966,15 @@ namespace MessagePack.Formatters.Staple.Internal
                     case 5:
                         ____result.typeName = formatterResolver.GetFormatterWithVerify<string>().Deserialize(ref reader, options);
                         break;
+                    case 6:
+                        ____result.renderMode = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.FontRenderMode>().Deserialize(ref reader, options);
+                        break;
+                    case 7:
+                        ____result.distanceFieldSpread = reader.ReadInt32();
+                        break;
+                    case 8:
+                        ____result.distanceFieldSize = reader.ReadInt32();
+                        break;
                     default:
                         reader.Skip();
                         break;
@@ -2403,6 +2442,114 @@ namespace MessagePack.Formatters.Staple.Internal
         }
     }
 
+    public sealed class MeshAssetLODGroupFormatter : global::MessagePack.Formatters.IMessagePackFormatter<global::Staple.Internal.MeshAssetLODGroup>
+    {
+
+        public void Serialize(ref global::MessagePack.MessagePackWriter writer, global::Staple.Internal.MeshAssetLODGroup value, global::MessagePack.MessagePackSerializerOptions options)
+        {
+            if (value == null)
+            {
+                writer.WriteNil();
+                return;
+            }
+
+            global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
+            writer.WriteArrayHeader(3);
+            writer.Write(value.nodeIndex);
+            writer.Write(value.relativeDistances);
+            formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetLODLevel[]>().Serialize(ref writer, value.levels, options);
+        }
+
+        public global::Staple.Internal.MeshAssetLODGroup Deserialize(ref global::MessagePack.MessagePackReader reader, global::MessagePack.MessagePackSerializerOptions options)
+        {
+            if (reader.TryReadNil())
+            {
+                return null;
+            }
+
+            options.Security.DepthStep(ref reader);
+            global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
+            var length = reader.ReadArrayHeader();
+            var ____result = new global::Staple.Internal.MeshAssetLODGroup();
+
+            for (int i = 0; i < length; i++)
+            {
+                switch (i)
+                {
+                    case 0:
+                        ____result.nodeIndex = reader.ReadInt32();
+                        break;
+                    case 1:
+                        ____result.relativeDistances = reader.ReadBoolean();
+                        break;
+                    case 2:
+                        ____result.levels = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetLODLevel[]>().Deserialize(ref reader, options);
+                        break;
+                    default:
+                        reader.Skip();
+                        break;
+                }
+            }
+
+            reader.Depth--;
+            return ____result;
+        }
+    }
+
+    public sealed class MeshAssetLODLevelFormatter : global::MessagePack.Formatters.IMessagePackFormatter<global::Staple.Internal.MeshAssetLODLevel>
+    {
+
+        public void Serialize(ref global::MessagePack.MessagePackWriter writer, global::Staple.Internal.MeshAssetLODLevel value, global::MessagePack.MessagePackSerializerOptions options)
+        {
+            if (value == null)
+            {
+                writer.WriteNil();
+                return;
+            }
+
+            global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
+            writer.WriteArrayHeader(3);
+            writer.Write(value.distance);
+            writer.Write(value.nodeIndex);
+            formatterResolver.GetFormatterWithVerify<global::System.Collections.Generic.List<int>>().Serialize(ref writer, value.meshIndices, options);
+        }
+
+        public global::Staple.Internal.MeshAssetLODLevel Deserialize(ref global::MessagePack.MessagePackReader reader, global::MessagePack.MessagePackSerializerOptions options)
+        {
+            if (reader.TryReadNil())
+            {
+                return null;
+            }
+
+            options.Security.DepthStep(ref reader);
+            global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
+            var length = reader.ReadArrayHeader();
+            var ____result = new global::Staple.Internal.MeshAssetLODLevel();
+
+            for (int i = 0; i < length; i++)
+            {
+                switch (i)
+                {
+                    case 0:
+                        ____result.distance = reader.ReadSingle();
+                        break;
+                    case 1:
+                        ____result.nodeIndex = reader.ReadInt32();
+                        break;
+                    case 2:
+                        ____result.meshIndices = formatterResolver.GetFormatterWithVerify<global::System.Collections.Generic.List<int>>().Deserialize(ref reader, options);
+                        break;
+                    default:
+                        reader.Skip();
+                        break;
+                }
+            }
+
+            reader.Depth--;
+            return ____result;
+        }
+    }
+
     public sealed class MeshAssetMeshInfoFormatter : global::MessagePack.Formatters.IMessagePackFormatter<global::Staple.Internal.MeshAssetMeshInfo>
     {
 
@@ -2415,7 +2562,7 @@ namespace MessagePack.Formatters.Staple.Internal
             }
 
             global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
-            writer.WriteArrayHeader(26);
+            writer.WriteArrayHeader(29);
             formatterResolver.GetFormatterWithVerify<string>().Serialize(ref writer, value.name, options);
             formatterResolver.GetFormatterWithVerify<string>().Serialize(ref writer, value.materialGuid, options);
             formatterResolver.GetFormatterWithVerify<global::Staple.MeshTopology>().Serialize(ref writer, value.topology, options);
@@ -2442,6 +2589,9 @@ namespace MessagePack.Formatters.Staple.Internal
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector4Holder[]>().Serialize(ref writer, value.colors2, options);
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector4Holder[]>().Serialize(ref writer, value.colors3, options);
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector4Holder[]>().Serialize(ref writer, value.colors4, options);
+            formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetMeshlet[]>().Serialize(ref writer, value.meshlets, options);
+            formatterResolver.GetFormatterWithVerify<uint[]>().Serialize(ref writer, value.meshletVertices, options);
+            writer.Write(value.meshletTriangles);
         }
 
         public global::Staple.Internal.MeshAssetMeshInfo Deserialize(ref global::MessagePack.MessagePackReader reader, global::MessagePack.MessagePackSerializerOptions options)
@@ -2538,6 +2688,87 @@ namespace MessagePack.Formatters.Staple.Internal
                     case 25:
                         ____result.colors4 = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector4Holder[]>().Deserialize(ref reader, options);
                         break;
+                    case 26:
+                        ____result.meshlets = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetMeshlet[]>().Deserialize(ref reader, options);
+                        break;
+                    case 27:
+                        ____result.meshletVertices = formatterResolver.GetFormatterWithVerify<uint[]>().Deserialize(ref reader, options);
+                        break;
+                    case 28:
+                        ____result.meshletTriangles = reader.ReadBytes()?.ToArray();
+                        break;
+                    default:
+                        reader.Skip();
+                        break;
+                }
+            }
+
+            reader.Depth--;
+            return ____result;
+        }
+    }
+
+    public sealed class MeshAssetMeshletFormatter : global::MessagePack.Formatters.IMessagePackFormatter<global::Staple.Internal.MeshAssetMeshlet>
+    {
+
+        public void Serialize(ref global::MessagePack.MessagePackWriter writer, global::Staple.Internal.MeshAssetMeshlet value, global::MessagePack.MessagePackSerializerOptions options)
+        {
+            global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
+            writer.WriteArrayHeader(9);
+            writer.Write(value.vertexOffset);
+            writer.Write(value.triangleOffset);
+            writer.Write(value.vertexCount);
+            writer.Write(value.triangleCount);
+            formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector3Holder>().Serialize(ref writer, value.center, options);
+            writer.Write(value.radius);
+            formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector3Holder>().Serialize(ref writer, value.coneApex, options);
+            formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector3Holder>().Serialize(ref writer, value.coneAxis, options);
+            writer.Write(value.coneCutoff);
+        }
+
+        public global::Staple.Internal.MeshAssetMeshlet Deserialize(ref global::MessagePack.MessagePackReader reader, global::MessagePack.MessagePackSerializerOptions options)
+        {
+            if (reader.TryReadNil())
+            {
+                throw new global::System.InvalidOperationException("typecode is null, struct not supported");
+            }
+
+            options.Security.DepthStep(ref reader);
+            global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
+            var length = reader.ReadArrayHeader();
+            var ____result = new global::Staple.Internal.MeshAssetMeshlet();
+
+            for (int i = 0; i < length; i++)
+            {
+                switch (i)
+                {
+                    case 0:
+                        ____result.vertexOffset = reader.ReadUInt32();
+                        break;
+                    case 1:
+                        ____result.triangleOffset = reader.ReadUInt32();
+                        break;
+                    case 2:
+                        ____result.vertexCount = reader.ReadUInt32();
+                        break;
+                    case 3:
+                        ____result.triangleCount = reader.ReadUInt32();
+                        break;
+                    case 4:
+                        ____result.center = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector3Holder>().Deserialize(ref reader, options);
+                        break;
+                    case 5:
+                        ____result.radius = reader.ReadSingle();
+                        break;
+                    case 6:
+                        ____result.coneApex = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector3Holder>().Deserialize(ref reader, options);
+                        break;
+                    case 7:
+                        ____result.coneAxis = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.Vector3Holder>().Deserialize(ref reader, options);
+                        break;
+                    case 8:
+                        ____result.coneCutoff = reader.ReadSingle();
+                        break;
                     default:
                         reader.Skip();
                         break;
@@ -2561,7 +2792,7 @@ namespace MessagePack.Formatters.Staple.Internal
             }
 
             global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
-            writer.WriteArrayHeader(18);
+            writer.WriteArrayHeader(22);
             formatterResolver.GetFormatterWithVerify<string>().Serialize(ref writer, value.guid, options);
             writer.Write(value.flipUVs);
             writer.Write(value.flipWindingOrder);
@@ -2580,6 +2811,10 @@ namespace MessagePack.Formatters.Staple.Internal
             writer.Write(value.discardOddLODLevels);
             writer.Write(value.importVertexColors);
             formatterResolver.GetFormatterWithVerify<string>().Serialize(ref writer, value.typeName, options);
+            writer.Write(value.animationSampleRate);
+            writer.Write(value.reduceAnimationKeys);
+            writer.Write(value.animationKeyReductionThreshold);
+            writer.Write(value.generateMeshlets);
         }
 
         public global::Staple.Internal.MeshAssetMetadata Deserialize(ref global::MessagePack.MessagePackReader reader, global::MessagePack.MessagePackSerializerOptions options)
@@ -2652,6 +2887,18 @@ namespace MessagePack.Formatters.Staple.Internal
                     case 17:
                         ____result.typeName = formatterResolver.GetFormatterWithVerify<string>().Deserialize(ref reader, options);
                         break;
+                    case 18:
+                        ____result.animationSampleRate = reader.ReadSingle();
+                        break;
+                    case 19:
+                        ____result.reduceAnimationKeys = reader.ReadBoolean();
+                        break;
+                    case 20:
+                        ____result.animationKeyReductionThreshold = reader.ReadSingle();
+                        break;
+                    case 21:
+                        ____result.generateMeshlets = reader.ReadBoolean();
+                        break;
                     default:
                         reader.Skip();
                         break;
@@ -3681,12 +3928,13 @@ namespace MessagePack.Formatters.Staple.Internal
             }
 
             global::MessagePack.IFormatterResolver formatterResolver = options.Resolver;
-            writer.WriteArrayHeader(5);
+            writer.WriteArrayHeader(6);
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetMetadata>().Serialize(ref writer, value.metadata, options);
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetMeshInfo[]>().Serialize(ref writer, value.meshes, options);
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetNode[]>().Serialize(ref writer, value.nodes, options);
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetAnimation[]>().Serialize(ref writer, value.animations, options);
             formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAdjustmentTransform>().Serialize(ref writer, value.adjustmentTransform, options);
+            formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetLODGroup[]>().Serialize(ref writer, value.lodGroups, options);
         }
 
         public global::Staple.Internal.SerializableMeshAsset Deserialize(ref global::MessagePack.MessagePackReader reader, global::MessagePack.MessagePackSerializerOptions options)
@@ -3720,6 +3968,9 @@ namespace MessagePack.Formatters.Staple.Internal
                     case 4:
                         ____result.adjustmentTransform = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAdjustmentTransform>().Deserialize(ref reader, options);
                         break;
+                    case 5:
+                        ____result.lodGroups = formatterResolver.GetFormatterWithVerify<global::Staple.Internal.MeshAssetLODGroup[]>().Deserialize(ref reader, options);
+                        break;
                     default:
                         reader.Skip();
                         break;
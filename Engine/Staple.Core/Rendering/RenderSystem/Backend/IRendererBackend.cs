@@ -67,6 +67,8 @@ internal interface IRendererBackend
 
     void ReadTexture(ITexture texture, Action<byte[]> onComplete);
 
+    void UpdateTexture(ITexture texture, Span<byte> data, int x, int y, int width, int height);
+
     void Render(RenderState state);
 
     void RenderStatic(RenderState state, Span<MultidrawEntry> entries);
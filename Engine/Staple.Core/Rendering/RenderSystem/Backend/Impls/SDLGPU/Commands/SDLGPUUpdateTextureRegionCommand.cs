@@ -0,0 +1,61 @@
+﻿using SDL;
+using System;
+
+namespace Staple.Internal;
+
+internal unsafe class SDLGPUUpdateTextureRegionCommand(SDLGPURendererBackend backend, ResourceHandle<Texture> handle, byte[] data,
+    int x, int y, int width, int height) : IRenderCommand
+{
+    public void Update()
+    {
+        if (!backend.TryGetTexture(handle, out var resource) ||
+            data.Length > resource.length ||
+            x + width > resource.width ||
+            y + height > resource.height)
+        {
+            return;
+        }
+
+        //Regions are never larger than the whole texture, so they share its transfer buffer
+        if (resource.transferBuffer == null)
+        {
+            resource.transferBuffer = backend.GetTransferBuffer(false, resource.length);
+
+            if (resource.transferBuffer == null)
+            {
+                return;
+            }
+        }
+
+        if (!backend.BeginCopyPass())
+        {
+            return;
+        }
+
+        var mapData = SDL3.SDL_MapGPUTransferBuffer(backend.device, resource.transferBuffer, true);
+
+        data.CopyTo(new Span<byte>((void*)mapData, data.Length));
+
+        SDL3.SDL_UnmapGPUTransferBuffer(backend.device, resource.transferBuffer);
+
+        var textureInfo = new SDL_GPUTextureTransferInfo()
+        {
+            offset = 0,
+            pixels_per_row = (uint)width,
+            rows_per_layer = (uint)height,
+            transfer_buffer = resource.transferBuffer,
+        };
+
+        var destination = new SDL_GPUTextureRegion()
+        {
+            texture = resource.texture,
+            x = (uint)x,
+            y = (uint)y,
+            w = (uint)width,
+            h = (uint)height,
+            d = 1,
+        };
+
+        SDL3.SDL_UploadToGPUTexture(backend.copyPass, &textureInfo, &destination, false);
+    }
+}
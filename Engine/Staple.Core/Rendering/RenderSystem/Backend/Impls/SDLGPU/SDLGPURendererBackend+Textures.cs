@@ -329,6 +329,18 @@ internal partial class SDLGPURendererBackend
         AddCommand(new SDLGPUUpdateTextureCommand(this, handle, data.ToArray()));
     }
 
+    public void UpdateTexture(ITexture texture, Span<byte> data, int x, int y, int width, int height)
+    {
+        if(texture is not SDLGPUTexture t ||
+            t.Disposed ||
+            !t.handle.IsValid)
+        {
+            return;
+        }
+
+        AddCommand(new SDLGPUUpdateTextureRegionCommand(this, t.handle, data.ToArray(), x, y, width, height));
+    }
+
     public void ReadTexture(ITexture texture, Action<byte[]> onComplete)
     {
         if(texture is not SDLGPUTexture t ||
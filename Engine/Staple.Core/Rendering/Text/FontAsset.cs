@@ -44,6 +44,17 @@ public class FontAsset : IGuidAsset
 
             asset.fontResource.font.includedRanges = metadata.includedCharacterSets;
             asset.fontResource.font.textureSize = metadata.textureSize;
+            asset.fontResource.font.renderMode = metadata.renderMode;
+            asset.fontResource.font.distanceFieldSpread = Math.Clamp(metadata.distanceFieldSpread,
+                TextFont.MinDistanceFieldSpread, TextFont.MaxDistanceFieldSpread);
+            asset.fontResource.font.distanceFieldSize = Math.Max(metadata.distanceFieldSize, 1);
+
+            //Distance field fonts have a single atlas for every size
+            if(asset.fontResource.font.IsDistanceField)
+            {
+                return asset.fontResource.font.MakePixelData(asset.fontResource.font.distanceFieldSize, metadata.textureSize,
+                    out _, out _, out _);
+            }
 
             foreach(var size in metadata.expectedSizes)
             {
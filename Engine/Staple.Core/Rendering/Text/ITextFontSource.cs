@@ -13,5 +13,16 @@ public interface ITextFontSource : IDisposable
     Glyph LoadGlyph(uint character, int fontSize, Color textColor, Color secondaryTextColor,
         int borderSize, Color borderColor);
 
+    /// <summary>
+    /// Renders the signed distance field of a character, padded by the spread on every side.
+    /// The edge is at 128 and each pixel of distance changes the value by 128 / spread, increasing inside the glyph.
+    /// </summary>
+    /// <param name="character">The character to render</param>
+    /// <param name="fontSize">The font size</param>
+    /// <param name="mode">SDF for one byte per pixel, MSDF for RGBA where alpha has the true distance</param>
+    /// <param name="spread">The distance in pixels covered by the field</param>
+    /// <returns>The glyph</returns>
+    Glyph LoadDistanceFieldGlyph(uint character, int fontSize, FontRenderMode mode, int spread);
+
     int Kerning(uint from, uint to);
 }
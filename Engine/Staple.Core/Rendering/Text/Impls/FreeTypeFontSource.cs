@@ -1,4 +1,6 @@
-﻿using System.Runtime.InteropServices;
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
 
 namespace Staple.Internal;
 
@@ -86,4 +88,215 @@ public class FreeTypeFontSource : ITextFontSource
             };
         }
     }
+
+    public Glyph LoadDistanceFieldGlyph(uint character, int fontSize, FontRenderMode mode, int spread)
+    {
+        if (font == nint.Zero || mode == FontRenderMode.Bitmap)
+        {
+            return Glyph.Invalid;
+        }
+
+        var glyphPtr = FreeType.LoadDistanceFieldGlyph(font, character, (uint)fontSize, GlyphFormat(mode), spread);
+
+        if (glyphPtr == nint.Zero)
+        {
+            return Glyph.Invalid;
+        }
+
+        var glyphData = Marshal.PtrToStructure<FreeType.Glyph>(glyphPtr);
+
+        unsafe
+        {
+            if ((nint)glyphData.bitmap == nint.Zero || glyphData.width == 0 || glyphData.height == 0)
+            {
+                FreeType.FreeGlyph(glyphPtr);
+
+                return Glyph.Invalid;
+            }
+
+            var size = glyphData.width * glyphData.height * (mode == FontRenderMode.SDF ? 1 : 4);
+
+            var buffer = new byte[size];
+
+            Marshal.Copy((nint)glyphData.bitmap, buffer, 0, buffer.Length);
+
+            FreeType.FreeGlyph(glyphPtr);
+
+            return new()
+            {
+                bitmap = buffer,
+                bounds = new Rect(0, (int)glyphData.width, 0, (int)glyphData.height),
+                xAdvance = (int)glyphData.xAdvance,
+                xOffset = (int)glyphData.xOffset,
+                yOffset = (int)glyphData.yOffset,
+            };
+        }
+    }
+
+    /// <summary>
+    /// Renders glyphs and packs them into a square coverage atlas in a single native call.
+    /// Each pixel has two channels, the fill coverage and the border coverage, so colors are applied when drawing.
+    /// Characters the font doesn't have and glyphs without pixels are left out.
+    /// </summary>
+    /// <param name="codepoints">The characters to render</param>
+    /// <param name="fontSize">The font size</param>
+    /// <param name="borderSize">The border size</param>
+    /// <param name="textureSize">The width and height of the atlas</param>
+    /// <param name="padding">Empty space around each glyph</param>
+    /// <param name="bitmap">The atlas pixels</param>
+    /// <param name="glyphs">The glyphs in the atlas</param>
+    /// <returns>Whether the glyphs fit in the atlas</returns>
+    public bool BuildAtlas(ReadOnlySpan<uint> codepoints, int fontSize, int borderSize, int textureSize, int padding,
+        out byte[] bitmap, out Dictionary<int, Glyph> glyphs)
+    {
+        bitmap = default;
+        glyphs = default;
+
+        if (font == nint.Zero || textureSize <= 0)
+        {
+            return false;
+        }
+
+        var atlas = new byte[textureSize * textureSize * 2];
+        var atlasGlyphs = new FreeType.AtlasGlyph[codepoints.Length];
+
+        int count;
+
+        unsafe
+        {
+            fixed (uint* c = codepoints)
+            fixed (byte* a = atlas)
+            fixed (FreeType.AtlasGlyph* g = atlasGlyphs)
+            {
+                count = FreeType.BuildAtlas(font, c, codepoints.Length, (uint)fontSize, FreeType.GlyphFormat.Coverage, Color.White,
+                    Color.White, borderSize, Color.White, a, textureSize, textureSize, padding, g);
+            }
+        }
+
+        if (count < 0)
+        {
+            return false;
+        }
+
+        glyphs = MakeAtlasGlyphs(atlasGlyphs, count, textureSize);
+        bitmap = atlas;
+
+        return true;
+    }
+
+    /// <summary>
+    /// Renders glyph distance fields and packs them into a square atlas in a single native call.
+    /// SDF atlases have one channel, MSDF atlases have RGBA pixels where alpha has the true distance.
+    /// Characters the font doesn't have and glyphs without pixels are left out.
+    /// </summary>
+    /// <param name="codepoints">The characters to render</param>
+    /// <param name="fontSize">The font size the distance field is rendered at</param>
+    /// <param name="mode">The kind of distance field</param>
+    /// <param name="spread">The distance in pixels covered by the field</param>
+    /// <param name="textureSize">The width and height of the atlas</param>
+    /// <param name="padding">Empty space around each glyph</param>
+    /// <param name="bitmap">The atlas pixels</param>
+    /// <param name="glyphs">The glyphs in the atlas</param>
+    /// <returns>Whether the glyphs fit in the atlas</returns>
+    public bool BuildDistanceFieldAtlas(ReadOnlySpan<uint> codepoints, int fontSize, FontRenderMode mode, int spread,
+        int textureSize, int padding, out byte[] bitmap, out Dictionary<int, Glyph> glyphs)
+    {
+        bitmap = default;
+        glyphs = default;
+
+        if (font == nint.Zero || textureSize <= 0 || mode == FontRenderMode.Bitmap)
+        {
+            return false;
+        }
+
+        var atlas = new byte[textureSize * textureSize * (mode == FontRenderMode.SDF ? 1 : 4)];
+        var atlasGlyphs = new FreeType.AtlasGlyph[codepoints.Length];
+
+        int count;
+
+        unsafe
+        {
+            fixed (uint* c = codepoints)
+            fixed (byte* a = atlas)
+            fixed (FreeType.AtlasGlyph* g = atlasGlyphs)
+            {
+                count = FreeType.BuildDistanceFieldAtlas(font, c, codepoints.Length, (uint)fontSize, GlyphFormat(mode), spread,
+                    a, textureSize, textureSize, padding, g);
+            }
+        }
+
+        if (count < 0)
+        {
+            return false;
+        }
+
+        glyphs = MakeAtlasGlyphs(atlasGlyphs, count, textureSize);
+        bitmap = atlas;
+
+        return true;
+    }
+
+    /// <summary>
+    /// Creates a cache that rasterizes glyphs into a square atlas when they're first requested, with the same pixels as the atlases
+    /// built by <see cref="BuildAtlas"/> and <see cref="BuildDistanceFieldAtlas"/>
+    /// </summary>
+    /// <param name="fontSize">The font size</param>
+    /// <param name="mode">How the glyphs are rendered</param>
+    /// <param name="borderSize">The border size, for bitmap glyphs</param>
+    /// <param name="spread">The distance in pixels covered by distance fields</param>
+    /// <param name="textureSize">The width and height of the atlas</param>
+    /// <param name="padding">Empty space around each glyph</param>
+    /// <returns>The cache, or null</returns>
+    public FreeTypeGlyphCache CreateGlyphCache(int fontSize, FontRenderMode mode, int borderSize, int spread, int textureSize, int padding)
+    {
+        if (font == nint.Zero || fontSize <= 0 || textureSize <= 0)
+        {
+            return null;
+        }
+
+        var cache = FreeType.CreateGlyphCache(font, (uint)fontSize, GlyphFormat(mode), borderSize, spread, textureSize, textureSize, padding);
+
+        if (cache == nint.Zero)
+        {
+            return null;
+        }
+
+        return new(cache, textureSize, mode switch
+        {
+            FontRenderMode.SDF => 1,
+            FontRenderMode.MSDF => 4,
+            _ => 2,
+        });
+    }
+
+    private static FreeType.GlyphFormat GlyphFormat(FontRenderMode mode) => mode switch
+    {
+        FontRenderMode.SDF => FreeType.GlyphFormat.SDF,
+        FontRenderMode.MSDF => FreeType.GlyphFormat.MSDF,
+        _ => FreeType.GlyphFormat.Coverage,
+    };
+
+    private static Dictionary<int, Glyph> MakeAtlasGlyphs(FreeType.AtlasGlyph[] atlasGlyphs, int count, int textureSize)
+    {
+        var glyphs = new Dictionary<int, Glyph>(count);
+
+        for (var i = 0; i < count; i++)
+        {
+            var glyph = atlasGlyphs[i];
+
+            glyphs.Add((int)glyph.codepoint, new()
+            {
+                bounds = new Rect(0, glyph.width, 0, glyph.height),
+                uvBounds = new RectFloat(glyph.x / (float)textureSize,
+                    (glyph.x + glyph.width) / (float)textureSize,
+                    glyph.y / (float)textureSize,
+                    (glyph.y + glyph.height) / (float)textureSize),
+                xAdvance = glyph.xAdvance,
+                xOffset = glyph.xOffset,
+                yOffset = glyph.yOffset,
+            });
+        }
+
+        return glyphs;
+    }
 }
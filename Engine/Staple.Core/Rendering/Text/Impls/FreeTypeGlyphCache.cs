@@ -0,0 +1,139 @@
+﻿using System;
+
+namespace Staple.Internal;
+
+/// <summary>
+/// The result of getting a glyph from a <see cref="FreeTypeGlyphCache"/>
+/// </summary>
+public enum GlyphCacheResult
+{
+    /// <summary>
+    /// The font doesn't have the character, or its glyph has no pixels
+    /// </summary>
+    Missing,
+    /// <summary>
+    /// The glyph is in the atlas
+    /// </summary>
+    Cached,
+    /// <summary>
+    /// The glyph doesn't fit in the atlas along with the other glyphs used at the same time
+    /// </summary>
+    AtlasFull,
+}
+
+/// <summary>
+/// Glyphs of a FreeType font at one size, rasterized into an atlas the first time they're requested instead of all up front.
+/// When the atlas is full the least recently used glyphs are evicted, and only the changed part of the atlas is uploaded.
+/// </summary>
+public sealed class FreeTypeGlyphCache : IDisposable
+{
+    private nint cache;
+
+    private readonly int textureSize;
+
+    private readonly int pixelSize;
+
+    private readonly byte[] dirtyPixels;
+
+    internal FreeTypeGlyphCache(nint cache, int textureSize, int pixelSize)
+    {
+        this.cache = cache;
+        this.textureSize = textureSize;
+        this.pixelSize = pixelSize;
+
+        dirtyPixels = new byte[textureSize * textureSize * pixelSize];
+    }
+
+    ~FreeTypeGlyphCache()
+    {
+        Dispose();
+    }
+
+    public void Dispose()
+    {
+        if(cache != nint.Zero)
+        {
+            FreeType.FreeGlyphCache(cache);
+
+            cache = nint.Zero;
+        }
+
+        GC.SuppressFinalize(this);
+    }
+
+    /// <summary>
+    /// Gets a glyph, rasterizing it if needed
+    /// </summary>
+    /// <param name="codepoint">The character</param>
+    /// <param name="use">When the glyph is being used, such as the current frame. Glyphs used with the same value aren't evicted,
+    /// though they can move in the atlas if it has to be packed again to fit another glyph.</param>
+    /// <param name="glyph">The glyph, if it's cached</param>
+    /// <returns>Whether the glyph is in the atlas, missing from the font, or couldn't fit</returns>
+    public GlyphCacheResult GetGlyph(uint codepoint, uint use, out Glyph glyph)
+    {
+        glyph = default;
+
+        if(cache == nint.Zero)
+        {
+            return GlyphCacheResult.Missing;
+        }
+
+        FreeType.AtlasGlyph atlasGlyph;
+
+        unsafe
+        {
+            var result = FreeType.CacheGlyph(cache, codepoint, use, &atlasGlyph);
+
+            if(result < 0)
+            {
+                return GlyphCacheResult.AtlasFull;
+            }
+
+            if(result == 0)
+            {
+                return GlyphCacheResult.Missing;
+            }
+        }
+
+        glyph = new()
+        {
+            bounds = new Rect(0, atlasGlyph.width, 0, atlasGlyph.height),
+            uvBounds = new RectFloat(atlasGlyph.x / (float)textureSize,
+                (atlasGlyph.x + atlasGlyph.width) / (float)textureSize,
+                atlasGlyph.y / (float)textureSize,
+                (atlasGlyph.y + atlasGlyph.height) / (float)textureSize),
+            xAdvance = atlasGlyph.xAdvance,
+            xOffset = atlasGlyph.xOffset,
+            yOffset = atlasGlyph.yOffset,
+        };
+
+        return GlyphCacheResult.Cached;
+    }
+
+    /// <summary>
+    /// Uploads the part of the atlas that changed since the last upload
+    /// </summary>
+    /// <param name="texture">The atlas texture</param>
+    public void UploadChanges(Texture texture)
+    {
+        if(cache == nint.Zero || texture == null)
+        {
+            return;
+        }
+
+        int x, y, width, height;
+
+        unsafe
+        {
+            fixed(byte* p = dirtyPixels)
+            {
+                if(FreeType.GlyphCacheTakeDirtyRegion(cache, &x, &y, &width, &height, p) == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        texture.UpdatePixels(dirtyPixels.AsSpan(0, width * height * pixelSize), x, y, width, height);
+    }
+}
@@ -112,4 +112,62 @@ public class StbTrueTypeFontSource : ITextFontSource
             };
         }
     }
+
+    public Glyph LoadDistanceFieldGlyph(uint character, int fontSize, FontRenderMode mode, int spread)
+    {
+        if(mode == FontRenderMode.Bitmap)
+        {
+            return Glyph.Invalid;
+        }
+
+        spread = Math.Clamp(spread, TextFont.MinDistanceFieldSpread, TextFont.MaxDistanceFieldSpread);
+
+        unsafe
+        {
+            var scale = StbTrueType.stbtt_ScaleForPixelHeight(font, fontSize);
+
+            int width, height, xOffset, yOffset, advanceWidth, leftSideBearing;
+
+            StbTrueType.stbtt_GetCodepointHMetrics(font, (int)character, &advanceWidth, &leftSideBearing);
+
+            var bitmap = StbTrueType.stbtt_GetCodepointSDF(font, scale, (int)character, spread, 128, 128.0f / spread,
+                &width, &height, &xOffset, &yOffset);
+
+            if(bitmap == null)
+            {
+                return Glyph.Invalid;
+            }
+
+            var buffer = new byte[width * height];
+
+            Marshal.Copy((nint)bitmap, buffer, 0, buffer.Length);
+
+            StbTrueType.stbtt_FreeSDF(bitmap, null);
+
+            //stb_truetype only has single channel fields, so MSDF gets the same distance in every channel
+            if(mode == FontRenderMode.MSDF)
+            {
+                var expandedBuffer = new byte[buffer.Length * 4];
+
+                for(int i = 0, localIndex = 0; i < buffer.Length; i++, localIndex += 4)
+                {
+                    expandedBuffer[localIndex] = buffer[i];
+                    expandedBuffer[localIndex + 1] = buffer[i];
+                    expandedBuffer[localIndex + 2] = buffer[i];
+                    expandedBuffer[localIndex + 3] = buffer[i];
+                }
+
+                buffer = expandedBuffer;
+            }
+
+            return new()
+            {
+                bitmap = buffer,
+                xAdvance = (int)MathF.Round(advanceWidth * scale),
+                xOffset = xOffset,
+                yOffset = yOffset,
+                bounds = new(0, width, 0, height),
+            };
+        }
+    }
 }
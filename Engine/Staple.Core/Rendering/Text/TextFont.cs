@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Runtime.InteropServices;
 
 namespace Staple.Internal;
 
@@ -14,6 +15,16 @@ internal class TextFont : IDisposable
 
         public Dictionary<int, Glyph> glyphs = [];
 
+        /// <summary>
+        /// Rasterizes glyphs into the atlas as they're requested, instead of them all being in <see cref="glyphs"/>
+        /// </summary>
+        public FreeTypeGlyphCache glyphCache;
+
+        /// <summary>
+        /// The last frame <see cref="glyphCache"/> ran out of space, so it's only logged once per frame
+        /// </summary>
+        public uint? atlasFullFrame;
+
         public Dictionary<Vector2Int, int> kerning = [];
     }
 
@@ -48,8 +59,17 @@ internal class TextFont : IDisposable
         FontCharacterSet.LatinExtendedA |
         FontCharacterSet.LatinExtendedB;
 
+    internal const int MinDistanceFieldSpread = 2;
+    internal const int MaxDistanceFieldSpread = 32;
+
     internal int textureSize;
 
+    internal FontRenderMode renderMode = FontRenderMode.Bitmap;
+
+    internal int distanceFieldSpread = 4;
+
+    internal int distanceFieldSize = 32;
+
     internal ITextFontSource fontSource;
 
     internal FontCharacterSet includedRanges;
@@ -81,106 +101,96 @@ internal class TextFont : IDisposable
         }
     }
 
-    private Color textColor = Color.White;
+    private int borderSize;
 
-    public Color TextColor
+    public int BorderSize
     {
-        get => textColor;
+        get => borderSize;
 
         set
         {
-            if(textColor == value)
+            if(borderSize == value)
             {
                 return;
             }
 
-            textColor = value;
+            borderSize = value;
 
             changed = true;
         }
     }
 
+    /// <summary>
+    /// Distance field fonts share a single atlas rendered at distanceFieldSize between every font size
+    /// </summary>
+    public bool IsDistanceField => renderMode != FontRenderMode.Bitmap;
 
-    private Color secondaryTextColor = Color.White;
+    private string key;
 
-    public Color SecondaryTextColor
+    internal string Key
     {
-        get => secondaryTextColor;
-
-        set
+        get
         {
-            if (secondaryTextColor == value)
+            if(changed)
             {
-                return;
-            }
-
-            secondaryTextColor = value;
-
-            changed = true;
-        }
-    }
-
-    private Color borderColor = Color.White;
+                changed = false;
 
-    public Color BorderColor
-    {
-        get => borderColor;
+                //Atlases only store coverage or distances, colors are applied when drawing.
+                //Distance fields are scaled to the font size and draw their borders from the distance.
+                key = IsDistanceField ? $"{renderMode}:{textureSize}:{distanceFieldSize}:{distanceFieldSpread}" :
+                    $"{FontSize}:{textureSize}:{BorderSize}";
 
-        set
-        {
-            if(borderColor == value)
-            {
-                return;
+                GenerateTextureAtlas();
             }
 
-            borderColor = value;
-
-            changed = true;
+            return key;
         }
     }
 
-
-    private int borderSize;
-
-    public int BorderSize
+    public Texture Texture
     {
-        get => borderSize;
-
-        set
+        get
         {
-            if(borderSize == value)
+            if(!atlas.TryGetValue(Key, out var info))
             {
-                return;
+                return null;
             }
 
-            borderSize = value;
+            //Upload the glyphs rasterized since the last time the atlas was drawn
+            info.glyphCache?.UploadChanges(info.atlas);
 
-            changed = true;
+            return info.atlas;
         }
     }
 
-    private string key;
+    private TextureFormat AtlasFormat => renderMode switch
+    {
+        FontRenderMode.SDF => TextureFormat.R8,
+        FontRenderMode.MSDF => TextureFormat.RGBA8,
+        _ => TextureFormat.RG8,
+    };
 
-    internal string Key
+    private int AtlasPixelSize => renderMode switch
     {
-        get
+        FontRenderMode.SDF => 1,
+        FontRenderMode.MSDF => 4,
+        _ => 2,
+    };
+
+    private bool IsIncluded(int codepoint)
+    {
+        foreach(var pair in characterRanges)
         {
-            if(changed)
+            if(includedRanges.HasFlag(pair.Key) &&
+                codepoint >= pair.Value.Item1 &&
+                codepoint <= pair.Value.Item2)
             {
-                changed = false;
-
-                key = $"{FontSize}:{textureSize}:{TextColor.r},{TextColor.g},{TextColor.b},{TextColor.a}:" +
-                    $"{SecondaryTextColor.r},{SecondaryTextColor.g},{SecondaryTextColor.b},{SecondaryTextColor.a}:" +
-                    $"{BorderSize}:{BorderColor.r},{BorderColor.g},{BorderColor.b},{BorderColor.a}";
-
-                GenerateTextureAtlas();
+                return true;
             }
-
-            return key;
         }
-    }
 
-    public Texture Texture => atlas.TryGetValue(Key, out var info) ? info.atlas : null;
+        return false;
+    }
 
     public bool MakePixelData(int fontSize, int textureSize, out byte[] bitmapData, out int lineSpacing, out Dictionary<int, Glyph> glyphs)
     {
@@ -193,7 +203,7 @@ internal class TextFont : IDisposable
             return false;
         }
 
-        glyphs = [];
+        var codepoints = new List<uint>();
 
         var values = Enum.GetValues<FontCharacterSet>();
 
@@ -208,15 +218,59 @@ internal class TextFont : IDisposable
 
             for(var c = range.Item1; c <= range.Item2; c++)
             {
-                var glyph = fontSource.LoadGlyph((uint)c, fontSize, TextColor, SecondaryTextColor, BorderSize, BorderColor);
+                codepoints.Add((uint)c);
+            }
+        }
+
+        //FreeType renders and packs the whole atlas natively instead of crossing over once per glyph
+        if(fontSource is FreeTypeFontSource freeTypeSource)
+        {
+            var built = IsDistanceField ?
+                freeTypeSource.BuildDistanceFieldAtlas(CollectionsMarshal.AsSpan(codepoints), fontSize, renderMode, distanceFieldSpread,
+                    textureSize, 1, out bitmapData, out glyphs) :
+                freeTypeSource.BuildAtlas(CollectionsMarshal.AsSpan(codepoints), fontSize, BorderSize, textureSize, 1,
+                    out bitmapData, out glyphs);
+
+            if(built)
+            {
+                lineSpacing = fontSize;
+
+                return true;
+            }
+
+            Log.Error($"Failed to pack the glyphs for {guid}: Please try increasing the texture size to be higher than {textureSize}", "TextFont");
+
+            lineSpacing = default;
+
+            return false;
+        }
+
+        glyphs = [];
+
+        foreach(var c in codepoints)
+        {
+            var glyph = IsDistanceField ? fontSource.LoadDistanceFieldGlyph(c, fontSize, renderMode, distanceFieldSpread) :
+                fontSource.LoadGlyph(c, fontSize, Color.White, Color.White, BorderSize, Color.White);
+
+            if(glyph == Glyph.Invalid || glyph.bitmap == null)
+            {
+                continue;
+            }
+
+            //Packing expects RGBA
+            if(renderMode == FontRenderMode.SDF)
+            {
+                var expanded = new byte[glyph.bitmap.Length * 4];
 
-                if(glyph == Glyph.Invalid || glyph.bitmap == null)
+                for(var i = 0; i < glyph.bitmap.Length; i++)
                 {
-                    continue;
+                    expanded[i * 4] = expanded[i * 4 + 1] = expanded[i * 4 + 2] = expanded[i * 4 + 3] = glyph.bitmap[i];
                 }
 
-                glyphs.Add(c, glyph);
+                glyph.bitmap = expanded;
             }
+
+            glyphs.Add((int)c, glyph);
         }
 
         var bitmaps = new RawTextureData[glyphs.Count];
@@ -236,7 +290,38 @@ internal class TextFont : IDisposable
 
         if(Texture.PackTextures(bitmaps, textureSize, textureSize, textureSize, 1, out var rects, out var main))
         {
-            bitmapData = main.data;
+            //Keep only the channels the atlases built by FreeType have
+            switch(renderMode)
+            {
+                case FontRenderMode.SDF:
+
+                    bitmapData = new byte[textureSize * textureSize];
+
+                    for(var i = 0; i < textureSize * textureSize; i++)
+                    {
+                        bitmapData[i] = main.data[i * 4];
+                    }
+
+                    break;
+
+                case FontRenderMode.MSDF:
+
+                    bitmapData = main.data;
+
+                    break;
+
+                default:
+
+                    bitmapData = new byte[textureSize * textureSize * 2];
+
+                    for(var i = 0; i < textureSize * textureSize; i++)
+                    {
+                        bitmapData[i * 2] = main.data[i * 4 + 3];
+                    }
+
+                    break;
+            }
+
             lineSpacing = fontSize;
 
             counter = 0;
@@ -275,24 +360,49 @@ internal class TextFont : IDisposable
             return;
         }
 
-        if(!MakePixelData(FontSize, textureSize, out var rgbBitmap, out var lineGap, out var glyphs))
+        var atlasFontSize = IsDistanceField ? distanceFieldSize : FontSize;
+
+        //FreeType rasterizes glyphs the first time they're drawn, instead of every included character up front
+        if(fontSource is FreeTypeFontSource freeTypeSource)
+        {
+            var glyphCache = freeTypeSource.CreateGlyphCache(atlasFontSize, renderMode, BorderSize, distanceFieldSpread, textureSize, 1);
+
+            var cacheTexture = glyphCache != null ? CreateAtlasTexture(new byte[textureSize * textureSize * AtlasPixelSize]) : null;
+
+            if(cacheTexture == null)
+            {
+                glyphCache?.Dispose();
+
+                failedLoads.Add(key);
+
+                return;
+            }
+
+            atlas.Add(key, new()
+            {
+                atlas = cacheTexture,
+                fontSize = atlasFontSize,
+                glyphCache = glyphCache,
+                lineSpacing = atlasFontSize,
+                ranges = includedRanges,
+            });
+
+            return;
+        }
+
+        if(!MakePixelData(atlasFontSize, textureSize, out var coverageBitmap, out var lineGap, out var glyphs))
         {
             failedLoads.Add(key);
 
             if (Platform.IsPlaying)
             {
-                Log.Debug($"[TextFont] Failed to make font atlas for {guid} with font size {FontSize} and texture size {textureSize} due to texture being too small");
+                Log.Debug($"[TextFont] Failed to make font atlas for {guid} with font size {atlasFontSize} and texture size {textureSize} due to texture being too small");
             }
 
             return;
         }
 
-        var texture = Texture.CreatePixels("", rgbBitmap, (ushort)textureSize, (ushort)textureSize, new()
-        {
-            filter = useAntiAliasing ? TextureFilter.Linear : TextureFilter.Point,
-            type = TextureType.Texture,
-            useMipmaps = false,
-        }, TextureFormat.RGBA8);
+        var texture = CreateAtlasTexture(coverageBitmap);
 
         if(texture == null)
         {
@@ -302,18 +412,30 @@ internal class TextFont : IDisposable
         atlas.Add(key, new()
         {
             atlas = texture,
-            fontSize = FontSize,
+            fontSize = atlasFontSize,
             glyphs = glyphs,
             lineSpacing = lineGap,
             ranges = includedRanges,
         });
     }
 
+    private Texture CreateAtlasTexture(byte[] pixels)
+    {
+        return Texture.CreatePixels("", pixels, (ushort)textureSize, (ushort)textureSize, new()
+        {
+            //Distance fields are reconstructed from interpolated samples, so they always need linear filtering
+            filter = useAntiAliasing || IsDistanceField ? TextureFilter.Linear : TextureFilter.Point,
+            type = TextureType.Texture,
+            useMipmaps = false,
+        }, AtlasFormat);
+    }
+
     public void Clear()
     {
         foreach(var pair in atlas)
         {
             pair.Value.atlas.Destroy();
+            pair.Value.glyphCache?.Dispose();
         }
 
         atlas.Clear();
@@ -328,6 +450,11 @@ internal class TextFont : IDisposable
             return FontSize;
         }
 
+        if(IsDistanceField)
+        {
+            return (int)MathF.Round(info.lineSpacing * FontSize / (float)info.fontSize);
+        }
+
         return info.lineSpacing;
     }
 
@@ -349,10 +476,79 @@ internal class TextFont : IDisposable
 
     public Glyph GetGlyph(int codepoint)
     {
-        return atlas.TryGetValue(Key, out var info) && info.glyphs.TryGetValue(codepoint, out var glyph) ? glyph : new();
+        if(!atlas.TryGetValue(Key, out var info))
+        {
+            return new();
+        }
+
+        Glyph glyph;
+
+        if(info.glyphCache != null)
+        {
+            if(!IsIncluded(codepoint))
+            {
+                return new();
+            }
+
+            //Glyphs drawn this frame stay in the atlas until it's rendered
+            var frame = RenderSystem.CurrentFrame;
+
+            switch(info.glyphCache.GetGlyph((uint)codepoint, frame, out glyph))
+            {
+                case GlyphCacheResult.Missing:
+
+                    return new();
+
+                case GlyphCacheResult.AtlasFull:
+
+                    if(info.atlasFullFrame != frame)
+                    {
+                        info.atlasFullFrame = frame;
+
+                        Log.Warning($"Glyph atlas for {guid} can't fit every character drawn this frame at font size {info.fontSize}, " +
+                            $"some are skipped: Please try increasing the texture size to be higher than {textureSize}", "TextFont");
+                    }
+
+                    return new();
+            }
+        }
+        else if(!info.glyphs.TryGetValue(codepoint, out glyph))
+        {
+            return new();
+        }
+
+        if(IsDistanceField)
+        {
+            var scale = FontSize / (float)info.fontSize;
+
+            glyph.bounds = new Rect(0, (int)MathF.Round(glyph.bounds.Width * scale), 0, (int)MathF.Round(glyph.bounds.Height * scale));
+            glyph.xAdvance = (int)MathF.Round(glyph.xAdvance * scale);
+            glyph.xOffset = (int)MathF.Round(glyph.xOffset * scale);
+            glyph.yOffset = (int)MathF.Round(glyph.yOffset * scale);
+        }
+
+        return glyph;
+    }
+
+    /// <summary>
+    /// Converts a border size in pixels at the current font size to the distance field units the Text shader uses.
+    /// Borders can't be wider than the spread of the distance field.
+    /// </summary>
+    /// <param name="borderSize">The border size in pixels</param>
+    /// <returns>The border width in distance field units, or 0 for bitmap fonts</returns>
+    public float DistanceFieldBorder(int borderSize)
+    {
+        if(!IsDistanceField || borderSize <= 0 || FontSize <= 0)
+        {
+            return 0;
+        }
+
+        //Distances are stored as 0.5 + pixels / (2 * spread), in pixels of the atlas font size
+        return Math.Min(borderSize * distanceFieldSize / (float)FontSize / (2 * distanceFieldSpread), 0.5f);
     }
 
-    public static TextFont FromData(byte[] data, string guid, bool useAntiAliasing, int textureSize, FontCharacterSet ranges)
+    public static TextFont FromData(byte[] data, string guid, bool useAntiAliasing, int textureSize, FontCharacterSet ranges,
+        FontRenderMode renderMode = FontRenderMode.Bitmap, int distanceFieldSpread = 4, int distanceFieldSize = 32)
     {
         var fontSource = new FreeTypeFontSource();
 
@@ -368,6 +564,9 @@ internal class TextFont : IDisposable
             fontSource = fontSource,
             textureSize = textureSize,
             includedRanges = ranges,
+            renderMode = renderMode,
+            distanceFieldSpread = Math.Clamp(distanceFieldSpread, MinDistanceFieldSpread, MaxDistanceFieldSpread),
+            distanceFieldSize = Math.Max(distanceFieldSize, 1),
         };
 
         outValue.FontSize = 14;
@@ -1,6 +1,7 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.Numerics;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Text;
 
@@ -13,6 +14,9 @@ public class TextRenderer
     {
         public Vector2 position;
         public Vector2 uv;
+        public uint color;
+        public uint borderColor;
+        public float borderWidth;
     }
 
     private TextFont defaultFont;
@@ -33,10 +37,41 @@ public class TextRenderer
     public static Lazy<VertexLayout> VertexLayout = new(() => VertexLayoutBuilder.CreateNew()
         .Add(VertexAttribute.Position, VertexAttributeType.Float2)
         .Add(VertexAttribute.TexCoord0, VertexAttributeType.Float2)
+        .Add(VertexAttribute.Color0, VertexAttributeType.UInt)
+        .Add(VertexAttribute.Color1, VertexAttributeType.UInt)
+        .Add(VertexAttribute.TexCoord1, VertexAttributeType.Float)
         .Build());
 
+    public static readonly string SDFKeyword = "SDF";
+    public static readonly string MSDFKeyword = "MSDF";
+
+    /// <summary>
+    /// The material for drawing text. Font atlases only store coverage, so it colors the text using the vertex colors.
+    /// </summary>
+    public static readonly Lazy<Material> DefaultMaterial = new(() =>
+    {
+        var material = ResourceManager.instance.LoadMaterial($"Hidden/Materials/Text.{AssetSerialization.MaterialExtension}");
+
+        if (material != null)
+        {
+            ResourceManager.instance.LockAsset(material.Guid.Guid);
+
+            if (material.materialResource?.shader is Shader s)
+            {
+                ResourceManager.instance.LockAsset(s.Guid.Guid);
+            }
+        }
+
+        return material;
+    });
+
     public static readonly TextRenderer instance = new();
 
+    /// <summary>
+    /// Copies of <see cref="DefaultMaterial"/> that draw in place of materials that don't use the Text shader
+    /// </summary>
+    private readonly ConditionalWeakTable<Material, Material> fallbackMaterials = new();
+
     public Texture FontTexture(TextParameters parameters)
     {
         var font = ResourceManager.instance.LoadFont(parameters.font)?.fontResource?.font ?? DefaultFont;
@@ -46,10 +81,7 @@ public class TextRenderer
             return null;
         }
 
-        font.TextColor = parameters.textColor;
-        font.SecondaryTextColor = parameters.secondaryTextColor;
         font.BorderSize = parameters.borderSize;
-        font.BorderColor = parameters.borderColor;
 
         //Trigger texture generation
         font.FontSize = parameters.fontSize;
@@ -57,6 +89,62 @@ public class TextRenderer
         return font.Texture;
     }
 
+    /// <summary>
+    /// Sets up a material using the Text shader to draw with the atlas of a font.
+    /// Distance field fonts enable the SDF or MSDF keywords.
+    /// </summary>
+    /// <param name="material">The material</param>
+    /// <param name="parameters">The text parameters</param>
+    /// <returns>Whether the font has an atlas to draw with</returns>
+    public bool SetupMaterial(Material material, TextParameters parameters)
+    {
+        ArgumentNullException.ThrowIfNull(material);
+
+        var font = ResourceManager.instance.LoadFont(parameters.font)?.fontResource?.font ?? DefaultFont;
+
+        if (font == null)
+        {
+            return false;
+        }
+
+        font.BorderSize = parameters.borderSize;
+        font.FontSize = parameters.fontSize;
+
+        return SetupMaterial(material, font);
+    }
+
+    private static bool SetupMaterial(Material material, TextFont font)
+    {
+        var texture = font.Texture;
+
+        if (texture == null)
+        {
+            return false;
+        }
+
+        material.MainTexture = texture;
+
+        if (font.renderMode == FontRenderMode.SDF)
+        {
+            material.EnableShaderKeyword(SDFKeyword);
+        }
+        else
+        {
+            material.DisableShaderKeyword(SDFKeyword);
+        }
+
+        if (font.renderMode == FontRenderMode.MSDF)
+        {
+            material.EnableShaderKeyword(MSDFKeyword);
+        }
+        else
+        {
+            material.DisableShaderKeyword(MSDFKeyword);
+        }
+
+        return true;
+    }
+
     public void LoadDefaultFont()
     {
         var data = Convert.FromBase64String(FontData.IntelOneMonoRegular);
@@ -456,21 +544,38 @@ public class TextRenderer
             return;
         }
 
-        font.TextColor = parameters.textColor;
-        font.SecondaryTextColor = parameters.secondaryTextColor;
         font.BorderSize = parameters.borderSize;
-        font.BorderColor = parameters.borderColor;
         font.FontSize = parameters.fontSize;
 
-        if (MakeTextGeometry(text, parameters, scale, flipY, out var vertices, out var indices))
-        {
-            material.MainTexture = font.Texture;
+        material = TextMaterial(material);
 
+        if (MakeTextGeometry(text, parameters, scale, flipY, out var vertices, out var indices) &&
+            SetupMaterial(material, font))
+        {
             Graphics.RenderSimple(vertices, VertexLayout.Value, indices, material, Vector3.Zero, transform, MeshTopology.Triangles,
                 MaterialLighting.Unlit);
         }
     }
 
+    /// <summary>
+    /// Gets the material to draw text with. Atlases only store coverage, so materials that don't use the Text shader,
+    /// such as ones made before it existed, draw with a copy of <see cref="DefaultMaterial"/> instead.
+    /// </summary>
+    /// <param name="material">The material</param>
+    /// <returns>The material to draw with</returns>
+    private Material TextMaterial(Material material)
+    {
+        var defaultMaterial = DefaultMaterial.Value;
+        var textShader = defaultMaterial?.materialResource?.shader;
+
+        if (textShader == null || material.materialResource?.shader == textShader)
+        {
+            return material;
+        }
+
+        return fallbackMaterials.GetValue(material, _ => new Material(defaultMaterial));
+    }
+
     public bool MakeTextGeometry(string text, TextParameters parameters, float scale, bool flipY,
         out PosTexVertex[] vertices, out ushort[] indices)
     {
@@ -486,15 +591,18 @@ public class TextRenderer
             return false;
         }
 
-        font.TextColor = parameters.textColor;
-        font.SecondaryTextColor = parameters.secondaryTextColor;
         font.BorderSize = parameters.borderSize;
-        font.BorderColor = parameters.borderColor;
         font.FontSize = parameters.fontSize;
 
         var lineSpace = font.LineSpacing(parameters) * scale;
         var spaceSize = parameters.fontSize * 2 / 3.0f * scale;
 
+        //The gradient goes from the top of each glyph to its bottom
+        var topColor = parameters.textColor.UIntValue;
+        var bottomColor = parameters.secondaryTextColor.UIntValue;
+        var borderColor = parameters.borderColor.UIntValue;
+        var borderWidth = font.DistanceFieldBorder(parameters.borderSize);
+
         var position = new Vector2(parameters.position.X, parameters.position.Y);
 
         var initialPosition = position;
@@ -547,25 +655,37 @@ public class TextRenderer
                                 outVertices.Add(new()
                                 {
                                     position = p + new Vector2(0, size.Y),
-                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.bottom)
+                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.bottom),
+                                    color = bottomColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 });
 
                                 outVertices.Add(new()
                                 {
                                     position = p,
-                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.top)
+                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.top),
+                                    color = topColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 });
 
                                 outVertices.Add(new()
                                 {
                                     position = p + new Vector2(size.X, 0),
-                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.top)
+                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.top),
+                                    color = topColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 });
 
                                 outVertices.Add(new()
                                 {
                                     position = p + size,
-                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.bottom)
+                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.bottom),
+                                    color = bottomColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 });
                             }
                             else
@@ -573,25 +693,37 @@ public class TextRenderer
                                 outVertices.Add(new()
                                 {
                                     position = p,
-                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.bottom)
+                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.bottom),
+                                    color = bottomColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 });
 
                                 outVertices.Add(new()
                                 {
                                     position = p + new Vector2(0, size.Y),
-                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.top)
+                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.top),
+                                    color = topColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 });
 
                                 outVertices.Add(new()
                                 {
                                     position = p + size,
-                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.top)
+                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.top),
+                                    color = topColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 });
 
                                 outVertices.Add(new()
                                 {
                                     position = p + new Vector2(size.X, 0),
-                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.bottom)
+                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.bottom),
+                                    color = bottomColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 });
                             }
 
@@ -634,15 +766,18 @@ public class TextRenderer
             return false;
         }
 
-        font.TextColor = parameters.textColor;
-        font.SecondaryTextColor = parameters.secondaryTextColor;
         font.BorderSize = parameters.borderSize;
-        font.BorderColor = parameters.borderColor;
         font.FontSize = parameters.fontSize;
 
         var lineSpace = font.LineSpacing(parameters) * scale;
         var spaceSize = parameters.fontSize * 2 / 3.0f * scale;
 
+        //The gradient goes from the top of each glyph to its bottom
+        var topColor = parameters.textColor.UIntValue;
+        var bottomColor = parameters.secondaryTextColor.UIntValue;
+        var borderColor = parameters.borderColor.UIntValue;
+        var borderWidth = font.DistanceFieldBorder(parameters.borderSize);
+
         var position = new Vector2(parameters.position.X, parameters.position.Y);
 
         var initialPosition = position;
@@ -734,25 +869,37 @@ public class TextRenderer
                                 vertices[vertexCounter++] = new()
                                 {
                                     position = p + new Vector2(0, size.Y),
-                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.bottom)
+                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.bottom),
+                                    color = bottomColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 };
 
                                 vertices[vertexCounter++] = new()
                                 {
                                     position = p,
-                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.top)
+                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.top),
+                                    color = topColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 };
 
                                 vertices[vertexCounter++] = new()
                                 {
                                     position = p + new Vector2(size.X, 0),
-                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.top)
+                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.top),
+                                    color = topColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 };
 
                                 vertices[vertexCounter++] = new()
                                 {
                                     position = p + size,
-                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.bottom)
+                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.bottom),
+                                    color = bottomColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 };
                             }
                             else
@@ -760,25 +907,37 @@ public class TextRenderer
                                 vertices[vertexCounter++] = new()
                                 {
                                     position = p,
-                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.bottom)
+                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.bottom),
+                                    color = bottomColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 };
 
                                 vertices[vertexCounter++] = new()
                                 {
                                     position = p + new Vector2(0, size.Y),
-                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.top)
+                                    uv = new Vector2(glyph.uvBounds.left, glyph.uvBounds.top),
+                                    color = topColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 };
 
                                 vertices[vertexCounter++] = new()
                                 {
                                     position = p + size,
-                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.top)
+                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.top),
+                                    color = topColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 };
 
                                 vertices[vertexCounter++] = new()
                                 {
                                     position = p + new Vector2(size.X, 0),
-                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.bottom)
+                                    uv = new Vector2(glyph.uvBounds.right, glyph.uvBounds.bottom),
+                                    color = bottomColor,
+                                    borderColor = borderColor,
+                                    borderWidth = borderWidth
                                 };
                             }
 
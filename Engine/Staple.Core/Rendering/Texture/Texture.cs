@@ -496,6 +496,30 @@ public class Texture : IGuidAsset
         RenderSystem.Backend.ReadTexture(textureResource?.impl, (result) => completion?.Invoke(this, result));
     }
 
+    /// <summary>
+    /// Replaces the pixels in a region of this texture
+    /// </summary>
+    /// <param name="data">The pixels of the region, tightly packed in the texture's format</param>
+    /// <param name="x">The left of the region</param>
+    /// <param name="y">The top of the region</param>
+    /// <param name="width">The width of the region</param>
+    /// <param name="height">The height of the region</param>
+    public void UpdatePixels(Span<byte> data, int x, int y, int width, int height)
+    {
+        if(Disposed ||
+            x < 0 ||
+            y < 0 ||
+            width <= 0 ||
+            height <= 0 ||
+            x + width > Width ||
+            y + height > Height)
+        {
+            return;
+        }
+
+        RenderSystem.Backend.UpdateTexture(textureResource?.impl, data, x, y, width, height);
+    }
+
     /// <summary>
     /// Gets the pixels in this texture as a Color array, if any
     /// </summary>
@@ -2802,7 +2802,8 @@ internal class ResourceManager
             resource.Guid.Guid = path;
 
             resource.font = TextFont.FromData(fontData.fontData, resource.Guid.Guid, fontData.metadata.useAntiAliasing,
-                fontData.metadata.textureSize, fontData.metadata.includedCharacterSets);
+                fontData.metadata.textureSize, fontData.metadata.includedCharacterSets, fontData.metadata.renderMode,
+                fontData.metadata.distanceFieldSpread, fontData.metadata.distanceFieldSize);
 
             return resource;
         }
@@ -29,6 +29,18 @@ public class FontMetadata
     [Key(5)]
     public string typeName = typeof(FontAsset).FullName;
 
+    [Key(6)]
+    [Tooltip("Bitmap renders glyphs for each font size.\nSDF and MSDF render a distance field once and scale it to any size.")]
+    public FontRenderMode renderMode = FontRenderMode.Bitmap;
+
+    [Key(7)]
+    [Tooltip("Distance in pixels covered by the distance field around each glyph's outline.\nLarger values allow wider borders.")]
+    public int distanceFieldSpread = 4;
+
+    [Key(8)]
+    [Tooltip("Font size the distance field atlas is rendered at")]
+    public int distanceFieldSize = 32;
+
     public static bool operator==(FontMetadata lhs, FontMetadata rhs)
     {
         if (lhs is null)
@@ -46,7 +58,10 @@ public class FontMetadata
             lhs.includedCharacterSets == rhs.includedCharacterSets &&
             lhs.textureSize == rhs.textureSize &&
             lhs.useAntiAliasing == rhs.useAntiAliasing &&
-            lhs.typeName == rhs.typeName;
+            lhs.typeName == rhs.typeName &&
+            lhs.renderMode == rhs.renderMode &&
+            lhs.distanceFieldSpread == rhs.distanceFieldSpread &&
+            lhs.distanceFieldSize == rhs.distanceFieldSize;
     }
 
     public static bool operator!=(FontMetadata lhs, FontMetadata rhs)
@@ -66,7 +81,10 @@ public class FontMetadata
             lhs.includedCharacterSets != rhs.includedCharacterSets ||
             lhs.textureSize != rhs.textureSize ||
             lhs.useAntiAliasing != rhs.useAntiAliasing ||
-            lhs.typeName != rhs.typeName;
+            lhs.typeName != rhs.typeName ||
+            lhs.renderMode != rhs.renderMode ||
+            lhs.distanceFieldSpread != rhs.distanceFieldSpread ||
+            lhs.distanceFieldSize != rhs.distanceFieldSize;
     }
 
     public override bool Equals(object obj)
@@ -86,6 +104,7 @@ public class FontMetadata
 
     public override int GetHashCode()
     {
-        return HashCode.Combine(guid, expectedSizes, includedCharacterSets, textureSize, useAntiAliasing, typeName);
+        return HashCode.Combine(HashCode.Combine(guid, expectedSizes, includedCharacterSets, textureSize, useAntiAliasing, typeName),
+            renderMode, distanceFieldSpread, distanceFieldSize);
     }
 }
@@ -22,6 +22,25 @@ public enum FontCharacterSet
     HangulSyllables = (1 << 13),
 }
 
+/// <summary>
+/// How a font's glyphs are rendered into its atlas
+/// </summary>
+public enum FontRenderMode
+{
+    /// <summary>
+    /// Coverage bitmaps rendered for each font size
+    /// </summary>
+    Bitmap,
+    /// <summary>
+    /// A single channel signed distance field shared by every font size
+    /// </summary>
+    SDF,
+    /// <summary>
+    /// A multi-channel signed distance field shared by every font size, keeping corners sharp when magnified
+    /// </summary>
+    MSDF,
+}
+
 [MessagePackObject]
 public class SerializableFontHeader
 {
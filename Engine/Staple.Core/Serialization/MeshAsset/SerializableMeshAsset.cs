@@ -145,6 +145,22 @@ public class MeshAssetMetadata
     [Key(17)]
     public string typeName = typeof(Mesh).FullName;
 
+    [Key(18)]
+    [Tooltip("Samples per second used when resampling animations that aren't linear")]
+    public float animationSampleRate = 30;
+
+    [Key(19)]
+    [Tooltip("Removes animation keys that can be interpolated from their neighbours")]
+    public bool reduceAnimationKeys = false;
+
+    [Key(20)]
+    [Tooltip("Maximum error of a removed animation key")]
+    public float animationKeyReductionThreshold = 0.000001f;
+
+    [Key(21)]
+    [Tooltip("Splits meshes into small clusters of triangles that can be culled on the GPU")]
+    public bool generateMeshlets = false;
+
     public static bool operator==(MeshAssetMetadata lhs, MeshAssetMetadata rhs)
     {
         if(lhs is null)
@@ -174,7 +190,11 @@ public class MeshAssetMetadata
             lhs.generateColliders == rhs.generateColliders &&
             lhs.generateLODs == rhs.generateLODs &&
             lhs.discardOddLODLevels == rhs.discardOddLODLevels &&
-            lhs.importVertexColors == rhs.importVertexColors;
+            lhs.importVertexColors == rhs.importVertexColors &&
+            lhs.animationSampleRate == rhs.animationSampleRate &&
+            lhs.reduceAnimationKeys == rhs.reduceAnimationKeys &&
+            lhs.animationKeyReductionThreshold == rhs.animationKeyReductionThreshold &&
+            lhs.generateMeshlets == rhs.generateMeshlets;
     }
 
     public static bool operator!=(MeshAssetMetadata lhs, MeshAssetMetadata rhs)
@@ -206,7 +226,11 @@ public class MeshAssetMetadata
             lhs.generateColliders != rhs.generateColliders ||
             lhs.generateLODs != rhs.generateLODs ||
             lhs.discardOddLODLevels != rhs.discardOddLODLevels ||
-            lhs.importVertexColors != rhs.importVertexColors;
+            lhs.importVertexColors != rhs.importVertexColors ||
+            lhs.animationSampleRate != rhs.animationSampleRate ||
+            lhs.reduceAnimationKeys != rhs.reduceAnimationKeys ||
+            lhs.animationKeyReductionThreshold != rhs.animationKeyReductionThreshold ||
+            lhs.generateMeshlets != rhs.generateMeshlets;
     }
 
     public override bool Equals(object obj)
@@ -246,6 +270,10 @@ public class MeshAssetMetadata
         hash.Add(generateLODs);
         hash.Add(discardOddLODLevels);
         hash.Add(importVertexColors);
+        hash.Add(animationSampleRate);
+        hash.Add(reduceAnimationKeys);
+        hash.Add(animationKeyReductionThreshold);
+        hash.Add(generateMeshlets);
 
         return hash.ToHashCode();
     }
@@ -329,6 +357,40 @@ public struct MeshAssetBone
     public Matrix4x4Holder offsetMatrix;
 }
 
+//Cluster of triangles of a mesh. Uses `vertexCount` entries of MeshAssetMeshInfo.meshletVertices starting at `vertexOffset`
+//and `triangleCount` * 3 entries of MeshAssetMeshInfo.meshletTriangles starting at `triangleOffset`.
+//The triangles face away from a camera at `position` when dot(normalize(coneApex - position), coneAxis) >= coneCutoff.
+[MessagePackObject]
+public struct MeshAssetMeshlet
+{
+    [Key(0)]
+    public uint vertexOffset;
+
+    [Key(1)]
+    public uint triangleOffset;
+
+    [Key(2)]
+    public uint vertexCount;
+
+    [Key(3)]
+    public uint triangleCount;
+
+    [Key(4)]
+    public Vector3Holder center;
+
+    [Key(5)]
+    public float radius;
+
+    [Key(6)]
+    public Vector3Holder coneApex;
+
+    [Key(7)]
+    public Vector3Holder coneAxis;
+
+    [Key(8)]
+    public float coneCutoff;
+}
+
 [MessagePackObject]
 public class MeshAssetMeshInfo
 {
@@ -410,6 +472,21 @@ public class MeshAssetMeshInfo
     [Key(25)]
     public Vector4Holder[] colors4 = [];
 
+    [Key(26)]
+    public MeshAssetMeshlet[] meshlets = [];
+
+    //Indices into `vertices`
+    [Key(27)]
+    public uint[] meshletVertices = [];
+
+    //Indices into the vertices of each meshlet, 3 per triangle
+    [Key(28)]
+    public byte[] meshletTriangles = [];
+
+    //Set by importers that already ordered the triangles and vertices for rendering
+    [IgnoreMember]
+    public bool optimized;
+
     [IgnoreMember]
     public MeshAssetComponent Components
     {
@@ -524,6 +601,32 @@ public class MeshAssetNode
     public List<int> meshIndices = [];
 }
 
+[MessagePackObject]
+public class MeshAssetLODLevel
+{
+    [Key(0)]
+    public float distance;
+
+    [Key(1)]
+    public int nodeIndex = -1;
+
+    [Key(2)]
+    public List<int> meshIndices = [];
+}
+
+[MessagePackObject]
+public class MeshAssetLODGroup
+{
+    [Key(0)]
+    public int nodeIndex;
+
+    [Key(1)]
+    public bool relativeDistances;
+
+    [Key(2)]
+    public MeshAssetLODLevel[] levels = [];
+}
+
 [MessagePackObject]
 public struct MeshAssetVectorAnimationKey
 {
@@ -603,4 +706,7 @@ public class SerializableMeshAsset
 
     [Key(4)]
     public MeshAdjustmentTransform adjustmentTransform;
+
+    [Key(5)]
+    public MeshAssetLODGroup[] lodGroups = [];
 }
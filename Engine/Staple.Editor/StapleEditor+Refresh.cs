@@ -164,7 +164,7 @@ internal partial class StapleEditor
                         }
 
                         var args = $"-i \"{BasePath}/Assets\" {packageArgs} -o \"{BasePath}/Cache/Staging/{platform}\" " +
-                            $"-platform {platform} -editor {string.Join(" ", rendererParameters)} -report-changed".Replace("\\", "/");
+                            $"-import-cache \"{BasePath}/Cache/ImportCache\" -platform {platform} -editor {string.Join(" ", rendererParameters)} -report-changed".Replace("\\", "/");
 
                         var processInfo = new ProcessStartInfo(bakerPath, args)
                         {
@@ -414,7 +414,7 @@ internal partial class StapleEditor
                                 packageArgs += $"-i \"{directory}\" ";
                             }
 
-                            var args = $"-i \"{BasePath}/Assets\" {packageArgs} -o \"{BasePath}/Cache/Staging/{platform}\" -platform {platform} -editor {string.Join(" ", rendererParameters)}".Replace("\\", "/");
+                            var args = $"-i \"{BasePath}/Assets\" {packageArgs} -o \"{BasePath}/Cache/Staging/{platform}\" -import-cache \"{BasePath}/Cache/ImportCache\" -platform {platform} -editor {string.Join(" ", rendererParameters)}".Replace("\\", "/");
 
                             var processInfo = new ProcessStartInfo(bakerPath, args)
                             {
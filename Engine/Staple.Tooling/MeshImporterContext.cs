@@ -9,6 +9,7 @@ public class MeshImporterContext
 {
     public delegate bool ShaderHasParameterCallback(string name);
     public delegate string ResolveTexturePathCallback(string path, string meshFileName);
+    public delegate void ReportProgressCallback(string stage, float progress);
 
     public MeshAssetMetadata metadata;
     public string meshFileName;
@@ -19,6 +20,21 @@ public class MeshImporterContext
     public Dictionary<string, string> processedTextures;
     public ResolveTexturePathCallback resolveTexturePath;
 
+    /// <summary>
+    /// Optional, receives the current import stage and its progress from 0 to 1. May be called from any thread.
+    /// </summary>
+    public ReportProgressCallback reportProgress;
+
+    /// <summary>
+    /// Optional, directory importers can keep data in to speed up later imports of the same asset
+    /// </summary>
+    public string cachePath;
+
+    /// <summary>
+    /// Cancels the import. Importers that support it stop early and return null.
+    /// </summary>
+    public CancellationToken cancellationToken;
+
     /// <summary>
     /// Fills missing material parameters for a shader
     /// </summary>
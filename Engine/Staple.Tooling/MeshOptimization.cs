@@ -441,14 +441,17 @@ public static class MeshOptimization
                 metadata = meshAsset.metadata,
                 nodes = meshAsset.nodes,
                 adjustmentTransform = meshAsset.adjustmentTransform,
+                lodGroups = meshAsset.lodGroups,
             };
 
             var meshes = new List<MeshAssetMeshInfo>();
 
             foreach (var mesh in meshAsset.meshes)
             {
+                //Meshes optimized by their importer only need to go through here to be simplified
                 if(mesh.topology != MeshTopology.Triangles ||
-                    mesh.vertices.Length == 0)
+                    mesh.vertices.Length == 0 ||
+                    (mesh.optimized && meshAsset.metadata.simplify == MeshSimplifyTarget.None))
                 {
                     meshes.Add(mesh);
 
@@ -174,7 +174,7 @@ public partial class UIPanel
             return;
         }
 
-        material ??= new(SpriteUtils.DefaultMaterial.Value);
+        textMaterial ??= new(TextRenderer.DefaultMaterial.Value);
 
         parameters.Position(parameters.position + new Vector2(0, parameters.fontSize));
 
@@ -184,19 +184,15 @@ public partial class UIPanel
             return;
         }
 
-        var texture = TextRenderer.instance.FontTexture(parameters);
-
-        if (texture == null)
+        if (!TextRenderer.instance.SetupMaterial(textMaterial, parameters))
         {
             return;
         }
 
-        material.MainTexture = texture;
-
         var vertexSpan = new Span<TextRenderer.PosTexVertex>(textVertices, 0, vertexCount);
         var indexSpan = new Span<ushort>(textIndices, 0, indexCount);
 
-        Graphics.RenderSimple(vertexSpan, TextRenderer.VertexLayout.Value, indexSpan, material, Vector3.Zero,
+        Graphics.RenderSimple(vertexSpan, TextRenderer.VertexLayout.Value, indexSpan, textMaterial, Vector3.Zero,
             Matrix4x4.Identity, MeshTopology.Triangles, MaterialLighting.Unlit);
     }
 }
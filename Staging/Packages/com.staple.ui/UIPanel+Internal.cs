@@ -39,6 +39,11 @@ public partial class UIPanel
     /// </summary>
     private static Material material;
 
+    /// <summary>
+    /// Global material used for rendering text
+    /// </summary>
+    private static Material textMaterial;
+
     /// <summary>
     /// Cached normal sprite vertices
     /// </summary>
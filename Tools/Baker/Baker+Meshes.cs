@@ -165,12 +165,17 @@ static partial class Program
             return standardShader?.metadata.uniforms.Any(x => x.name == name) ?? false;
         }
 
+        var ufxImporter = new UFXImporter();
+
         List<IMeshImporter> importers =
             [
-                new UFXImporter(),
+                ufxImporter,
                 new SharpGLTFImporter(),
             ];
 
+        var batchedContexts = new List<MeshImporterContext>();
+        var batchedTasks = new List<(string, Action)>();
+
         for (var i = 0; i < meshFiles.Count; i++)
         {
             var meshFileName = meshFiles[i];
@@ -221,53 +226,57 @@ static partial class Program
                 continue;
             }
 
-            WorkScheduler.Main.Dispatch(Path.GetFileName(meshFileName.Replace(".meta", "")), () =>
+            //Console.WriteLine($"\t\t -> {outputFile}");
+
+            string text;
+            MeshAssetMetadata metadata;
+
+            try
             {
-                #endregion
-                //Console.WriteLine($"\t\t -> {outputFile}");
+                text = File.ReadAllText(meshFileName);
+            }
+            catch (Exception)
+            {
+                Console.WriteLine($"\t\tError: Failed to read file {meshFileName}");
 
-                string text;
-                MeshAssetMetadata metadata;
+                continue;
+            }
 
-                try
-                {
-                    text = File.ReadAllText(meshFileName);
-                }
-                catch (Exception)
-                {
-                    Console.WriteLine($"\t\tError: Failed to read file {meshFileName}");
+            try
+            {
+                metadata = JsonConvert.DeserializeObject<MeshAssetMetadata>(text);
 
-                    return;
-                }
+                metadata.guid = guid;
+            }
+            catch (Exception e)
+            {
+                Console.WriteLine($"\t\tError: Metadata is corrupted for {meshFileName}: {e}");
 
-                try
-                {
-                    metadata = JsonConvert.DeserializeObject<MeshAssetMetadata>(text);
+                continue;
+            }
 
-                    metadata.guid = guid;
-                }
-                catch (Exception e)
-                {
-                    Console.WriteLine($"\t\tError: Metadata is corrupted for {meshFileName}: {e}");
+            var context = new MeshImporterContext()
+            {
+                inputPath = inputPath,
+                materialLock = meshMaterialLock,
+                meshFileName = meshFileName.Replace(".meta", ""),
+                metadata = metadata,
+                processedTextures = processedTextures,
+                shaderHasParameter = ShaderHasParameter,
+                standardShader = standardShader,
+                resolveTexturePath = ResolveMeshTexturePath,
+                cachePath = importCachePath,
+            };
 
-                    return;
-                }
+            var extension = Path.GetExtension(meshFileName.Replace(".meta", "")).ToLowerInvariant();
 
-                var context = new MeshImporterContext()
-                {
-                    inputPath = inputPath,
-                    materialLock = meshMaterialLock,
-                    meshFileName = meshFileName.Replace(".meta", ""),
-                    metadata = metadata,
-                    processedTextures = processedTextures,
-                    shaderHasParameter = ShaderHasParameter,
-                    standardShader = standardShader,
-                    resolveTexturePath = ResolveMeshTexturePath,
-                };
+            var taskName = Path.GetFileName(meshFileName.Replace(".meta", ""));
 
-                SerializableMeshAsset meshData = null;
+            #endregion
 
-                var extension = Path.GetExtension(meshFileName.Replace(".meta", "")).ToLowerInvariant();
+            void Process()
+            {
+                SerializableMeshAsset meshData = null;
 
                 foreach(var importer in importers)
                 {
@@ -534,7 +543,38 @@ static partial class Program
                 {
                     Console.WriteLine($"\t\tError: Failed to save mesh asset: {e}");
                 }
-            });
+            }
+
+            if (ufxImporter.HandlesExtension(extension))
+            {
+                batchedContexts.Add(context);
+                batchedTasks.Add((taskName, Process));
+            }
+            else
+            {
+                WorkScheduler.Main.Dispatch(taskName, Process);
+            }
         }
+
+        //Scenes handled by ufbx are parsed together on the native thread pool instead of one task each,
+        //and every mesh is processed as soon as its scene is ready.
+        //Scenes that weren't imported are freed once their task is done, since loading waits on them.
+        ufxImporter.LoadScenes(batchedContexts, index =>
+        {
+            var (taskName, task) = batchedTasks[index];
+            var context = batchedContexts[index];
+
+            WorkScheduler.Main.Dispatch(taskName, () =>
+            {
+                try
+                {
+                    task();
+                }
+                finally
+                {
+                    ufxImporter.FreePreloadedScene(context);
+                }
+            });
+        });
     }
 }
@@ -145,6 +145,8 @@ static partial class Program
 
     internal static bool reportingChangedAssets = false;
 
+    internal static string importCachePath;
+
     internal static string StapleBasePath
     {
         get
@@ -178,6 +180,7 @@ static partial class Program
                 "\t-editor: enable editor mode, which uses different directories\n" +
                 "\t-no-self-check: don't check this tool's last build time when checking whether to reimport a file\n" +
                 "\t-report-changed: outputs a list of changed assets, then quits\n" +
+                "\t-benchmark-mesh-import [triangle count]: measures native mesh extraction speed on a synthetic mesh (default 1000000 triangles)\n" +
                 $"\t-platform [platform]: specify the platform to build for ({string.Join(", ", Enum.GetValues<AppPlatform>().Select(x => x.ToString()))}\n" +
                 "\t-r [name]: set the renderer to compile for (can be repeated for multiple exports)\n" +
                 "\t-list-shader-variants [variants separated by \",\"] [variant dependencies in the format of \"A:B\" separated by \",\"]: " +
@@ -229,6 +232,49 @@ static partial class Program
             return;
         }
 
+        if(args.Length >= 1 && args[0] == "-benchmark-mesh-import")
+        {
+            var triangleCount = 1000000;
+
+            if(args.Length > 1 && (int.TryParse(args[1], out triangleCount) == false || triangleCount < 2))
+            {
+                Console.WriteLine($"Invalid triangle count {args[1]}");
+
+                Environment.Exit(1);
+
+                return;
+            }
+
+            unsafe
+            {
+                void Run(string name, int threadCount)
+                {
+                    var options = new UFBX.UFBXSceneLoadOptions()
+                    {
+                        threadCount = threadCount,
+                    };
+
+                    var result = UFBX.UFBX.BenchmarkMeshExtraction(triangleCount, 5, &options);
+
+                    if(result < 0)
+                    {
+                        Console.WriteLine($"{name}: failed");
+
+                        return;
+                    }
+
+                    Console.WriteLine($"{name}: {result / 1000000.0:0.00}M triangles/s");
+                }
+
+                Console.WriteLine($"Extracting {triangleCount} triangles");
+
+                Run("Single thread", 1);
+                Run("All threads", 0);
+            }
+
+            return;
+        }
+
         MessagePackInit.Initialize();
 
         string ValidateTool(string name, string executable)
@@ -426,6 +472,23 @@ static partial class Program
 
                     break;
 
+                case "-import-cache":
+
+                    if (i + 1 >= args.Length)
+                    {
+                        Console.WriteLine("Invalid argument `-import-cache`: missing path");
+
+                        Environment.Exit(1);
+
+                        return;
+                    }
+
+                    importCachePath = args[i + 1];
+
+                    i++;
+
+                    break;
+
                 default:
 
                     Console.WriteLine($"Unknown argument `{args[i]}`");
@@ -1,19 +1,205 @@
 ﻿using Newtonsoft.Json;
 using Staple.Internal;
+using Standart.Hash.xxHash;
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
 using System.Numerics;
 using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
 using UFBX;
 
 namespace Staple.Tooling;
 
 public class UFXImporter : IMeshImporter
 {
+    /// <summary>
+    /// Size of the buffer source files are hashed with
+    /// </summary>
+    private const int HashBufferSize = 1024 * 1024;
+
+    /// <summary>
+    /// Most scenes <see cref="LoadScenes"/> keeps loaded at once. Loading more waits for one of them to be imported,
+    /// so a batch can't get ahead of its imports and hold every scene in memory.
+    /// </summary>
+    private static readonly int MaxPreloadedScenes = System.Math.Max(2, Environment.ProcessorCount);
+
+    /// <summary>
+    /// Scenes loaded by <see cref="LoadScenes"/> that haven't been imported yet
+    /// </summary>
+    private readonly ConcurrentDictionary<MeshImporterContext, nint> preloadedScenes = new();
+
+    /// <summary>
+    /// One slot per scene in <see cref="preloadedScenes"/>, released once the scene is imported or freed
+    /// </summary>
+    private readonly SemaphoreSlim preloadedSceneSlots = new(MaxPreloadedScenes);
+
+    /// <summary>
+    /// Frees a scene when disposed, and releases its slot if it was preloaded
+    /// </summary>
+    private readonly unsafe struct OwnedScene : IDisposable
+    {
+        private readonly UFBXScene* scene;
+        private readonly SemaphoreSlim slots;
+
+        public OwnedScene(UFBXScene* scene, SemaphoreSlim slots)
+        {
+            this.scene = scene;
+            this.slots = slots;
+        }
+
+        public void Dispose()
+        {
+            UFBX.UFBX.FreeScene(scene);
+
+            slots?.Release();
+        }
+    }
+
     public bool HandlesExtension(string extension) => extension == ".fbx" || extension == ".obj";
 
+    /// <summary>
+    /// Loads the scenes of several meshes together on the native thread pool, so small files don't each need a thread of their own.
+    /// Blocks until every scene is loaded, calling <paramref name="onLoaded"/> with the index of each context as soon as its scene is ready,
+    /// possibly from other threads. <see cref="ImportMesh"/> then uses the loaded scene of the context.
+    /// Contexts that report progress or can be cancelled aren't loaded here, and are passed to <paramref name="onLoaded"/> right away.
+    /// Every context passed to <paramref name="onLoaded"/> must be imported, or its scene freed with <see cref="FreePreloadedScene"/>,
+    /// since loading waits once <see cref="MaxPreloadedScenes"/> scenes are waiting to be imported.
+    /// </summary>
+    /// <param name="contexts">The contexts of the meshes</param>
+    /// <param name="onLoaded">Called with the index of each context once it's ready to be imported</param>
+    public void LoadScenes(IReadOnlyList<MeshImporterContext> contexts, Action<int> onLoaded)
+    {
+        if (UFBX.UFBX.NativeABIVersion() != UFBX.UFBX.ABIVersion)
+        {
+            //ImportMesh reports the mismatch
+            for (var i = 0; i < contexts.Count; i++)
+            {
+                onLoaded(i);
+            }
+
+            return;
+        }
+
+        var ready = new bool[contexts.Count];
+        var loadOptions = new UFBXSceneLoadOptions[contexts.Count];
+        var cacheFileNames = new string[contexts.Count];
+        var cacheKeys = new ulong[contexts.Count];
+
+        //Cached scenes are passed on as soon as they're loaded, since the imports that free their slots need to start while this runs.
+        //Half the threads are left for those imports.
+        var cacheOptions = new ParallelOptions()
+        {
+            MaxDegreeOfParallelism = System.Math.Max(1, Environment.ProcessorCount / 2),
+        };
+
+        unsafe
+        {
+            Parallel.For(0, contexts.Count, cacheOptions, i =>
+            {
+                var context = contexts[i];
+
+                if (context.reportProgress != null || context.cancellationToken.CanBeCanceled)
+                {
+                    ready[i] = true;
+
+                    onLoaded(i);
+
+                    return;
+                }
+
+                var options = CreateLoadOptions(context.metadata, context.meshFileName.ToLowerInvariant().EndsWith(".obj"));
+
+                loadOptions[i] = options;
+
+                var scene = LoadCachedScene(context, &options, out cacheFileNames[i], out cacheKeys[i]);
+
+                if (scene != null)
+                {
+                    AddPreloadedScene(context, scene);
+
+                    ready[i] = true;
+
+                    onLoaded(i);
+                }
+            });
+        }
+
+        var pending = new List<int>();
+
+        for (var i = 0; i < contexts.Count; i++)
+        {
+            if (ready[i] == false)
+            {
+                pending.Add(i);
+            }
+        }
+
+        unsafe
+        {
+            UFBXManagedBatch.Load(pending.Select(x => contexts[x].meshFileName).ToList(), pending.Select(x => loadOptions[x]).ToArray(),
+                (index, scene) =>
+                {
+                    var i = pending[index];
+
+                    try
+                    {
+                        if (scene != null && cacheFileNames[i] != null)
+                        {
+                            SaveCachedScene(scene, contexts[i].cachePath, cacheFileNames[i], cacheKeys[i]);
+                        }
+                    }
+                    finally
+                    {
+                        //Failed scenes are loaded again by ImportMesh, which reports the error
+                        if (scene != null)
+                        {
+                            AddPreloadedScene(contexts[i], scene);
+                        }
+
+                        onLoaded(i);
+                    }
+                });
+        }
+    }
+
+    /// <summary>
+    /// Frees the scene loaded by <see cref="LoadScenes"/> for a context if it wasn't imported
+    /// </summary>
+    /// <param name="context">The context</param>
+    public void FreePreloadedScene(MeshImporterContext context)
+    {
+        if (preloadedScenes.TryRemove(context, out var scene))
+        {
+            unsafe
+            {
+                UFBX.UFBX.FreeScene((UFBXScene*)scene);
+            }
+
+            preloadedSceneSlots.Release();
+        }
+    }
+
+    /// <summary>
+    /// Keeps a loaded scene until its context is imported, first waiting for a slot if too many scenes are waiting already
+    /// </summary>
+    /// <param name="context">The context of the scene</param>
+    /// <param name="scene">The scene</param>
+    private unsafe void AddPreloadedScene(MeshImporterContext context, UFBXScene* scene)
+    {
+        preloadedSceneSlots.Wait();
+
+        if (preloadedScenes.TryAdd(context, (nint)scene) == false)
+        {
+            UFBX.UFBX.FreeScene(scene);
+
+            preloadedSceneSlots.Release();
+        }
+    }
+
     public SerializableMeshAsset ImportMesh(MeshImporterContext context)
     {
         var (metadata, meshFileName, inputPath, standardShader, ShaderHasParameter, meshMaterialLock, processedTextures,
@@ -22,22 +208,81 @@ public class UFXImporter : IMeshImporter
 
         unsafe
         {
-            var scene = UFBX.UFBX.LoadScene(meshFileName);
+            if (UFBX.UFBX.NativeABIVersion() != UFBX.UFBX.ABIVersion)
+            {
+                Console.WriteLine($"\t\tError: Failed to import file {meshFileName}: StapleToolingSupport ABI version mismatch " +
+                    $"(expected {UFBX.UFBX.ABIVersion}, got {UFBX.UFBX.NativeABIVersion()})");
+
+                return null;
+            }
+
+            var isOBJ = meshFileName.ToLowerInvariant().EndsWith(".obj");
+
+            var loadOptions = CreateLoadOptions(metadata, isOBJ);
+
+            string cacheFileName = null;
+            ulong cacheKey = 0;
+
+            var preloaded = preloadedScenes.TryRemove(context, out var preloadedScene);
+
+            var scene = preloaded ? (UFBXScene*)preloadedScene : LoadCachedScene(context, &loadOptions, out cacheFileName, out cacheKey);
+
+            var cancellationToken = context.cancellationToken;
+
+            var parsed = false;
 
             if (scene == null)
             {
-                Console.WriteLine($"\t\tError: Failed to import file {meshFileName}");
+                var reportProgress = context.reportProgress;
+
+                if (reportProgress != null || cancellationToken.CanBeCanceled)
+                {
+                    UFBXManagedProgress.Set(ref loadOptions, (in UFBXImportProgress progress) =>
+                    {
+                        reportProgress?.Invoke(progress.stage.ToString(), progress.StageProgress(progress.stage));
+
+                        return cancellationToken.IsCancellationRequested == false;
+                    });
+                }
+
+                try
+                {
+                    scene = UFBX.UFBX.LoadSceneWithOptions(meshFileName, &loadOptions);
+                }
+                finally
+                {
+                    UFBXManagedProgress.Free(ref loadOptions);
+                }
+
+                parsed = scene != null;
+            }
+
+            if (scene == null)
+            {
+                if (cancellationToken.IsCancellationRequested)
+                {
+                    Console.WriteLine($"\t\tImport of {meshFileName} was cancelled");
+                }
+                else
+                {
+                    Console.WriteLine($"\t\tError: Failed to import file {meshFileName}");
+                }
 
                 return null;
             }
 
+            using var ownedScene = new OwnedScene(scene, preloaded ? preloadedSceneSlots : null);
+
+            if (parsed && cacheFileName != null)
+            {
+                SaveCachedScene(scene, context.cachePath, cacheFileName, cacheKey);
+            }
+
             if (metadata.frameRate <= 0)
             {
                 metadata.frameRate = 30;
             }
 
-            var isOBJ = meshFileName.ToLowerInvariant().EndsWith(".obj");
-
             var meshRotation = metadata.rotation switch
             {
                 MeshAssetRotation.NinetyPositive => Quaternion.CreateFromAxisAngle(new(1, 0, 0), 90 * Staple.Math.Deg2Rad),
@@ -67,9 +312,76 @@ public class UFXImporter : IMeshImporter
 
                 var materials = scene->Materials;
 
+                //Embedded textures are written next to the mesh once, named after their contents so every material using them shares one asset
+                string ExtractEmbeddedTexture(UFBXTexture texture)
+                {
+                    var key = texture.contentHash.ToString("x16");
+
+                    if (materialEmbeddedTextures.TryGetValue(key, out var guid))
+                    {
+                        return guid;
+                    }
+
+                    var extension = Path.GetExtension(scene->GetString(texture.fileName)).ToLowerInvariant();
+
+                    if (extension.Length == 0)
+                    {
+                        extension = ".png";
+                    }
+
+                    var texturePath = Path.Combine(Path.GetDirectoryName(meshFileName), $"{key}{extension}");
+
+                    guid = "";
+
+                    //Other imports can extract the same texture at the same time, so files are only created if they're missing
+                    try
+                    {
+                        using var stream = new FileStream(texturePath, FileMode.CreateNew, FileAccess.Write, FileShare.None);
+
+                        stream.Write(texture.Content);
+                    }
+                    catch (Exception)
+                    {
+                    }
+
+                    try
+                    {
+                        var metaPath = $"{texturePath}.meta";
+
+                        var newGuid = GuidGenerator.Generate().ToString();
+
+                        var json = JsonConvert.SerializeObject(new TextureMetadata()
+                        {
+                            guid = newGuid,
+                        }, Formatting.Indented, Staple.Tooling.Utilities.JsonSettings);
+
+                        try
+                        {
+                            using (var stream = new FileStream(metaPath, FileMode.CreateNew, FileAccess.Write, FileShare.None))
+                            using (var writer = new StreamWriter(stream))
+                            {
+                                writer.Write(json);
+                            }
+
+                            guid = newGuid;
+                        }
+                        catch (IOException)
+                        {
+                            guid = ReadTextureGuid(metaPath);
+                        }
+                    }
+                    catch (Exception)
+                    {
+                    }
+
+                    materialEmbeddedTextures.Add(key, guid);
+
+                    return guid;
+                }
+
                 foreach (var material in materials)
                 {
-                    var baseName = material.name.length > 0 ? material.name.ToString() : (++counter).ToString();
+                    var baseName = material.name.length > 0 ? scene->GetString(material.name) : (++counter).ToString();
 
                     baseName = string.Join('_', baseName.Split(Path.GetInvalidFileNameChars()));
 
@@ -206,7 +518,7 @@ public class UFXImporter : IMeshImporter
 
                     var hadCount = 0;
 
-                    void AddTexture(string name, bool has, UFBXString fileName, TextureWrap wrapU, TextureWrap wrapV)
+                    void AddTexture(string name, UFBXString fileName, int textureIndex, TextureWrap wrapU, TextureWrap wrapV)
                     {
                         if (ShaderHasParameter(name) == false)
                         {
@@ -218,9 +530,15 @@ public class UFXImporter : IMeshImporter
                         var mappingU = TextureWrap.Clamp;
                         var mappingV = TextureWrap.Clamp;
 
-                        if (has)
+                        if (textureIndex >= 0 && scene->textures[textureIndex].IsEmbedded)
+                        {
+                            texturePath = ExtractEmbeddedTexture(scene->textures[textureIndex]);
+
+                            hadCount++;
+                        }
+                        else if (fileName.length > 0)
                         {
-                            texturePath = resolveTexturePath(fileName.ToString(), meshFileName);
+                            texturePath = resolveTexturePath(scene->GetString(fileName), meshFileName);
 
                             hadCount++;
                         }
@@ -256,22 +574,22 @@ public class UFXImporter : IMeshImporter
                         });
                     }
 
-                    AddTexture("ambientTexture", material.ambientTexture.length > 0, material.ambientTexture,
+                    AddTexture("ambientTexture", material.ambientTexture, material.ambientTextureIndex,
                         (TextureWrap)material.ambientWrapU, (TextureWrap)material.ambientWrapV);
 
-                    AddTexture("diffuseTexture", material.diffuseTexture.length > 0, material.diffuseTexture,
+                    AddTexture("diffuseTexture", material.diffuseTexture, material.diffuseTextureIndex,
                         (TextureWrap)material.diffuseWrapU, (TextureWrap)material.diffuseWrapV);
 
-                    AddTexture("emissiveTexture", material.emissionTexture.length > 0, material.emissionTexture,
+                    AddTexture("emissiveTexture", material.emissionTexture, material.emissionTextureIndex,
                         (TextureWrap)material.emissionWrapU, (TextureWrap)material.emissionWrapV);
 
-                    AddTexture("reflectiveTexture", material.reflectionTexture.length > 0, material.reflectionTexture,
+                    AddTexture("reflectiveTexture", material.reflectionTexture, material.reflectionTextureIndex,
                         (TextureWrap)material.reflectionWrapU, (TextureWrap)material.reflectionWrapV);
 
-                    AddTexture("specularTexture", material.specularTexture.length > 0, material.specularTexture,
+                    AddTexture("specularTexture", material.specularTexture, material.specularTextureIndex,
                         (TextureWrap)material.specularWrapU, (TextureWrap)material.specularWrapV);
 
-                    AddTexture("transparentTexture", material.transparencyTexture.length > 0, material.transparencyTexture,
+                    AddTexture("transparentTexture", material.transparencyTexture, material.transparencyTextureIndex,
                         (TextureWrap)material.transparencyWrapU, (TextureWrap)material.transparencyWrapV);
 
                     MeshImporterContext.FillMaterialParameters(materialMetadata, standardShader);
@@ -346,7 +664,7 @@ public class UFXImporter : IMeshImporter
 
             foreach (var node in scene->Nodes)
             {
-                var nodeName = node.name.ToString();
+                var nodeName = scene->GetString(node.name);
 
                 if (nodeCounters.TryGetValue(nodeName, out var counter) == false)
                 {
@@ -383,20 +701,51 @@ public class UFXImporter : IMeshImporter
 
             meshData.nodes = [.. nodes];
 
+            //Node and mesh indices are kept as they are, so levels can point straight at the imported nodes and meshes
+            var lodGroups = new List<MeshAssetLODGroup>();
+
+            foreach (var group in scene->LODGroups)
+            {
+                var levels = new MeshAssetLODLevel[group.levelCount];
+
+                for (var j = 0; j < levels.Length; j++)
+                {
+                    var level = group.levels[j];
+
+                    levels[j] = new()
+                    {
+                        distance = level.distance,
+                        nodeIndex = level.nodeIndex,
+                        meshIndices = [.. level.MeshIndices],
+                    };
+                }
+
+                lodGroups.Add(new()
+                {
+                    nodeIndex = group.nodeIndex,
+                    relativeDistances = group.relativeDistances,
+                    levels = levels,
+                });
+            }
+
+            meshData.lodGroups = [.. lodGroups];
+
             #region Meshes
             foreach (var mesh in scene->Meshes)
             {
                 var m = new MeshAssetMeshInfo
                 {
-                    name = mesh.name.ToString(),
+                    name = scene->GetString(mesh.name),
                     materialGuid = mesh.materialIndex >= 0 && mesh.materialIndex < materialMapping.Count ? materialMapping[mesh.materialIndex] :
                         AssetDatabase.GetAssetGuid(AssetSerialization.StandardMaterialPath),
                     type = mesh.isSkinned ? MeshAssetType.Skinned : MeshAssetType.Normal,
                     topology = MeshTopology.Triangles,
                 };
 
+                var vertices = mesh.ReadAttribute<Vector3Holder>(UFBXVertexAttributes.Position);
+
                 {
-                    var aabb = AABB.CreateFromPoints(mesh.Vertices);
+                    var aabb = AABB.CreateFromPoints(MemoryMarshal.Cast<Vector3Holder, Vector3>(vertices));
 
                     m.boundsCenter = new Vector3Holder(aabb.center);
                     m.boundsExtents = new Vector3Holder(aabb.size);
@@ -404,116 +753,114 @@ public class UFXImporter : IMeshImporter
 
                 var vertexCount = mesh.vertexCount;
 
-                var vertices = new List<Vector3Holder>();
-                var tangents = new List<Vector3Holder>();
-                var bitangents = new List<Vector3Holder>();
-                var indices = new List<int>();
-                var normals = metadata.normalsMode != MeshNormalsMode.None ? new Vector3[vertexCount] : null;
-
                 for (var j = 0; j < vertexCount; j++)
                 {
-                    vertices.Add(ApplyTransform(new Vector3Holder(mesh.Vertices[j])));
+                    vertices[j] = ApplyTransform(vertices[j]);
+                }
 
-                    if (mesh.Tangents.Length > 0 && normals != null && metadata.tangentsMode == MeshTangentsMode.Import)
-                    {
-                        tangents.Add(ApplyNormalTransform(new Vector3Holder(mesh.Tangents[j])));
-                    }
+                m.vertices = vertices;
+
+                Vector3[] normals = null;
+
+                if (metadata.normalsMode != MeshNormalsMode.None)
+                {
+                    normals = mesh.ReadAttribute<Vector3>(UFBXVertexAttributes.Normal);
 
-                    if (mesh.Bitangents.Length > 0 && normals != null && metadata.tangentsMode == MeshTangentsMode.Import)
+                    if (normals.Length == 0)
                     {
-                        bitangents.Add(ApplyNormalTransform(new Vector3Holder(mesh.Bitangents[j])));
+                        normals = new Vector3[vertexCount];
                     }
 
-                    if (mesh.Normals.Length > 0 && normals != null)
+                    var tangents = mesh.ReadAttribute<Vector3Holder>(UFBXVertexAttributes.Tangent);
+                    var bitangents = mesh.ReadAttribute<Vector3Holder>(UFBXVertexAttributes.Bitangent);
+
+                    for (var j = 0; j < tangents.Length; j++)
                     {
-                        normals[j] = mesh.Normals[j];
+                        tangents[j] = ApplyNormalTransform(tangents[j]);
                     }
-                }
 
-                indices.AddRange([.. mesh.Indices.ToArray().Select(x => (int)x)]);
-
-                if(metadata.importVertexColors)
-                {
-                    m.colors = mesh.Color0.Length > 0 ? [.. mesh.Color0.ToArray().Select(x => new Vector4Holder(x))] : [];
-                    m.colors2 = mesh.Color1.Length > 0 ? [.. mesh.Color1.ToArray().Select(x => new Vector4Holder(x))] : [];
-                    m.colors3 = mesh.Color2.Length > 0 ? [.. mesh.Color2.ToArray().Select(x => new Vector4Holder(x))] : [];
-                    m.colors4 = mesh.Color3.Length > 0 ? [.. mesh.Color3.ToArray().Select(x => new Vector4Holder(x))] : [];
-                }
+                    for (var j = 0; j < bitangents.Length; j++)
+                    {
+                        bitangents[j] = ApplyNormalTransform(bitangents[j]);
 
-                m.vertices = [.. vertices];
+                        //Flipping V below mirrors the direction generated bitangents follow
+                        if (metadata.flipUVs && mesh.generatedTangents)
+                        {
+                            bitangents[j] = new(-bitangents[j].x, -bitangents[j].y, -bitangents[j].z);
+                        }
+                    }
 
-                if(tangents.Count > 0)
-                {
-                    m.tangents = [.. tangents];
-                }
+                    if (tangents.Length > 0)
+                    {
+                        m.tangents = tangents;
+                    }
 
-                if(bitangents.Count > 0)
-                {
-                    m.bitangents = [.. bitangents];
+                    if (bitangents.Length > 0)
+                    {
+                        m.bitangents = bitangents;
+                    }
                 }
 
-                var shouldFlip = isOBJ ? !metadata.flipWindingOrder : metadata.flipWindingOrder;
-
-                if (shouldFlip && indices.Count % 3 == 0)
+                if(metadata.importVertexColors)
                 {
-                    for (var k = 0; k < indices.Count; k += 3)
-                    {
-                        (indices[k + 1], indices[k + 2]) = (indices[k + 2], indices[k + 1]);
-                    }
+                    m.colors = mesh.ReadAttribute<Vector4Holder>(UFBXVertexAttributes.Color0);
+                    m.colors2 = mesh.ReadAttribute<Vector4Holder>(UFBXVertexAttributes.Color1);
+                    m.colors3 = mesh.ReadAttribute<Vector4Holder>(UFBXVertexAttributes.Color2);
+                    m.colors4 = mesh.ReadAttribute<Vector4Holder>(UFBXVertexAttributes.Color3);
                 }
 
-                m.indices = [.. indices];
+                //Winding order and vertex/triangle order were already handled during import
+                m.indices = MemoryMarshal.Cast<uint, int>(mesh.Indices).ToArray();
+                m.optimized = true;
 
                 switch(metadata.normalsMode)
                 {
                     case MeshNormalsMode.Generate:
 
-                        {
-                            var v = m.vertices
-                                .Select(x => x.ToVector3())
-                                .ToArray();
-
-                            normals = Mesh.GenerateNormals(v, m.indices.AsSpan(), false);
-                        }
+                        normals = Mesh.GenerateNormals(MemoryMarshal.Cast<Vector3Holder, Vector3>(m.vertices), m.indices.AsSpan(), false);
 
                         break;
 
                     case MeshNormalsMode.GenerateSmooth:
 
-                        {
-                            var v = m.vertices
-                                .Select(x => x.ToVector3())
-                                .ToArray();
-
-                            normals = Mesh.GenerateNormals(v, m.indices.AsSpan(), true);
-                        }
+                        normals = Mesh.GenerateNormals(MemoryMarshal.Cast<Vector3Holder, Vector3>(m.vertices), m.indices.AsSpan(), true);
 
                         break;
                 }
 
                 if(normals != null)
                 {
-                    m.normals = [.. normals.Select(x => ApplyNormalTransform(new Vector3Holder(x)))];
+                    m.normals = new Vector3Holder[normals.Length];
+
+                    for (var j = 0; j < normals.Length; j++)
+                    {
+                        m.normals[j] = ApplyNormalTransform(new Vector3Holder(normals[j]));
+                    }
                 }
 
-                Vector2 FlipUV(Vector2 uv)
+                Vector2Holder[] ReadUV(UFBXVertexAttributes attribute)
                 {
+                    var uvs = mesh.ReadAttribute<Vector2Holder>(attribute);
+
                     if (metadata.flipUVs)
                     {
-                        return new(uv.X, 1 - uv.Y);
+                        for (var j = 0; j < uvs.Length; j++)
+                        {
+                            uvs[j].y = 1 - uvs[j].y;
+                        }
                     }
 
-                    return uv;
+                    return uvs;
                 }
 
-                m.UV1 = mesh.UV0.Length > 0 ? [.. mesh.UV0.ToArray().Select(x => new Vector2Holder(FlipUV(x)))] : [];
-                m.UV2 = mesh.UV1.Length > 0 ? [.. mesh.UV1.ToArray().Select(x => new Vector2Holder(FlipUV(x)))] : [];
-                m.UV3 = mesh.UV2.Length > 0 ? [.. mesh.UV2.ToArray().Select(x => new Vector2Holder(FlipUV(x)))] : [];
-                m.UV4 = mesh.UV3.Length > 0 ? [.. mesh.UV3.ToArray().Select(x => new Vector2Holder(FlipUV(x)))] : [];
-                m.UV5 = mesh.UV4.Length > 0 ? [.. mesh.UV4.ToArray().Select(x => new Vector2Holder(FlipUV(x)))] : [];
-                m.UV6 = mesh.UV5.Length > 0 ? [.. mesh.UV5.ToArray().Select(x => new Vector2Holder(FlipUV(x)))] : [];
-                m.UV7 = mesh.UV6.Length > 0 ? [.. mesh.UV6.ToArray().Select(x => new Vector2Holder(FlipUV(x)))] : [];
-                m.UV8 = mesh.UV7.Length > 0 ? [.. mesh.UV7.ToArray().Select(x => new Vector2Holder(FlipUV(x)))] : [];
+                m.UV1 = ReadUV(UFBXVertexAttributes.TexCoord0);
+                m.UV2 = ReadUV(UFBXVertexAttributes.TexCoord1);
+                m.UV3 = ReadUV(UFBXVertexAttributes.TexCoord2);
+                m.UV4 = ReadUV(UFBXVertexAttributes.TexCoord3);
+                m.UV5 = ReadUV(UFBXVertexAttributes.TexCoord4);
+                m.UV6 = ReadUV(UFBXVertexAttributes.TexCoord5);
+                m.UV7 = ReadUV(UFBXVertexAttributes.TexCoord6);
+                m.UV8 = ReadUV(UFBXVertexAttributes.TexCoord7);
 
                 if (mesh.isSkinned)
                 {
@@ -532,13 +879,36 @@ public class UFXImporter : IMeshImporter
                         };
                     }
 
-                    m.boneIndices = [.. mesh.BoneIndices
-                        .ToArray()
-                        .Select(x => new Vector4Holder(x))];
+                    m.boneIndices = mesh.ReadAttribute<Vector4Holder>(UFBXVertexAttributes.BlendIndices);
+                    m.boneWeights = mesh.ReadAttribute<Vector4Holder>(UFBXVertexAttributes.BlendWeights);
+                }
+
+                if (metadata.generateMeshlets)
+                {
+                    var meshlets = mesh.Meshlets;
+
+                    m.meshlets = new MeshAssetMeshlet[meshlets.Length];
+
+                    for (var j = 0; j < meshlets.Length; j++)
+                    {
+                        var meshlet = meshlets[j];
+
+                        m.meshlets[j] = new()
+                        {
+                            vertexOffset = meshlet.vertexOffset,
+                            triangleOffset = meshlet.triangleOffset,
+                            vertexCount = meshlet.vertexCount,
+                            triangleCount = meshlet.triangleCount,
+                            center = ApplyTransform(new Vector3Holder(meshlet.center)),
+                            radius = meshlet.radius,
+                            coneApex = ApplyTransform(new Vector3Holder(meshlet.coneApex)),
+                            coneAxis = ApplyNormalTransform(new Vector3Holder(meshlet.coneAxis)),
+                            coneCutoff = meshlet.coneCutoff,
+                        };
+                    }
 
-                    m.boneWeights = [.. mesh.BoneWeights
-                        .ToArray()
-                        .Select(x => new Vector4Holder(x))];
+                    m.meshletVertices = mesh.MeshletVertices.ToArray();
+                    m.meshletTriangles = mesh.MeshletTriangles.ToArray();
                 }
 
                 meshes.Add(m);
@@ -558,49 +928,54 @@ public class UFXImporter : IMeshImporter
                 var a = new MeshAssetAnimation
                 {
                     duration = animation.duration,
-                    name = animation.name.ToString(),
+                    name = scene->GetString(animation.name),
                     channels = new MeshAssetAnimationChannel[animation.nodeCount],
                 };
 
+                //Channels already point at scene nodes, which are imported in the same order as meshData.nodes
                 for (var k = 0; k < animation.nodeCount; k++)
                 {
                     var frame = animation.nodes[k];
 
-                    var positionKeys = frame.Positions
-                        .ToArray()
-                        .Select(x => new MeshAssetVectorAnimationKey()
-                        {
-                            time = x.time,
-                            value = new(x.value)
-                        })
-                        .ToArray();
-
-                    var rotationKeys = frame.Rotations
-                        .ToArray()
-                        .Select(x => new MeshAssetQuaternionAnimationKey()
-                        {
-                            time = x.time,
-                            value = new(x.value)
-                        })
-                        .ToArray();
-
-                    var scaleKeys = frame.Scales
-                        .ToArray()
-                        .Select(x => new MeshAssetVectorAnimationKey()
-                        {
-                            time = x.time,
-                            value = new(x.value)
-                        })
-                        .ToArray();
+                    var positions = frame.Positions;
+                    var rotations = frame.Rotations;
+                    var scales = frame.Scales;
 
                     var c = new MeshAssetAnimationChannel()
                     {
-                        nodeIndex = nodes.FindIndex(x => x.name == scene->nodes[frame.nodeIndex].name.ToString()),
-                        positionKeys = positionKeys,
-                        rotationKeys = rotationKeys,
-                        scaleKeys = scaleKeys,
+                        nodeIndex = frame.nodeIndex >= 0 && frame.nodeIndex < nodes.Count ? frame.nodeIndex : -1,
+                        positionKeys = new MeshAssetVectorAnimationKey[positions.Length],
+                        rotationKeys = new MeshAssetQuaternionAnimationKey[rotations.Length],
+                        scaleKeys = new MeshAssetVectorAnimationKey[scales.Length],
                     };
 
+                    for (var l = 0; l < positions.Length; l++)
+                    {
+                        c.positionKeys[l] = new()
+                        {
+                            time = positions[l].time,
+                            value = new(positions[l].value),
+                        };
+                    }
+
+                    for (var l = 0; l < rotations.Length; l++)
+                    {
+                        c.rotationKeys[l] = new()
+                        {
+                            time = rotations[l].time,
+                            value = new(rotations[l].value),
+                        };
+                    }
+
+                    for (var l = 0; l < scales.Length; l++)
+                    {
+                        c.scaleKeys[l] = new()
+                        {
+                            time = scales[l].time,
+                            value = new(scales[l].value),
+                        };
+                    }
+
                     a.channels[k] = c;
                 }
 
@@ -611,9 +986,194 @@ public class UFXImporter : IMeshImporter
 
             #endregion
 
-            UFBX.UFBX.FreeScene(scene);
-
             return meshData;
         }
     }
+
+    /// <summary>
+    /// Gets the options a mesh's scene is loaded with
+    /// </summary>
+    /// <param name="metadata">The mesh metadata</param>
+    /// <param name="isOBJ">Whether the mesh is an OBJ file</param>
+    /// <returns>The options</returns>
+    private static UFBXSceneLoadOptions CreateLoadOptions(MeshAssetMetadata metadata, bool isOBJ)
+    {
+        var attributes = UFBXVertexAttributes.Position | UFBXVertexAttributes.TexCoords |
+            UFBXVertexAttributes.BlendIndices | UFBXVertexAttributes.BlendWeights;
+
+        //Tangents are generated during import when they can come from the imported normals,
+        //otherwise the baker generates them once the normals are known
+        var generateTangents = metadata.normalsMode == MeshNormalsMode.Import && metadata.tangentsMode != MeshTangentsMode.None;
+
+        if (metadata.normalsMode != MeshNormalsMode.None)
+        {
+            attributes |= UFBXVertexAttributes.Normal;
+
+            if (metadata.tangentsMode == MeshTangentsMode.Import || generateTangents)
+            {
+                attributes |= UFBXVertexAttributes.Tangent | UFBXVertexAttributes.Bitangent;
+            }
+        }
+
+        if (metadata.importVertexColors)
+        {
+            attributes |= UFBXVertexAttributes.Colors;
+        }
+
+        return new UFBXSceneLoadOptions()
+        {
+            threadCount = 0,
+            attributes = attributes,
+            interleaved = true,
+            maxBoneInfluences = 4,
+            animationSampleRate = metadata.animationSampleRate,
+            animationKeyReduction = metadata.reduceAnimationKeys,
+            animationKeyReductionThreshold = metadata.animationKeyReductionThreshold,
+            flipWindingOrder = isOBJ ? !metadata.flipWindingOrder : metadata.flipWindingOrder,
+            optimizeMeshes = true,
+            buildMeshlets = metadata.generateMeshlets,
+            tangentGeneration = generateTangents ?
+                (metadata.tangentsMode == MeshTangentsMode.Generate ? UFBXTangentGeneration.Always : UFBXTangentGeneration.Missing) :
+                UFBXTangentGeneration.Import,
+        };
+    }
+
+    /// <summary>
+    /// Loads the cached scene of a mesh. The extracted scene only depends on the source files and the load options,
+    /// so changes to the rest of the metadata reuse it instead of parsing the source again.
+    /// </summary>
+    /// <param name="context">The import context</param>
+    /// <param name="loadOptions">The options the scene is loaded with</param>
+    /// <param name="cacheFileName">The path of the cache file, or null if there's no cache</param>
+    /// <param name="cacheKey">The key of the cache</param>
+    /// <returns>The scene, or null if there's no valid cache</returns>
+    private static unsafe UFBXScene* LoadCachedScene(MeshImporterContext context, UFBXSceneLoadOptions* loadOptions,
+        out string cacheFileName, out ulong cacheKey)
+    {
+        cacheFileName = null;
+        cacheKey = 0;
+
+        if (string.IsNullOrEmpty(context.cachePath))
+        {
+            return null;
+        }
+
+        ulong sourceHash;
+
+        try
+        {
+            sourceHash = HashSource(context.meshFileName);
+        }
+        catch (Exception)
+        {
+            return null;
+        }
+
+        cacheKey = UFBX.UFBX.SceneCacheKey(sourceHash, loadOptions);
+        cacheFileName = Path.Combine(context.cachePath, $"{context.metadata.guid}.scenecache");
+
+        return UFBX.UFBX.LoadSceneCache(cacheFileName, cacheKey);
+    }
+
+    private static unsafe void SaveCachedScene(UFBXScene* scene, string cachePath, string cacheFileName, ulong cacheKey)
+    {
+        try
+        {
+            Directory.CreateDirectory(cachePath);
+        }
+        catch (Exception)
+        {
+        }
+
+        UFBX.UFBX.SaveSceneCache(scene, cacheFileName, cacheKey);
+    }
+
+    /// <summary>
+    /// Reads the guid of an existing texture meta file, waiting for an import that's still writing it
+    /// </summary>
+    /// <param name="metaPath">The path of the meta file</param>
+    /// <returns>The guid, or an empty string if it can't be read</returns>
+    private static string ReadTextureGuid(string metaPath)
+    {
+        for (var i = 0; i < 10; i++)
+        {
+            try
+            {
+                var metadata = JsonConvert.DeserializeObject<TextureMetadata>(File.ReadAllText(metaPath),
+                    Staple.Tooling.Utilities.JsonSettings);
+
+                if ((metadata?.guid?.Length ?? 0) > 0)
+                {
+                    return metadata.guid;
+                }
+            }
+            catch (Exception)
+            {
+            }
+
+            Thread.Sleep(10);
+        }
+
+        return "";
+    }
+
+    /// <summary>
+    /// Hashes a source file along with the material libraries of OBJ files, which are loaded as external files
+    /// </summary>
+    /// <param name="meshFileName">The source file name</param>
+    /// <returns>The hash</returns>
+    private static ulong HashSource(string meshFileName)
+    {
+        ulong hash;
+
+        //Streamed since the files worth caching can be bigger than an array can hold
+        using (var stream = new FileStream(meshFileName, FileMode.Open, FileAccess.Read, FileShare.Read, HashBufferSize))
+        {
+            hash = xxHash64.ComputeHash(stream, HashBufferSize);
+        }
+
+        if (meshFileName.EndsWith(".obj", StringComparison.OrdinalIgnoreCase) == false)
+        {
+            return hash;
+        }
+
+        var directory = Path.GetDirectoryName(meshFileName);
+
+        var libraries = new List<string>()
+        {
+            Path.ChangeExtension(meshFileName, ".mtl"),
+        };
+
+        using var reader = new StreamReader(meshFileName);
+
+        string line;
+
+        while ((line = reader.ReadLine()) != null)
+        {
+            line = line.Trim();
+
+            if (line.StartsWith("mtllib "))
+            {
+                libraries.Add(Path.Combine(directory, line["mtllib ".Length..].Trim()));
+            }
+        }
+
+        foreach (var library in libraries)
+        {
+            try
+            {
+                if (File.Exists(library))
+                {
+                    var data = File.ReadAllBytes(library);
+
+                    hash = xxHash64.ComputeHash(data, data.Length, hash);
+                }
+            }
+            catch (Exception)
+            {
+            }
+        }
+
+        return hash;
+    }
 }
@@ -0,0 +1,98 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace UFBX;
+
+/// <summary>
+/// Loads several scenes through one native batch with a managed callback
+/// </summary>
+public static unsafe class UFBXManagedBatch
+{
+    /// <summary>
+    /// Receives a loaded scene. The scene belongs to the callback and must be freed with <see cref="UFBX.FreeScene"/>.
+    /// </summary>
+    /// <param name="index">The index of the file</param>
+    /// <param name="scene">The scene, or null if the file failed to load</param>
+    public delegate void SceneCallback(int index, UFBXScene* scene);
+
+    private class BatchState
+    {
+        public SceneCallback callback;
+        public List<Exception> exceptions = [];
+    }
+
+    /// <summary>
+    /// Loads files on the shared native thread pool and returns once every file is done.
+    /// The callback runs as soon as each file is loaded, from native threads and possibly concurrently.
+    /// </summary>
+    /// <param name="fileNames">The paths of the files</param>
+    /// <param name="options">Options for each file, or empty for defaults</param>
+    /// <param name="callback">The callback</param>
+    /// <exception cref="ArgumentException">If the amount of options doesn't match the amount of files</exception>
+    /// <exception cref="AggregateException">If the callback threw for any of the files</exception>
+    public static void Load(IReadOnlyList<string> fileNames, ReadOnlySpan<UFBXSceneLoadOptions> options, SceneCallback callback)
+    {
+        if (options.Length != 0 && options.Length != fileNames.Count)
+        {
+            throw new ArgumentException("Expected one set of options per file", nameof(options));
+        }
+
+        if (fileNames.Count == 0)
+        {
+            return;
+        }
+
+        var state = new BatchState() { callback = callback };
+        var handle = GCHandle.Alloc(state);
+        var names = new byte*[fileNames.Count];
+
+        try
+        {
+            for (var i = 0; i < names.Length; i++)
+            {
+                names[i] = (byte*)Marshal.StringToCoTaskMemUTF8(fileNames[i]);
+            }
+
+            fixed (byte** namesPtr = names)
+            fixed (UFBXSceneLoadOptions* optionsPtr = options)
+            {
+                UFBX.LoadScenes(namesPtr, options.Length != 0 ? optionsPtr : null, names.Length, &Loaded, GCHandle.ToIntPtr(handle));
+            }
+        }
+        finally
+        {
+            foreach (var name in names)
+            {
+                Marshal.FreeCoTaskMem((nint)name);
+            }
+
+            handle.Free();
+        }
+
+        if (state.exceptions.Count > 0)
+        {
+            throw new AggregateException(state.exceptions);
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void Loaded(nint user, int index, UFBXScene* scene)
+    {
+        var state = (BatchState)GCHandle.FromIntPtr(user).Target;
+
+        try
+        {
+            state.callback(index, scene);
+        }
+        catch (Exception e)
+        {
+            //Exceptions can't cross into native code, so they're thrown once the batch is done
+            lock (state.exceptions)
+            {
+                state.exceptions.Add(e);
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+﻿using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace UFBX;
+
+/// <summary>
+/// Forwards native import progress to a managed callback
+/// </summary>
+public static unsafe class UFBXManagedProgress
+{
+    /// <summary>
+    /// Receives the import progress. Return false to cancel the import.
+    /// </summary>
+    /// <param name="progress">The current progress</param>
+    public delegate bool ProgressCallback(in UFBXImportProgress progress);
+
+    /// <summary>
+    /// Sets a managed progress callback on load options.
+    /// Must be released with <see cref="Free(ref UFBXSceneLoadOptions)"/> once the scene is loaded.
+    /// </summary>
+    /// <param name="options">The options to set the callback on</param>
+    /// <param name="callback">The callback</param>
+    public static void Set(ref UFBXSceneLoadOptions options, ProgressCallback callback)
+    {
+        Free(ref options);
+
+        options.progressCallback = &Report;
+        options.progressUser = GCHandle.ToIntPtr(GCHandle.Alloc(callback));
+    }
+
+    /// <summary>
+    /// Releases a callback set with <see cref="Set(ref UFBXSceneLoadOptions, ProgressCallback)"/>
+    /// </summary>
+    /// <param name="options">The options with the callback</param>
+    public static void Free(ref UFBXSceneLoadOptions options)
+    {
+        if (options.progressUser != 0)
+        {
+            GCHandle.FromIntPtr(options.progressUser).Free();
+        }
+
+        options.progressCallback = null;
+        options.progressUser = 0;
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static byte Report(nint user, UFBXImportProgress* progress)
+    {
+        try
+        {
+            var callback = (ProgressCallback)GCHandle.FromIntPtr(user).Target;
+
+            return callback(in *progress) ? (byte)1 : (byte)0;
+        }
+        catch (Exception)
+        {
+            //Exceptions can't cross into native code, so treat them as a cancellation
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,187 @@
+﻿using System;
+using System.IO;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace UFBX;
+
+/// <summary>
+/// Exposes managed streams and file systems to the native importer
+/// </summary>
+public static unsafe class UFBXManagedStream
+{
+    private class FileSystemState
+    {
+        public Func<string, Stream> open;
+    }
+
+    /// <summary>
+    /// Creates a native stream that reads from a managed stream.
+    /// The stream is kept alive and disposed once the importer closes it.
+    /// </summary>
+    /// <param name="stream">The stream to read from</param>
+    /// <returns>The native stream</returns>
+    public static UFBXStream Create(Stream stream)
+    {
+        return new()
+        {
+            read = &Read,
+            skip = &Skip,
+            size = &Size,
+            close = &Close,
+            user = GCHandle.ToIntPtr(GCHandle.Alloc(stream)),
+        };
+    }
+
+    /// <summary>
+    /// Creates a native file system that opens files through a callback.
+    /// Must be released with <see cref="FreeFileSystem(ref UFBXFileSystem)"/> once the scene is loaded.
+    /// </summary>
+    /// <param name="open">Returns a stream for a path, or null if the file doesn't exist</param>
+    /// <returns>The native file system</returns>
+    public static UFBXFileSystem CreateFileSystem(Func<string, Stream> open)
+    {
+        return new()
+        {
+            open = &Open,
+            user = GCHandle.ToIntPtr(GCHandle.Alloc(new FileSystemState() { open = open })),
+        };
+    }
+
+    /// <summary>
+    /// Releases a file system created with <see cref="CreateFileSystem(Func{string, Stream})"/>
+    /// </summary>
+    /// <param name="fileSystem">The file system</param>
+    public static void FreeFileSystem(ref UFBXFileSystem fileSystem)
+    {
+        if (fileSystem.user != 0)
+        {
+            GCHandle.FromIntPtr(fileSystem.user).Free();
+
+            fileSystem.user = 0;
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static nuint Read(nint user, void* data, nuint size)
+    {
+        try
+        {
+            var stream = (Stream)GCHandle.FromIntPtr(user).Target;
+
+            var span = new Span<byte>(data, (int)Math.Min(size, int.MaxValue));
+            var total = 0;
+
+            //Streams may return less than requested before the end, so keep going until the buffer is full
+            while (total < span.Length)
+            {
+                var count = stream.Read(span[total..]);
+
+                if (count == 0)
+                {
+                    break;
+                }
+
+                total += count;
+            }
+
+            return (nuint)total;
+        }
+        catch (Exception)
+        {
+            return nuint.MaxValue;
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static byte Skip(nint user, nuint size)
+    {
+        try
+        {
+            var stream = (Stream)GCHandle.FromIntPtr(user).Target;
+
+            if (stream.CanSeek)
+            {
+                stream.Seek((long)size, SeekOrigin.Current);
+
+                return 1;
+            }
+
+            Span<byte> buffer = stackalloc byte[4096];
+
+            while (size > 0)
+            {
+                var count = stream.Read(buffer[..(int)Math.Min(size, (nuint)buffer.Length)]);
+
+                if (count == 0)
+                {
+                    return 0;
+                }
+
+                size -= (nuint)count;
+            }
+
+            return 1;
+        }
+        catch (Exception)
+        {
+            return 0;
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static ulong Size(nint user)
+    {
+        try
+        {
+            var stream = (Stream)GCHandle.FromIntPtr(user).Target;
+
+            return stream.CanSeek ? (ulong)stream.Length : 0;
+        }
+        catch (Exception)
+        {
+            return 0;
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static void Close(nint user)
+    {
+        var handle = GCHandle.FromIntPtr(user);
+
+        try
+        {
+            ((Stream)handle.Target)?.Dispose();
+        }
+        catch (Exception)
+        {
+        }
+
+        handle.Free();
+    }
+
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    private static byte Open(nint user, byte* path, int pathLength, UFBXStream* stream)
+    {
+        try
+        {
+            var state = (FileSystemState)GCHandle.FromIntPtr(user).Target;
+
+            var fileStream = state.open(Encoding.UTF8.GetString(path, pathLength));
+
+            if (fileStream == null)
+            {
+                return 0;
+            }
+
+            *stream = Create(fileStream);
+
+            return 1;
+        }
+        catch (Exception)
+        {
+            return 0;
+        }
+    }
+}
@@ -14,6 +14,61 @@ public struct UFBXTransform
     public Vector3 scale;
 }
 
+/// <summary>
+/// Vertex attributes a mesh can have, in the order they're stored in an interleaved vertex
+/// </summary>
+[Flags]
+public enum UFBXVertexAttributes : uint
+{
+    None = 0,
+    Position = (1 << 0),
+    Normal = (1 << 1),
+    Tangent = (1 << 2),
+    Bitangent = (1 << 3),
+    Color0 = (1 << 4),
+    Color1 = (1 << 5),
+    Color2 = (1 << 6),
+    Color3 = (1 << 7),
+    TexCoord0 = (1 << 8),
+    TexCoord1 = (1 << 9),
+    TexCoord2 = (1 << 10),
+    TexCoord3 = (1 << 11),
+    TexCoord4 = (1 << 12),
+    TexCoord5 = (1 << 13),
+    TexCoord6 = (1 << 14),
+    TexCoord7 = (1 << 15),
+    BlendIndices = (1 << 16),
+    BlendWeights = (1 << 17),
+    BlendIndices1 = (1 << 18),
+    BlendWeights1 = (1 << 19),
+
+    Colors = Color0 | Color1 | Color2 | Color3,
+    TexCoords = TexCoord0 | TexCoord1 | TexCoord2 | TexCoord3 | TexCoord4 | TexCoord5 | TexCoord6 | TexCoord7,
+    Skin = BlendIndices | BlendWeights | BlendIndices1 | BlendWeights1,
+    All = (1 << 20) - 1,
+}
+
+/// <summary>
+/// Which meshes get generated MikkTSpace tangents and bitangents
+/// </summary>
+public enum UFBXTangentGeneration : int
+{
+    /// <summary>
+    /// Tangents and bitangents are only imported
+    /// </summary>
+    Import,
+
+    /// <summary>
+    /// Generated for meshes that don't have any
+    /// </summary>
+    Missing,
+
+    /// <summary>
+    /// Always generated, replacing the imported ones
+    /// </summary>
+    Always,
+}
+
 [StructLayout(LayoutKind.Sequential, Pack = 0)]
 public unsafe struct UFBXMeshBone
 {
@@ -21,6 +76,76 @@ public unsafe struct UFBXMeshBone
     public Matrix4x4 offsetMatrix;
 }
 
+/// <summary>
+/// Sparse morph target of a mesh. Only the vertices the shape moves are stored.
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXBlendShape
+{
+    public UFBXString name;
+
+    /// <summary>
+    /// The blend channel that drives this shape, matches <see cref="UFBXBlendShapeAnimation.channelIndex"/>
+    /// </summary>
+    public int channelIndex;
+
+    /// <summary>
+    /// Weight of the channel when it isn't animated, from 0 to 1
+    /// </summary>
+    public float weight;
+
+    public uint* vertexIndices;
+    public Vector3* positionDeltas;
+    public Vector3* normalDeltas;
+    public int deltaCount;
+
+    /// <summary>
+    /// Indices of the mesh vertices the shape moves, in increasing order
+    /// </summary>
+    public readonly Span<uint> VertexIndices => deltaCount > 0 ? new(vertexIndices, deltaCount) : default;
+
+    public readonly Span<Vector3> PositionDeltas => deltaCount > 0 ? new(positionDeltas, deltaCount) : default;
+
+    /// <summary>
+    /// Empty if the shape doesn't change normals or the mesh has none
+    /// </summary>
+    public readonly Span<Vector3> NormalDeltas => deltaCount > 0 && normalDeltas != null ? new(normalDeltas, deltaCount) : default;
+}
+
+/// <summary>
+/// Cluster of triangles of a mesh, used to cull parts of a mesh on the GPU
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public struct UFBXMeshlet
+{
+    /// <summary>
+    /// First entry of <see cref="UFBXMesh.MeshletVertices"/> used by this meshlet
+    /// </summary>
+    public uint vertexOffset;
+
+    /// <summary>
+    /// First entry of <see cref="UFBXMesh.MeshletTriangles"/> used by this meshlet, always a multiple of 4
+    /// </summary>
+    public uint triangleOffset;
+
+    public uint vertexCount;
+    public uint triangleCount;
+
+    /// <summary>
+    /// Bounding sphere of the meshlet's vertices
+    /// </summary>
+    public Vector3 center;
+    public float radius;
+
+    /// <summary>
+    /// Normal cone of the meshlet's triangles. Every triangle faces away from a camera at `position` when
+    /// dot(normalize(coneApex - position), coneAxis) >= coneCutoff.
+    /// </summary>
+    public Vector3 coneApex;
+    public Vector3 coneAxis;
+    public float coneCutoff;
+}
+
 [StructLayout(LayoutKind.Sequential, Pack = 0)]
 public unsafe struct UFBXMesh
 {
@@ -58,6 +183,61 @@ public unsafe struct UFBXMesh
 
     public int boneCount;
 
+    public UFBXVertexAttributes attributes;
+
+    public float* interleavedVertices;
+
+    public int vertexStride;
+
+    public Vector4* boneIndices1;
+    public Vector4* boneWeights1;
+
+    public void* skinIndices;
+    public ushort* skinWeights;
+    public int skinIndexSize;
+    public int skinInfluenceCount;
+
+    public UFBXBlendShape* blendShapes;
+    public int blendShapeCount;
+
+    public UFBXMeshlet* meshlets;
+    public int meshletCount;
+    public uint* meshletVertices;
+    public int meshletVertexCount;
+    public byte* meshletTriangles;
+    public int meshletTriangleIndexCount;
+
+    public short* quantizedPositions;
+    public short* quantizedNormals;
+    public short* quantizedTangents;
+    public short* quantizedBitangents;
+    public Half* quantizedUV0;
+    public Half* quantizedUV1;
+    public Half* quantizedUV2;
+    public Half* quantizedUV3;
+    public Half* quantizedUV4;
+    public Half* quantizedUV5;
+    public Half* quantizedUV6;
+    public Half* quantizedUV7;
+    public byte* quantizedColor0;
+    public byte* quantizedColor1;
+    public byte* quantizedColor2;
+    public byte* quantizedColor3;
+
+    /// <summary>
+    /// Dequantizes <see cref="QuantizedPositions"/>: position = positionOffset + xyz / 32767 * positionScale
+    /// </summary>
+    public Vector3 positionOffset;
+    public Vector3 positionScale;
+
+    /// <summary>
+    /// Whether the tangents and bitangents were generated, see <see cref="UFBXSceneLoadOptions.tangentGeneration"/>
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool generatedTangents;
+
+    private static ReadOnlySpan<byte> AttributeComponentCounts => [3, 3, 3, 3, 4, 4, 4, 4, 2, 2, 2, 2, 2, 2, 2, 2, 4, 4, 4, 4];
+
     public readonly Span<Vector3> Vertices => vertexCount > 0 ? new(vertices, vertexCount) : default;
 
     public readonly Span<Vector3> Normals => vertexCount > 0 ? new(normals, vertexCount) : default;
@@ -97,31 +277,215 @@ public unsafe struct UFBXMesh
     public readonly Span<uint> Indices => indexCount > 0 ? new(indices, indexCount) : default;
 
     public readonly Span<UFBXMeshBone> Bones => boneCount > 0 ? new(bones, boneCount) : default;
-}
 
-[StructLayout(LayoutKind.Sequential, Pack = 0)]
-public unsafe struct UFBXString
-{
-    public fixed sbyte data[10240];
-    public int length;
+    public readonly Span<Vector4> BoneIndices1 => vertexCount > 0 && boneIndices1 != null ? new(boneIndices1, vertexCount) : default;
+
+    public readonly Span<Vector4> BoneWeights1 => vertexCount > 0 && boneWeights1 != null ? new(boneWeights1, vertexCount) : default;
+
+    /// <summary>
+    /// Compact bone indices when <see cref="skinIndexSize"/> is 1, <see cref="skinInfluenceCount"/> per vertex
+    /// </summary>
+    public readonly Span<byte> SkinIndices8 => vertexCount > 0 && skinIndices != null && skinIndexSize == 1 ?
+        new(skinIndices, vertexCount * skinInfluenceCount) : default;
+
+    /// <summary>
+    /// Compact bone indices when <see cref="skinIndexSize"/> is 2, <see cref="skinInfluenceCount"/> per vertex
+    /// </summary>
+    public readonly Span<ushort> SkinIndices16 => vertexCount > 0 && skinIndices != null && skinIndexSize == 2 ?
+        new(skinIndices, vertexCount * skinInfluenceCount) : default;
+
+    /// <summary>
+    /// Empty unless loaded with <see cref="UFBXSceneLoadOptions.buildMeshlets"/>
+    /// </summary>
+    public readonly Span<UFBXMeshlet> Meshlets => meshletCount > 0 ? new(meshlets, meshletCount) : default;
+
+    /// <summary>
+    /// Indices into the mesh's vertices, referenced by each meshlet
+    /// </summary>
+    public readonly Span<uint> MeshletVertices => meshletVertexCount > 0 ? new(meshletVertices, meshletVertexCount) : default;
+
+    /// <summary>
+    /// 3 entries per triangle, as indices into the vertices of their meshlet
+    /// </summary>
+    public readonly Span<byte> MeshletTriangles => meshletTriangleIndexCount > 0 ? new(meshletTriangles, meshletTriangleIndexCount) : default;
+
+    /// <summary>
+    /// Snorm16 positions relative to the mesh's bounds, 4 per vertex with w always 0. Set instead of <see cref="Vertices"/>
+    /// when loaded with <see cref="UFBXSceneLoadOptions.quantize"/>, see <see cref="positionOffset"/>.
+    /// </summary>
+    public readonly Span<short> QuantizedPositions => vertexCount > 0 && quantizedPositions != null ?
+        new(quantizedPositions, vertexCount * 4) : default;
+
+    /// <summary>
+    /// Octahedral encoded snorm16 normals, 2 per vertex
+    /// </summary>
+    public readonly Span<short> QuantizedNormals => vertexCount > 0 && quantizedNormals != null ? new(quantizedNormals, vertexCount * 2) : default;
+
+    public readonly Span<short> QuantizedTangents => vertexCount > 0 && quantizedTangents != null ? new(quantizedTangents, vertexCount * 2) : default;
+
+    public readonly Span<short> QuantizedBitangents => vertexCount > 0 && quantizedBitangents != null ?
+        new(quantizedBitangents, vertexCount * 2) : default;
+
+    /// <summary>
+    /// Gets the half float UVs of a UV channel, 2 per vertex
+    /// </summary>
+    /// <param name="index">The UV channel, from 0 to 7</param>
+    /// <returns>The UVs, or an empty span if the mesh doesn't have them</returns>
+    public readonly Span<Half> QuantizedUV(int index)
+    {
+        var UV = index switch
+        {
+            0 => quantizedUV0,
+            1 => quantizedUV1,
+            2 => quantizedUV2,
+            3 => quantizedUV3,
+            4 => quantizedUV4,
+            5 => quantizedUV5,
+            6 => quantizedUV6,
+            7 => quantizedUV7,
+            _ => null,
+        };
+
+        return vertexCount > 0 && UV != null ? new(UV, vertexCount * 2) : default;
+    }
+
+    /// <summary>
+    /// Gets the unorm8 colors of a color channel, 4 per vertex
+    /// </summary>
+    /// <param name="index">The color channel, from 0 to 3</param>
+    /// <returns>The colors, or an empty span if the mesh doesn't have them</returns>
+    public readonly Span<byte> QuantizedColor(int index)
+    {
+        var color = index switch
+        {
+            0 => quantizedColor0,
+            1 => quantizedColor1,
+            2 => quantizedColor2,
+            3 => quantizedColor3,
+            _ => null,
+        };
+
+        return vertexCount > 0 && color != null ? new(color, vertexCount * 4) : default;
+    }
 
-    public override string ToString()
+    /// <summary>
+    /// Unorm16 bone weights, <see cref="skinInfluenceCount"/> per vertex. The weights of each vertex add up to 65535.
+    /// </summary>
+    public readonly Span<ushort> SkinWeights => vertexCount > 0 && skinWeights != null ?
+        new(skinWeights, vertexCount * skinInfluenceCount) : default;
+
+    /// <summary>
+    /// One blend shape per blend channel that deforms the mesh
+    /// </summary>
+    public readonly Span<UFBXBlendShape> BlendShapes => blendShapeCount > 0 ? new(blendShapes, blendShapeCount) : default;
+
+    public readonly Span<float> InterleavedVertices => vertexCount > 0 && interleavedVertices != null ?
+        new(interleavedVertices, vertexCount * vertexStride / sizeof(float)) : default;
+
+    /// <summary>
+    /// Gets the offset of an attribute inside an interleaved vertex
+    /// </summary>
+    /// <param name="attribute">A single attribute</param>
+    /// <returns>The offset in floats, or -1 if the mesh doesn't have the attribute</returns>
+    public readonly int AttributeOffset(UFBXVertexAttributes attribute)
     {
-        if(length <= 0)
+        if (BitOperations.PopCount((uint)attribute) != 1 || attributes.HasFlag(attribute) == false)
         {
-            return "";
+            return -1;
         }
 
-        unsafe
+        var index = BitOperations.TrailingZeroCount((uint)attribute);
+        var offset = 0;
+
+        for (var i = 0; i < index; i++)
         {
-            fixed (void* ptr = data)
+            if (((uint)attributes & (1u << i)) != 0)
             {
-                return Encoding.UTF8.GetString((byte*)ptr, length);
+                offset += AttributeComponentCounts[i];
             }
         }
+
+        return offset;
+    }
+
+    /// <summary>
+    /// Copies an attribute out of the interleaved vertices
+    /// </summary>
+    /// <typeparam name="T">A type with the same size as the attribute, such as <see cref="Vector3"/> for positions</typeparam>
+    /// <param name="attribute">A single attribute</param>
+    /// <returns>The attribute values, or an empty array if the mesh doesn't have the attribute</returns>
+    /// <exception cref="ArgumentException">Thrown if the size of T doesn't match the attribute</exception>
+    public readonly T[] ReadAttribute<T>(UFBXVertexAttributes attribute) where T : unmanaged
+    {
+        var offset = AttributeOffset(attribute);
+
+        if (offset < 0 || interleavedVertices == null || vertexCount <= 0)
+        {
+            return [];
+        }
+
+        if (sizeof(T) != AttributeComponentCounts[BitOperations.TrailingZeroCount((uint)attribute)] * sizeof(float))
+        {
+            throw new ArgumentException($"Type {typeof(T).Name} doesn't match the size of attribute {attribute}");
+        }
+
+        var outValue = new T[vertexCount];
+        var stride = vertexStride / sizeof(float);
+
+        for (var i = 0; i < vertexCount; i++)
+        {
+            outValue[i] = Unsafe.ReadUnaligned<T>(interleavedVertices + i * stride + offset);
+        }
+
+        return outValue;
     }
 }
 
+/// <summary>
+/// Reference to a string in the string pool of a <see cref="UFBXScene"/>.
+/// Use <see cref="UFBXScene.GetString(UFBXString)"/> or <see cref="UFBXScene.GetStringBytes(UFBXString)"/> to read it.
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public struct UFBXString
+{
+    public int offset;
+    public int length;
+}
+
+/// <summary>
+/// A texture used by the materials of a scene
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXTexture
+{
+    public UFBXString name;
+    public UFBXString fileName;
+
+    /// <summary>
+    /// Contents of the file when it's embedded in the scene, like the raw bytes of a .png
+    /// </summary>
+    public byte* content;
+    public int contentSize;
+
+    /// <summary>
+    /// Hash of the contents. Embedded textures with the same contents are only stored once.
+    /// </summary>
+    public ulong contentHash;
+
+    /// <summary>
+    /// Whether the file is embedded in the scene
+    /// </summary>
+    public readonly bool IsEmbedded => contentSize > 0 && content != null;
+
+    /// <summary>
+    /// The embedded contents, which are only valid while the scene is alive
+    /// </summary>
+    public readonly ReadOnlySpan<byte> Content => IsEmbedded ? new(content, contentSize) : default;
+}
+
+/// <summary>
+/// Texture indices point into <see cref="UFBXScene.Textures"/> and are -1 when the material doesn't have that texture
+/// </summary>
 [StructLayout(LayoutKind.Sequential, Pack = 0)]
 public unsafe struct UFBXMaterial
 {
@@ -129,51 +493,61 @@ public unsafe struct UFBXMaterial
 
     public Vector4 diffuseColor;
     public UFBXString diffuseTexture;
+    public int diffuseTextureIndex;
     public int diffuseWrapU;
     public int diffuseWrapV;
 
     public Vector4 specularColor;
     public UFBXString specularTexture;
+    public int specularTextureIndex;
     public int specularWrapU;
     public int specularWrapV;
 
     public Vector4 reflectionColor;
     public UFBXString reflectionTexture;
+    public int reflectionTextureIndex;
     public int reflectionWrapU;
     public int reflectionWrapV;
 
     public Vector4 transparencyColor;
     public UFBXString transparencyTexture;
+    public int transparencyTextureIndex;
     public int transparencyWrapU;
     public int transparencyWrapV;
 
     public Vector4 emissionColor;
     public UFBXString emissionTexture;
+    public int emissionTextureIndex;
     public int emissionWrapU;
     public int emissionWrapV;
 
     public Vector4 ambientColor;
     public UFBXString ambientTexture;
+    public int ambientTextureIndex;
     public int ambientWrapU;
     public int ambientWrapV;
 
     public Vector4 normalMapColor;
     public UFBXString normalMapTexture;
+    public int normalMapTextureIndex;
     public int normalMapWrapU;
     public int normalMapWrapV;
 
     public Vector4 bumpColor;
     public UFBXString bumpTexture;
+    public int bumpTextureIndex;
     public int bumpWrapU;
     public int bumpWrapV;
 
     public Vector4 displacementColor;
     public UFBXString displacementTexture;
+    public int displacementTextureIndex;
     public int displacementWrapU;
     public int displacementWrapV;
 
     public Vector4 vectorDisplacementColor;
     public UFBXString vectorDisplacementTexture;
+    public int vectorDisplacementTextureIndex;
     public int vectorDisplacementWrapU;
     public int vectorDisplacementWrapV;
 }
@@ -207,9 +581,32 @@ public unsafe struct UFBXQuaternionKey
     public Quaternion value;
 }
 
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXFloatKey
+{
+    public float time;
+    public float value;
+}
+
+/// <summary>
+/// Weight of a blend channel over time, from 0 to 1
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXBlendShapeAnimation
+{
+    public int channelIndex;
+    public UFBXFloatKey* weights;
+    public int weightCount;
+
+    public readonly Span<UFBXFloatKey> Weights => weightCount > 0 ? new(weights, weightCount) : default;
+}
+
 [StructLayout(LayoutKind.Sequential, Pack = 0)]
 public unsafe struct UFBXNodeAnimation
 {
+    /// <summary>
+    /// Index into <see cref="UFBXScene.Nodes"/>. Channels are sorted by it and there's at most one per node.
+    /// </summary>
     public int nodeIndex;
     public UFBXVector3Key* positions;
     public UFBXQuaternionKey* rotations;
@@ -234,6 +631,59 @@ public unsafe struct UFBXAnimation
 
     public UFBXNodeAnimation* nodes;
     public int nodeCount;
+
+    public UFBXBlendShapeAnimation* blendShapes;
+    public int blendShapeCount;
+
+    public readonly Span<UFBXBlendShapeAnimation> BlendShapes => blendShapeCount > 0 ? new(blendShapes, blendShapeCount) : default;
+}
+
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXLODLevel
+{
+    /// <summary>
+    /// Distance the level starts at in meters, or the screen size percentage it starts at if <see cref="UFBXLODGroup.relativeDistances"/> is set
+    /// </summary>
+    public float distance;
+
+    /// <summary>
+    /// Child of the group that holds this level, or -1 if the group has fewer children than levels
+    /// </summary>
+    public int nodeIndex;
+
+    public int* meshIndices;
+    public int meshCount;
+
+    /// <summary>
+    /// Meshes of the level's node and every node below it
+    /// </summary>
+    public readonly Span<int> MeshIndices => meshCount > 0 ? new(meshIndices, meshCount) : default;
+}
+
+/// <summary>
+/// A node whose children are levels of detail of the same object. Only one of them should be shown at a time.
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXLODGroup
+{
+    public int nodeIndex;
+
+    [MarshalAs(UnmanagedType.I1)]
+    public bool relativeDistances;
+
+    /// <summary>
+    /// Whether the whole group is hidden outside of the distance limits
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool useDistanceLimit;
+
+    public float distanceLimitMin;
+    public float distanceLimitMax;
+
+    public UFBXLODLevel* levels;
+    public int levelCount;
+
+    public readonly Span<UFBXLODLevel> Levels => levelCount > 0 ? new(levels, levelCount) : default;
 }
 
 [StructLayout(LayoutKind.Sequential, Pack = 0)]
@@ -251,6 +701,15 @@ public unsafe struct UFBXScene
     public UFBXAnimation* animations;
     public int animationCount;
 
+    public byte* strings;
+    public int stringsLength;
+
+    public UFBXLODGroup* lodGroups;
+    public int lodGroupCount;
+
+    public UFBXTexture* textures;
+    public int textureCount;
+
     public readonly Span<UFBXNode> Nodes => nodeCount > 0 ? new(nodes, nodeCount) : default;
 
     public readonly Span<UFBXMesh> Meshes => meshCount > 0 ? new(meshes, meshCount) : default;
@@ -258,15 +717,356 @@ public unsafe struct UFBXScene
     public readonly Span<UFBXMaterial> Materials => materialCount > 0 ? new(materials, materialCount) : default;
 
     public readonly Span<UFBXAnimation> Animations => animationCount > 0 ? new(animations, animationCount) : default;
+
+    public readonly Span<UFBXLODGroup> LODGroups => lodGroupCount > 0 ? new(lodGroups, lodGroupCount) : default;
+
+    public readonly Span<UFBXTexture> Textures => textureCount > 0 ? new(textures, textureCount) : default;
+
+    /// <summary>
+    /// Gets the UTF-8 bytes of a string without copying them
+    /// </summary>
+    /// <param name="value">The string reference</param>
+    /// <returns>The bytes, which are only valid while the scene is alive</returns>
+    public readonly ReadOnlySpan<byte> GetStringBytes(UFBXString value)
+    {
+        if (value.length <= 0 ||
+            value.offset < 0 ||
+            value.offset + value.length > stringsLength)
+        {
+            return default;
+        }
+
+        return new(strings + value.offset, value.length);
+    }
+
+    /// <summary>
+    /// Gets a string from the string pool
+    /// </summary>
+    /// <param name="value">The string reference</param>
+    /// <returns>The string</returns>
+    public readonly string GetString(UFBXString value)
+    {
+        var bytes = GetStringBytes(value);
+
+        return bytes.Length > 0 ? Encoding.UTF8.GetString(bytes) : "";
+    }
+}
+
+public enum UFBXImportStage
+{
+    /// <summary>
+    /// Parsing the file, counted in bytes
+    /// </summary>
+    Parse,
+
+    /// <summary>
+    /// Building the vertices of each mesh, counted in triangles
+    /// </summary>
+    Meshes,
+
+    /// <summary>
+    /// Removing duplicate vertices, counted in triangle corners
+    /// </summary>
+    Indices,
+
+    /// <summary>
+    /// Baking animations, counted in animation stacks
+    /// </summary>
+    Animations,
+
+    Count,
+}
+
+/// <summary>
+/// Counters of every import stage at the time of a progress report.
+/// Totals are known once a stage starts. The parse total is 0 for streams of unknown size.
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXImportProgress
+{
+    /// <summary>
+    /// The stage that is being worked on
+    /// </summary>
+    public UFBXImportStage stage;
+
+    public fixed ulong done[(int)UFBXImportStage.Count];
+    public fixed ulong total[(int)UFBXImportStage.Count];
+
+    /// <summary>
+    /// Gets how much of a stage is done, from 0 to 1
+    /// </summary>
+    /// <param name="stage">The stage</param>
+    /// <returns>The progress of the stage</returns>
+    public readonly float StageProgress(UFBXImportStage stage)
+    {
+        var stageTotal = total[(int)stage];
+
+        return stageTotal > 0 ? System.Math.Clamp(done[(int)stage] / (float)stageTotal, 0, 1) : 0;
+    }
+}
+
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXSceneLoadOptions
+{
+    /// <summary>
+    /// Maximum amount of threads used to parse the file and extract its meshes. 0 uses every thread of the shared native pool, 1 disables threading.
+    /// </summary>
+    public int threadCount;
+
+    /// <summary>
+    /// Vertex attributes to import. Attributes that aren't requested are skipped entirely, including when removing duplicate vertices.
+    /// <see cref="UFBXVertexAttributes.None"/> imports everything.
+    /// </summary>
+    public UFBXVertexAttributes attributes;
+
+    /// <summary>
+    /// Whether to store the vertices of each mesh in <see cref="UFBXMesh.interleavedVertices"/> instead of one array per attribute
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool interleaved;
+
+    /// <summary>
+    /// Amount of bone influences per vertex, either 4 or 8. The strongest influences are kept. 0 uses 4.
+    /// </summary>
+    public int maxBoneInfluences;
+
+    /// <summary>
+    /// Whether to store skin data in <see cref="UFBXMesh.skinIndices"/> and <see cref="UFBXMesh.skinWeights"/>
+    /// as 8 or 16 bit bone indices and unorm16 weights, instead of float blend attributes
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool compactSkin;
+
+    /// <summary>
+    /// Optional, called periodically with the import progress from any thread, but never concurrently.
+    /// Returning 0 cancels the import, which then returns no scene. See <see cref="UFBXManagedProgress"/>.
+    /// </summary>
+    public delegate* unmanaged[Cdecl]<nint, UFBXImportProgress*, byte> progressCallback;
+
+    public nint progressUser;
+
+    /// <summary>
+    /// Samples per second used to resample non-linear animation. 0 uses 30.
+    /// </summary>
+    public double animationSampleRate;
+
+    /// <summary>
+    /// Keyframes at or above this rate aren't resampled. 0 uses 19.5.
+    /// </summary>
+    public double animationMinimumSampleRate;
+
+    /// <summary>
+    /// Keys closer together than this rate are removed. 0 doesn't limit the rate.
+    /// </summary>
+    public double animationMaximumSampleRate;
+
+    /// <summary>
+    /// Whether to remove animation keys that can be interpolated from their neighbours
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool animationKeyReduction;
+
+    /// <summary>
+    /// Maximum error of a removed key. 0 uses 0.000001.
+    /// </summary>
+    public double animationKeyReductionThreshold;
+
+    /// <summary>
+    /// Maximum amount of keys generated from a single keyframe. 0 uses 32.
+    /// </summary>
+    public int animationMaxKeyframeSegments;
+
+    /// <summary>
+    /// Whether to reverse the winding order of every triangle
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool flipWindingOrder;
+
+    /// <summary>
+    /// Whether to reorder triangles for the vertex cache and overdraw, and vertices in the order they're used
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool optimizeMeshes;
+
+    /// <summary>
+    /// Whether to split meshes into meshlets for GPU culling. Best combined with <see cref="optimizeMeshes"/>, which keeps them compact.
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool buildMeshlets;
+
+    /// <summary>
+    /// Maximum amount of vertices of a meshlet, up to 256. 0 uses 64.
+    /// </summary>
+    public int meshletMaxVertices;
+
+    /// <summary>
+    /// Maximum amount of triangles of a meshlet, up to 512 and rounded down to a multiple of 4. 0 uses 124.
+    /// </summary>
+    public int meshletMaxTriangles;
+
+    /// <summary>
+    /// Whether meshes are emitted with quantized attributes instead of floats: snorm16 positions, octahedral normals and tangents,
+    /// half float UVs and unorm8 colors. Implies <see cref="compactSkin"/> for skinned meshes.
+    /// </summary>
+    [MarshalAs(UnmanagedType.I1)]
+    public bool quantize;
+
+    /// <summary>
+    /// Which meshes get tangents and bitangents generated from their normals and first UV set.
+    /// Generation runs before vertices are merged, so UV seams keep separate tangents on each side.
+    /// Only applies when tangents or bitangents are part of <see cref="attributes"/>.
+    /// </summary>
+    public UFBXTangentGeneration tangentGeneration;
+}
+
+/// <summary>
+/// Data source for <see cref="UFBX.LoadSceneFromStream"/> and <see cref="UFBXFileSystem"/>. See <see cref="UFBXManagedStream"/> to wrap a <see cref="System.IO.Stream"/>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXStream
+{
+    /// <summary>
+    /// Reads up to a number of bytes and returns the amount read, or <see cref="nuint.MaxValue"/> on error
+    /// </summary>
+    public delegate* unmanaged[Cdecl]<nint, void*, nuint, nuint> read;
+
+    /// <summary>
+    /// Optional, skips a number of bytes and returns 1 on success
+    /// </summary>
+    public delegate* unmanaged[Cdecl]<nint, nuint, byte> skip;
+
+    /// <summary>
+    /// Optional, returns the size of the data or 0 if unknown
+    /// </summary>
+    public delegate* unmanaged[Cdecl]<nint, ulong> size;
+
+    /// <summary>
+    /// Optional, called once the stream is no longer needed
+    /// </summary>
+    public delegate* unmanaged[Cdecl]<nint, void> close;
+
+    public nint user;
+}
+
+/// <summary>
+/// Resolves files referenced by a scene, such as the material libraries of OBJ files
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 0)]
+public unsafe struct UFBXFileSystem
+{
+    /// <summary>
+    /// Receives the user pointer and a UTF-8 path with its length. Fills the stream and returns 1, or returns 0 if the file doesn't exist.
+    /// </summary>
+    public delegate* unmanaged[Cdecl]<nint, byte*, int, UFBXStream*, byte> open;
+
+    public nint user;
 }
 
 public partial class UFBX
 {
+    /// <summary>
+    /// Version of the native structure layout these bindings were written for
+    /// </summary>
+    public const int ABIVersion = 13;
+
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXABIVersion")]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    public static partial int NativeABIVersion();
+
     [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXLoadScene", StringMarshalling = StringMarshalling.Utf8)]
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     public static unsafe partial UFBXScene* LoadScene(string fileName);
 
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXLoadSceneWithOptions", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe partial UFBXScene* LoadSceneWithOptions(string fileName, UFBXSceneLoadOptions* options);
+
+    /// <summary>
+    /// Loads a scene from memory. The data isn't copied and must stay valid until this returns.
+    /// </summary>
+    /// <param name="data">The file data</param>
+    /// <param name="size">The size of the data</param>
+    /// <param name="fileName">Optional file name used to detect the file format and resolve external files</param>
+    /// <param name="options">Options to load with, or null for defaults</param>
+    /// <param name="fileSystem">Optional file system to open external files with</param>
+    /// <returns>The scene, or null</returns>
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXLoadSceneFromMemory", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe partial UFBXScene* LoadSceneFromMemory(void* data, nuint size, string fileName, UFBXSceneLoadOptions* options,
+        UFBXFileSystem* fileSystem);
+
+    /// <summary>
+    /// Loads a scene from a stream. The stream is closed before this returns.
+    /// </summary>
+    /// <param name="stream">The stream to read</param>
+    /// <param name="fileName">Optional file name used to detect the file format and resolve external files</param>
+    /// <param name="options">Options to load with, or null for defaults</param>
+    /// <param name="fileSystem">Optional file system to open external files with</param>
+    /// <returns>The scene, or null</returns>
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXLoadSceneFromStream", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe partial UFBXScene* LoadSceneFromStream(UFBXStream* stream, string fileName, UFBXSceneLoadOptions* options,
+        UFBXFileSystem* fileSystem);
+
+    /// <summary>
+    /// Loads several files at once on the shared native thread pool and returns once all of them are done.
+    /// Small files are loaded side by side on one thread each, large ones also split their own work across the pool.
+    /// </summary>
+    /// <param name="fileNames">UTF-8 paths of the files</param>
+    /// <param name="options">Options for each file, or null for defaults</param>
+    /// <param name="count">Amount of files</param>
+    /// <param name="callback">Receives the index of each file and its scene, or null if it failed to load, as soon as the file is done.
+    /// Called from native threads, possibly concurrently. Scenes must be freed with <see cref="FreeScene"/>.</param>
+    /// <param name="user">User data passed to the callback</param>
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXLoadScenes")]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe partial void LoadScenes(byte** fileNames, UFBXSceneLoadOptions* options, int count,
+        delegate* unmanaged[Cdecl]<nint, int, UFBXScene*, void> callback, nint user);
+
     [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXFreeScene", StringMarshalling = StringMarshalling.Utf8)]
     [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
     public static unsafe partial void FreeScene(UFBXScene* scene);
+
+    /// <summary>
+    /// Gets the key of the cache of a scene. Only options that change the extracted scene are included.
+    /// </summary>
+    /// <param name="sourceHash">Hash of the source file and the external files it uses</param>
+    /// <param name="options">Options the scene is loaded with, or null for defaults</param>
+    /// <returns>The key</returns>
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXSceneCacheKey")]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe partial ulong SceneCacheKey(ulong sourceHash, UFBXSceneLoadOptions* options);
+
+    /// <summary>
+    /// Writes a scene to a cache file that can be loaded back without parsing the source
+    /// </summary>
+    /// <param name="scene">The scene to write</param>
+    /// <param name="path">The path of the cache file</param>
+    /// <param name="key">The key from <see cref="SceneCacheKey"/></param>
+    /// <returns>Whether the cache was written</returns>
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXSaveSceneCache", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    [return: MarshalAs(UnmanagedType.I1)]
+    public static unsafe partial bool SaveSceneCache(UFBXScene* scene, string path, ulong key);
+
+    /// <summary>
+    /// Loads a scene written by <see cref="SaveSceneCache"/>. Must be freed with <see cref="FreeScene"/>.
+    /// </summary>
+    /// <param name="path">The path of the cache file</param>
+    /// <param name="key">The key from <see cref="SceneCacheKey"/></param>
+    /// <returns>The scene, or null if there's no valid cache for the key</returns>
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXLoadSceneCache", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe partial UFBXScene* LoadSceneCache(string path, ulong key);
+
+    /// <summary>
+    /// Measures mesh extraction speed on a synthetic mesh
+    /// </summary>
+    /// <param name="triangleCount">Amount of triangles of the mesh</param>
+    /// <param name="iterations">Amount of times to extract the mesh</param>
+    /// <param name="options">Options to extract with, or null for defaults</param>
+    /// <returns>The best throughput in triangles per second, or a negative value on failure</returns>
+    [LibraryImport("StapleToolingSupport", EntryPoint = "UFBXBenchmarkMeshExtraction")]
+    [UnmanagedCallConv(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe partial double BenchmarkMeshExtraction(int triangleCount, int iterations, UFBXSceneLoadOptions* options);
 }